@@ -0,0 +1,55 @@
+#include <vector>
+
+#include "proj_bench.hpp"
+
+using StatsMap =
+    s21::map<std::uint64_t, std::uint64_t,
+             std::allocator<std::pair<const std::uint64_t, std::uint64_t>>,
+             s21::stats_tree_traits>;
+
+// apply_batch against one insert_or_assign/erase per op, for batches from
+// 0.1% to 100% of the tree size. usage: proj_apply_batch_bench [keys]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 1000000);
+  std::printf("%10s %10s %16s %16s %12s %12s\n", "keys", "ops",
+              "cmp independent", "cmp batch", "ms indep", "ms batch");
+  for (std::size_t ops_count = n / 1000; ops_count <= n; ops_count *= 10) {
+    StatsMap independent, batched;
+    for (std::size_t i = 0; i < n; ++i) {
+      independent.insert(i * 4, i);
+      batched.insert(i * 4, i);
+    }
+
+    std::vector<StatsMap::batch_op> ops;
+    std::size_t step = 4 * n / ops_count;
+    for (std::size_t i = 0; i < ops_count; ++i) {
+      std::uint64_t key = i * step + (i % 3 == 0 ? 0 : 1);
+      ops.push_back({i % 5 == 0 ? s21::batch_kind::erase
+                                : s21::batch_kind::upsert,
+                     key, i});
+    }
+
+    independent.reset_stats();
+    double indep_ns = bench::measure_ns([&] {
+      for (const auto &op : ops) {
+        if (op.kind == s21::batch_kind::erase) {
+          auto it = independent.find(op.key);
+          if (it != independent.end()) independent.erase(it);
+        } else {
+          independent.insert_or_assign(op.key, op.value);
+        }
+      }
+    });
+    batched.reset_stats();
+    std::vector<s21::batch_outcome> outcomes;
+    outcomes.reserve(ops.size());
+    double batch_ns = bench::measure_ns([&] {
+      batched.apply_batch(ops.begin(), ops.end(),
+                          std::back_inserter(outcomes));
+    });
+    std::printf("%10zu %10zu %16zu %16zu %12.1f %12.1f\n", n, ops_count,
+                independent.stats().comparisons, batched.stats().comparisons,
+                indep_ns / 1e6, batch_ns / 1e6);
+  }
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include "proj_bench.hpp"
+
+namespace {
+// One "request": temporary containers filled with n elements, then dropped
+template <typename Vector, typename List, typename Set, typename... Alloc>
+std::size_t run_request(std::size_t n, std::uint64_t &state,
+                        const Alloc &...alloc) {
+  Vector v(alloc...);
+  List l(alloc...);
+  Set s(alloc...);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::uint64_t x = bench::next_random(state);
+    v.push_back(x);
+    l.push_back(x);
+    s.insert(x % (4 * n));
+  }
+  return v.size() + l.size() + s.size();
+}
+}  // namespace
+
+// usage: proj_arena_bench [elements per request] [requests]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 2000);
+  const std::size_t requests = bench::arg_or(argc, argv, 2, 2000);
+
+  using heap_vector = s21::vector<std::uint64_t>;
+  using heap_list = s21::list<std::uint64_t>;
+  using heap_set = s21::set<std::uint64_t>;
+  using arena_vector =
+      s21::vector<std::uint64_t, s21::arena_allocator<std::uint64_t>>;
+  using arena_list =
+      s21::list<std::uint64_t, s21::arena_allocator<std::uint64_t>>;
+  using arena_set = s21::set<std::uint64_t, std::less<std::uint64_t>,
+                             s21::arena_allocator<std::uint64_t>>;
+
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+  std::size_t total = 0;
+  double heap_ns = bench::measure_ns([&] {
+    for (std::size_t r = 0; r < requests; ++r)
+      total += run_request<heap_vector, heap_list, heap_set>(n, state);
+  });
+  bench::keep(total);
+
+  s21::arena arena;
+  state = 0x9E3779B97F4A7C15ULL;
+  double arena_ns = bench::measure_ns([&] {
+    for (std::size_t r = 0; r < requests; ++r) {
+      total += run_request<arena_vector, arena_list, arena_set>(
+          n, state, s21::arena_allocator<std::uint64_t>(arena));
+      arena.reset();
+    }
+  });
+  bench::keep(total);
+
+  std::printf("%zu requests x %zu elements (vector + list + set)\n", requests,
+              n);
+  std::printf("std::allocator  %10.1f ns/request\n", heap_ns / requests);
+  std::printf("s21::arena      %10.1f ns/request  (%zu KiB reserved)\n",
+              arena_ns / requests, arena.capacity() / 1024);
+  return 0;
+}
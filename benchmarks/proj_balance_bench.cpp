@@ -0,0 +1,102 @@
+#include <vector>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+template <typename Traits>
+struct counted : Traits {
+  static constexpr bool collect_stats = true;
+};
+
+template <typename Traits>
+using tree_map = s21::map<std::uint64_t, std::uint64_t,
+                          std::allocator<std::pair<const std::uint64_t,
+                                                   std::uint64_t>>,
+                          Traits>;
+
+enum class workload { random_insert, sorted_insert, churn };
+
+const char *name_of(workload w) {
+  switch (w) {
+    case workload::random_insert:
+      return "random insert";
+    case workload::sorted_insert:
+      return "sorted insert";
+    default:
+      return "insert/erase churn";
+  }
+}
+
+// Fills the map according to w and returns the number of updates made
+template <typename Map>
+std::size_t fill(Map &m, workload w, const std::vector<std::uint64_t> &keys) {
+  std::size_t updates = 0;
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    std::uint64_t key = w == workload::sorted_insert ? i : keys[i];
+    m.insert(key, i);
+    ++updates;
+    // churn erases an older key after every second insert
+    if (w == workload::churn && i % 2 == 1) {
+      auto it = m.find(keys[i / 2]);
+      if (it != m.end()) {
+        m.erase(it);
+        ++updates;
+      }
+    }
+  }
+  return updates;
+}
+
+template <typename Traits>
+void row(const char *policy, workload w, const std::vector<std::uint64_t> &keys,
+         const std::vector<std::uint64_t> &queries) {
+  // throughput without counters
+  tree_map<Traits> m;
+  std::size_t updates = 0;
+  double update_ns = bench::measure_ns([&] { updates = fill(m, w, keys); });
+  const std::vector<std::uint64_t> &probe =
+      w == workload::sorted_insert ? keys : queries;
+  std::size_t hits = 0;
+  double lookup_ns = bench::measure_ns([&] {
+    for (std::uint64_t key : probe) hits += m.contains(key % keys.size());
+  });
+  bench::keep(hits);
+
+  // the same work again with counters on
+  tree_map<counted<Traits>> c;
+  fill(c, w, keys);
+  s21::tree_stats built = c.stats();
+  c.reset_stats();
+  for (std::uint64_t key : probe) hits += c.contains(key % keys.size());
+  bench::keep(hits);
+
+  std::printf("  %-6s %8.1f %8.1f %10.2f %9.2f %7u\n", policy,
+              update_ns / updates, lookup_ns / probe.size(),
+              double(built.rotations) / updates,
+              double(c.stats().comparisons) / probe.size(), built.height);
+}
+
+}  // namespace
+
+// usage: proj_balance_bench [keys] [queries]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 500000);
+  const std::size_t q = bench::arg_or(argc, argv, 2, 500000);
+  std::printf("keys=%zu queries=%zu\n", n, q);
+
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+  std::vector<std::uint64_t> keys(n), queries(q);
+  for (auto &key : keys) key = bench::next_random(state) % n;
+  for (auto &key : queries) key = bench::next_random(state);
+
+  for (workload w : {workload::random_insert, workload::sorted_insert,
+                     workload::churn}) {
+    std::printf("%s\n  %-6s %8s %8s %10s %9s %7s\n", name_of(w), "policy",
+                "ns/upd", "ns/find", "rot/upd", "cmp/find", "height");
+    row<s21::tree_traits>("rb", w, keys, queries);
+    row<s21::avl_tree_traits>("avl", w, keys, queries);
+    row<s21::wavl_tree_traits>("wavl", w, keys, queries);
+  }
+  return 0;
+}
@@ -0,0 +1,54 @@
+#include <vector>
+
+#include "proj_bench.hpp"
+
+// Single lookups against find_many/contains_many for a grid of tree and
+// batch sizes. usage: proj_batch_lookup_bench [max_keys]
+int main(int argc, char **argv) {
+  const std::size_t max_keys = bench::arg_or(argc, argv, 1, 4000000);
+  const std::size_t total_queries = 1 << 20;
+  const std::size_t batches[] = {1, 16, 64, 256};
+
+  std::printf("%10s %6s %14s %14s %14s %14s\n", "keys", "batch",
+              "set ns/key", "set_many", "frozen ns/key", "frozen_many");
+  for (std::size_t n = 10000; n <= max_keys; n *= 20) {
+    std::uint64_t state = 42;
+    s21::set<std::uint64_t> tree;
+    for (std::size_t i = 0; i < n; ++i)
+      tree.insert(bench::next_random(state) % (4 * n));
+    s21::frozen_set<std::uint64_t> frozen(tree);
+
+    std::vector<std::uint64_t> queries(total_queries);
+    for (auto &q : queries) q = bench::next_random(state) % (4 * n);
+    bool out[256];
+
+    for (std::size_t batch : batches) {
+      std::size_t hits = 0;
+      double single = bench::measure_ns([&] {
+        for (std::uint64_t q : queries) hits += tree.contains(q);
+      });
+      double many = bench::measure_ns([&] {
+        for (std::size_t i = 0; i < total_queries; i += batch) {
+          tree.contains_many(queries.begin() + i,
+                             queries.begin() + i + batch, out);
+          hits += out[0];
+        }
+      });
+      double frozen_single = bench::measure_ns([&] {
+        for (std::uint64_t q : queries) hits += frozen.contains(q);
+      });
+      double frozen_many = bench::measure_ns([&] {
+        for (std::size_t i = 0; i < total_queries; i += batch) {
+          frozen.contains_many(queries.begin() + i,
+                               queries.begin() + i + batch, out);
+          hits += out[0];
+        }
+      });
+      bench::keep(hits);
+      std::printf("%10zu %6zu %14.1f %14.1f %14.1f %14.1f\n", tree.size(),
+                  batch, single / total_queries, many / total_queries,
+                  frozen_single / total_queries, frozen_many / total_queries);
+    }
+  }
+  return 0;
+}
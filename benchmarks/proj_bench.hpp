@@ -0,0 +1,42 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../proj_containers.hpp"
+
+namespace bench {
+
+// Keeps the optimizer from dropping a computed value
+template <typename T>
+inline void keep(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Wall time of fn() in nanoseconds
+template <typename Fn>
+double measure_ns(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count();
+}
+
+inline std::size_t arg_or(int argc, char **argv, int idx, std::size_t def) {
+  return argc > idx ? std::strtoull(argv[idx], nullptr, 10) : def;
+}
+
+// xorshift64*, enough for shuffling keys and queries
+inline std::uint64_t next_random(std::uint64_t &state) {
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  return state * 2685821657736338717ULL;
+}
+
+}  // namespace bench
+
+#endif
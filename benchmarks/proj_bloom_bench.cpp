@@ -0,0 +1,71 @@
+#include <vector>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+template <typename Traits>
+using key_map = s21::map<std::uint64_t, std::uint32_t,
+                         std::allocator<std::pair<const std::uint64_t,
+                                                  std::uint32_t>>,
+                         Traits>;
+
+// Prints one line and returns ns per lookup, plain_ns is the baseline
+template <typename Traits>
+double row(const char *name, const std::vector<std::uint64_t> &keys,
+           const std::vector<std::uint64_t> &queries, double plain_ns) {
+  key_map<Traits> m;
+  double insert = bench::measure_ns([&] {
+    for (std::size_t i = 0; i < keys.size(); ++i)
+      m.insert(keys[i], static_cast<std::uint32_t>(i));
+  });
+  std::size_t hits = 0;
+  double lookup = bench::measure_ns([&] {
+    for (std::uint64_t key : queries) hits += m.contains(key);
+  });
+  bench::keep(hits);
+  lookup /= queries.size();
+  std::printf("  %-18s %8.1f %8.1f  x%-5.2f", name, insert / keys.size(),
+              lookup, plain_ns > 0 ? plain_ns / lookup : 1.0);
+  if constexpr (Traits::bloom_bits_per_key != 0) {
+    // the timed map doesn't count lookups, a second one replays them
+    key_map<s21::bloom_tree_traits<Traits::bloom_bits_per_key, true>> counted;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+      counted.insert(keys[i], static_cast<std::uint32_t>(i));
+    for (std::uint64_t key : queries) hits += counted.contains(key);
+    bench::keep(hits);
+    s21::bloom_filter_stats st = counted.bloom_stats();
+    std::printf(" %7.2f%% %8.1f KiB",
+                100.0 * st.false_positives / (st.rejected + st.passed),
+                st.bytes / 1024.0);
+  }
+  std::printf("\n");
+  return lookup;
+}
+
+}  // namespace
+
+// usage: proj_bloom_bench [keys] [queries] [miss percent]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 500000);
+  const std::size_t q = bench::arg_or(argc, argv, 2, 1000000);
+  const std::size_t miss = bench::arg_or(argc, argv, 3, 90);
+  std::printf("keys=%zu queries=%zu misses=%zu%%\n", n, q, miss);
+
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+  std::vector<std::uint64_t> keys(n), queries(q);
+  for (auto &key : keys) key = bench::next_random(state) | 1;
+  // even keys are never inserted
+  for (auto &key : queries)
+    key = bench::next_random(state) % 100 < miss
+              ? bench::next_random(state) & ~std::uint64_t(1)
+              : keys[bench::next_random(state) % n];
+
+  std::printf("  %-18s %8s %8s  %-6s %8s %12s\n", "", "ns/ins", "ns/find",
+              "", "fp", "filter");
+  double plain = row<s21::tree_traits>("s21::map", keys, queries, 0);
+  row<s21::bloom_tree_traits<8>>("bloom 8 bits/key", keys, queries, plain);
+  row<s21::bloom_tree_traits<10>>("bloom 10 bits/key", keys, queries, plain);
+  row<s21::bloom_tree_traits<16>>("bloom 16 bits/key", keys, queries, plain);
+  return 0;
+}
@@ -0,0 +1,44 @@
+#include "proj_bench.hpp"
+
+using plain_multiset = s21::multiset<std::uint32_t>;
+using counted_multiset =
+    s21::multiset<std::uint32_t, std::less<std::uint32_t>,
+                  std::allocator<std::uint32_t>, s21::counted_tree_traits>;
+
+// usage: proj_counted_multiset_bench [inserts] [distinct keys]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 2000000);
+  const std::size_t distinct = bench::arg_or(argc, argv, 2, 4096);
+
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+  plain_multiset plain;
+  double plain_ns = bench::measure_ns([&] {
+    for (std::size_t i = 0; i < n; ++i)
+      plain.insert(static_cast<std::uint32_t>(bench::next_random(state) %
+                                              distinct));
+  });
+
+  state = 0x9E3779B97F4A7C15ULL;
+  counted_multiset counted;
+  double counted_ns = bench::measure_ns([&] {
+    for (std::size_t i = 0; i < n; ++i)
+      counted.insert(static_cast<std::uint32_t>(bench::next_random(state) %
+                                                distinct));
+  });
+
+  std::size_t total = 0;
+  double count_ns = bench::measure_ns([&] {
+    for (std::uint32_t key = 0; key < distinct; ++key)
+      total += counted.count(key);
+  });
+  bench::keep(total);
+
+  std::printf("inserts=%zu distinct=%zu size=%zu/%zu\n", n, distinct,
+              plain.size(), counted.size());
+  std::printf("%-22s %8.1f ns/insert\n", "multiset", plain_ns / n);
+  std::printf("%-22s %8.1f ns/insert (x%.1f)\n", "counted multiset",
+              counted_ns / n, plain_ns / counted_ns);
+  std::printf("%-22s %8.1f ns/count\n", "counted count()",
+              count_ns / distinct);
+  return 0;
+}
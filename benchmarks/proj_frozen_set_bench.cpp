@@ -0,0 +1,51 @@
+#include <vector>
+
+#include "proj_bench.hpp"
+
+// usage: proj_frozen_set_bench [keys] [queries]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 10000000);
+  const std::size_t q = bench::arg_or(argc, argv, 2, 2000000);
+
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+  s21::set<std::uint64_t> tree;
+  for (std::size_t i = 0; i < n; ++i)
+    tree.insert(bench::next_random(state) >> 1);
+
+  s21::frozen_set<std::uint64_t> eytzinger(tree);
+  s21::frozen_kary_set<std::uint64_t> kary(tree);
+
+  // half of the queries hit, half miss
+  std::vector<std::uint64_t> queries(q);
+  std::uint64_t probe = 0x2545F4914F6CDD1DULL;
+  for (std::size_t i = 0; i < q; ++i) {
+    if (i & 1) {
+      queries[i] = bench::next_random(probe) >> 1;
+    } else {
+      auto it = eytzinger.lower_bound(bench::next_random(probe) >> 1);
+      queries[i] = it == eytzinger.end() ? 0 : *it;
+    }
+  }
+
+  std::size_t hits = 0;
+  double tree_ns = bench::measure_ns([&] {
+    for (std::uint64_t key : queries) hits += tree.contains(key);
+  });
+  bench::keep(hits);
+  double eyt_ns = bench::measure_ns([&] {
+    for (std::uint64_t key : queries) hits += eytzinger.contains(key);
+  });
+  bench::keep(hits);
+  double kary_ns = bench::measure_ns([&] {
+    for (std::uint64_t key : queries) hits += kary.contains(key);
+  });
+  bench::keep(hits);
+
+  std::printf("keys=%zu queries=%zu\n", tree.size(), q);
+  std::printf("%-22s %8.1f ns/lookup\n", "s21::set", tree_ns / q);
+  std::printf("%-22s %8.1f ns/lookup (x%.1f)\n", "frozen_set eytzinger",
+              eyt_ns / q, tree_ns / eyt_ns);
+  std::printf("%-22s %8.1f ns/lookup (x%.1f)\n", "frozen_kary_set",
+              kary_ns / q, tree_ns / kary_ns);
+  return 0;
+}
@@ -0,0 +1,55 @@
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+// Anonymous memory the kernel currently backs with huge pages, in MiB
+double huge_mib() {
+  std::ifstream smaps("/proc/self/smaps_rollup");
+  std::string key;
+  double kib = 0;
+  while (smaps >> key) {
+    if (key == "AnonHugePages:") {
+      smaps >> kib;
+      break;
+    }
+  }
+  return kib / 1024;
+}
+
+// ns per random read from a table of n entries, each read depending on the
+// last so that every TLB miss is paid in full
+template <typename Vector>
+void row(const char *name, std::size_t n, std::size_t reads) {
+  Vector table;
+  std::uint64_t state = 0x2545F4914F6CDD1DULL;
+  for (std::size_t i = 0; i < n; ++i)
+    table.push_back(bench::next_random(state));
+  double huge = huge_mib();
+  std::uint64_t at = 0;
+  double ns = bench::measure_ns([&] {
+    for (std::size_t i = 0; i < reads; ++i) at = table[(at + i) % n] % n;
+  });
+  bench::keep(at);
+  std::printf("  %-34s %8.1f %10.0f\n", name, ns / reads, huge);
+}
+
+}  // namespace
+
+// usage: proj_huge_page_bench [table MiB] [reads]
+int main(int argc, char **argv) {
+  using u64 = std::uint64_t;
+  const std::size_t mib = bench::arg_or(argc, argv, 1, 512);
+  const std::size_t reads = bench::arg_or(argc, argv, 2, 5000000);
+  const std::size_t n = mib * 1048576 / sizeof(u64);
+  std::printf("table=%zu MiB reads=%zu\n", mib, reads);
+
+  std::printf("  %-34s %8s %10s\n", "", "ns/read", "huge MiB");
+  row<s21::vector<u64>>("s21::vector", n, reads);
+  row<s21::vector<u64, s21::huge_page_allocator<u64>>>(
+      "s21::vector + huge_page_allocator", n, reads);
+  return 0;
+}
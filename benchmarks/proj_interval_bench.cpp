@@ -0,0 +1,48 @@
+#include <vector>
+
+#include "proj_bench.hpp"
+
+// usage: proj_interval_bench [intervals] [queries]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 1000000);
+  const std::size_t q = bench::arg_or(argc, argv, 2, 1000);
+  const std::uint64_t span = 1ULL << 32;
+
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+  s21::interval_map<std::uint64_t, std::uint32_t> intervals;
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> flat;
+  flat.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::uint64_t lo = bench::next_random(state) % span;
+    std::uint64_t hi = lo + bench::next_random(state) % (span / n * 16);
+    intervals.insert(lo, hi, static_cast<std::uint32_t>(i));
+    flat.emplace_back(lo, hi);
+  }
+
+  std::vector<std::uint64_t> points(q);
+  for (auto &p : points) p = bench::next_random(state) % span;
+
+  std::size_t hits = 0;
+  double tree_ns = bench::measure_ns([&] {
+    for (std::uint64_t p : points)
+      intervals.stab(p, [&](std::uint64_t, std::uint64_t, std::uint32_t &) {
+        ++hits;
+      });
+  });
+  bench::keep(hits);
+  std::size_t tree_hits = hits;
+
+  // without the subtree maxima every interval has to be looked at
+  hits = 0;
+  double scan_ns = bench::measure_ns([&] {
+    for (std::uint64_t p : points)
+      for (const auto &[lo, hi] : flat) hits += lo <= p && p <= hi;
+  });
+  bench::keep(hits);
+
+  std::printf("intervals=%zu queries=%zu hits=%zu\n", n, q, tree_hits);
+  std::printf("%-22s %10.1f ns/query\n", "linear scan", scan_ns / q);
+  std::printf("%-22s %10.1f ns/query (x%.1f)\n", "interval_map::stab",
+              tree_ns / q, scan_ns / tree_ns);
+  return 0;
+}
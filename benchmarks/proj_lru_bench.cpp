@@ -0,0 +1,81 @@
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+// The usual list + hash map LRU, one list node allocated per miss
+class list_lru {
+ public:
+  explicit list_lru(std::size_t capacity) : capacity_(capacity) {}
+
+  std::uint64_t *get(std::uint64_t key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) return nullptr;
+    order_.splice(order_.end(), order_, it->second);
+    return &it->second->second;
+  }
+
+  void put(std::uint64_t key, std::uint64_t value) {
+    if (order_.size() == capacity_) {
+      index_.erase(order_.front().first);
+      order_.pop_front();
+    }
+    order_.emplace_back(key, value);
+    index_[key] = std::prev(order_.end());
+  }
+
+ private:
+  using entries = std::list<std::pair<std::uint64_t, std::uint64_t>>;
+  std::size_t capacity_;
+  entries order_;
+  std::unordered_map<std::uint64_t, entries::iterator> index_;
+};
+
+template <typename Cache>
+void row(const char *name, std::size_t capacity,
+         const std::vector<std::uint64_t> &keys) {
+  Cache cache(capacity);
+  std::size_t hits = 0;
+  double ns = bench::measure_ns([&] {
+    for (std::uint64_t key : keys) {
+      if (std::uint64_t *value = cache.get(key)) {
+        hits += *value != 0;
+      } else {
+        cache.put(key, key | 1);
+      }
+    }
+  });
+  bench::keep(hits);
+  std::printf("  %-24s %8.1f %8.1f%%\n", name, ns / keys.size(),
+              100.0 * hits / keys.size());
+}
+
+}  // namespace
+
+// usage: proj_lru_bench [capacity] [distinct keys] [requests]
+int main(int argc, char **argv) {
+  const std::size_t capacity = bench::arg_or(argc, argv, 1, 100000);
+  const std::size_t distinct = bench::arg_or(argc, argv, 2, 1000000);
+  const std::size_t n = bench::arg_or(argc, argv, 3, 5000000);
+  std::printf("capacity=%zu distinct=%zu requests=%zu\n", capacity, distinct,
+              n);
+
+  // skewed towards small ranks: squaring a uniform fraction
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+  std::vector<std::uint64_t> keys(n);
+  for (auto &key : keys) {
+    double u = static_cast<double>(bench::next_random(state) >> 11) / 0x1p53;
+    key = static_cast<std::uint64_t>(u * u * distinct) * 0x9E3779B97F4A7C15ULL;
+  }
+
+  std::printf("  %-24s %8s %9s\n", "", "ns/req", "hits");
+  row<list_lru>("std::list+unordered_map", capacity, keys);
+  row<s21::lru_cache<std::uint64_t, std::uint64_t>>("s21::lru_cache", capacity,
+                                                     keys);
+  row<s21::lfu_cache<std::uint64_t, std::uint64_t>>("s21::lfu_cache", capacity,
+                                                     keys);
+  return 0;
+}
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+// Best time of rounds in ms, with work reset to input before every round
+template <typename Fn>
+double best_ms(const s21::vector<int> &input, s21::vector<int> &work,
+               int rounds, Fn fn) {
+  double best = 0;
+  for (int r = 0; r < rounds; ++r) {
+    std::copy(input.begin(), input.end(), work.begin());
+    double ns = bench::measure_ns(fn);
+    if (r == 0 || ns < best) best = ns;
+  }
+  return best / 1e6;
+}
+
+// One line of times: the std:: algorithms when pool is null, the parallel
+// ones on pool otherwise
+void row(const char *label, s21::parallel::thread_pool *pool,
+         const s21::vector<int> &input, int rounds) {
+  s21::vector<int> work(input.size()), out(input.size());
+  s21::vector<long long> wide(input.size());
+  s21::parallel::policy p{pool, 0};
+  auto b = work.begin(), e = work.end();
+  auto odd = [](int x) { return x % 2 != 0; };
+  auto mix = [](int x) { return static_cast<int>(x * 2654435761u >> 7); };
+  double t[6];
+  if (!pool) {
+    t[0] = best_ms(input, work, rounds, [&] { std::sort(b, e); });
+    t[1] = best_ms(input, work, rounds, [&] { std::stable_sort(b, e); });
+    t[2] = best_ms(input, work, rounds,
+                   [&] { std::transform(b, e, out.begin(), mix); });
+    t[3] = best_ms(input, work, rounds,
+                   [&] { bench::keep(std::accumulate(b, e, 0LL)); });
+    t[4] = best_ms(input, work, rounds,
+                   [&] { std::partial_sum(b, e, wide.begin()); });
+    t[5] = best_ms(input, work, rounds,
+                   [&] { bench::keep(std::copy_if(b, e, out.begin(), odd)); });
+  } else {
+    namespace par = s21::parallel;
+    t[0] = best_ms(input, work, rounds, [&] { par::sort(p, b, e); });
+    t[1] = best_ms(input, work, rounds, [&] { par::stable_sort(p, b, e); });
+    t[2] = best_ms(input, work, rounds,
+                   [&] { par::transform(p, b, e, out.begin(), mix); });
+    t[3] = best_ms(input, work, rounds,
+                   [&] { bench::keep(par::reduce(p, b, e, 0LL)); });
+    t[4] = best_ms(input, work, rounds,
+                   [&] { par::inclusive_scan(p, b, e, wide.begin()); });
+    t[5] = best_ms(input, work, rounds, [&] {
+      bench::keep(par::copy_if(p, b, e, out.begin(), odd));
+    });
+  }
+  std::printf("  %-8s %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n", label, t[0],
+              t[1], t[2], t[3], t[4], t[5]);
+}
+
+}  // namespace
+
+// usage: proj_parallel_bench [elements] [max_threads] [rounds]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 4000000);
+  std::size_t cores = std::thread::hardware_concurrency();
+  const std::size_t max_threads =
+      bench::arg_or(argc, argv, 2, cores ? cores : 1);
+  const int rounds = static_cast<int>(bench::arg_or(argc, argv, 3, 3));
+
+  s21::vector<int> input(n);
+  std::uint64_t state = 11;
+  for (auto &x : input) x = static_cast<int>(bench::next_random(state) >> 33);
+
+  std::printf("elements=%zu rounds=%d cores=%zu\n", n, rounds, cores);
+  std::printf("  %-8s %9s %9s %9s %9s %9s %9s\n", "ms", "sort", "stable",
+              "transform", "reduce", "scan", "copy_if");
+  row("std", nullptr, input, rounds);
+  for (std::size_t threads = 1; threads <= max_threads;
+       threads = threads < max_threads && threads * 2 > max_threads
+                     ? max_threads
+                     : threads * 2) {
+    s21::parallel::thread_pool pool(threads - 1);
+    char label[32];
+    std::snprintf(label, sizeof(label), "%zu thr", threads);
+    row(label, &pool, input, rounds);
+  }
+  return 0;
+}
@@ -0,0 +1,69 @@
+#include <string>
+#include <vector>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+using plain_map = s21::map<std::string, std::uint32_t>;
+using prefix_map =
+    s21::map<std::string, std::uint32_t,
+             std::allocator<std::pair<const std::string, std::uint32_t>>,
+             s21::prefix_tree_traits>;
+
+const char *const hosts[] = {"cdn",   "api",  "img",   "static", "auth",
+                             "shop",  "docs", "media", "mail",   "search",
+                             "video", "news", "maps",  "blog",   "status"};
+
+// host.domain/section/.../id, the first bytes vary between keys
+std::string make_url(std::uint64_t &state, bool scheme) {
+  std::string url = scheme ? "https://" : "";
+  url += hosts[bench::next_random(state) % 15];
+  url += std::to_string(bench::next_random(state) % 100);
+  url += ".example.com/assets/v2/static/resources/";
+  url += std::to_string(bench::next_random(state));
+  return url;
+}
+
+template <typename Map>
+double lookup_ns(const std::vector<std::string> &keys,
+                 const std::vector<std::string> &queries) {
+  Map m;
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    m.insert(keys[i], static_cast<std::uint32_t>(i));
+  std::size_t hits = 0;
+  double ns = bench::measure_ns([&] {
+    for (const std::string &key : queries) hits += m.contains(key);
+  });
+  bench::keep(hits);
+  return ns / queries.size();
+}
+
+void run(std::size_t n, std::size_t q, bool scheme) {
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+  std::vector<std::string> keys(n), queries(q);
+  for (auto &key : keys) key = make_url(state, scheme);
+  for (std::size_t i = 0; i < q; ++i)
+    queries[i] = i & 1 ? make_url(state, scheme)
+                       : keys[bench::next_random(state) % n];
+
+  double plain = lookup_ns<plain_map>(keys, queries);
+  double prefix = lookup_ns<prefix_map>(keys, queries);
+  std::printf("%s\n", scheme ? "https:// urls (shared 8-byte prefix)"
+                             : "host/path urls");
+  std::printf("  %-20s %8.1f ns/lookup\n", "s21::map", plain);
+  std::printf("  %-20s %8.1f ns/lookup (x%.2f)\n", "prefix_tree_traits",
+              prefix, plain / prefix);
+}
+
+}  // namespace
+
+// usage: proj_prefix_bench [keys] [queries]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 500000);
+  const std::size_t q = bench::arg_or(argc, argv, 2, 500000);
+  std::printf("keys=%zu queries=%zu\n", n, q);
+  run(n, q, false);
+  run(n, q, true);
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include <string>
+#include <vector>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+const char *const hosts[] = {"cdn",   "api",  "img",   "static", "auth",
+                             "shop",  "docs", "media", "mail",   "search",
+                             "video", "news", "maps",  "blog",   "status"};
+
+std::string make_url(std::uint64_t &state) {
+  std::string url = "https://";
+  url += hosts[bench::next_random(state) % 15];
+  url += std::to_string(bench::next_random(state) % 100);
+  url += ".example.com/assets/";
+  url += std::to_string(bench::next_random(state));
+  return url;
+}
+
+template <typename Container, typename Key>
+void report(const char *name, const std::vector<Key> &keys,
+            const std::vector<Key> &queries) {
+  Container c;
+  double insert = bench::measure_ns([&] {
+    for (const Key &key : keys) c.insert(key);
+  });
+  std::size_t hits = 0;
+  double lookup = bench::measure_ns([&] {
+    for (const Key &key : queries) hits += c.contains(key);
+  });
+  std::size_t visited = 0;
+  double scan = bench::measure_ns([&] {
+    c.for_each([&](const auto &...) { ++visited; });
+  });
+  bench::keep(hits + visited);
+  std::printf("  %-26s insert %7.1f  lookup %7.1f  scan %5.2f ns/key\n", name,
+              insert / keys.size(), lookup / queries.size(),
+              scan / keys.size());
+}
+
+// half of the queries hit, half are fresh keys
+template <typename Key, typename Fresh>
+std::vector<Key> queries_for(const std::vector<Key> &keys, std::size_t q,
+                             std::uint64_t &state, Fresh fresh) {
+  std::vector<Key> queries(q);
+  for (std::size_t i = 0; i < q; ++i)
+    queries[i] =
+        i & 1 ? fresh(state) : keys[bench::next_random(state) % keys.size()];
+  return queries;
+}
+
+std::uint64_t make_int(std::uint64_t &state) {
+  return bench::next_random(state);
+}
+
+}  // namespace
+
+// usage: proj_radix_bench [keys] [queries]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 500000);
+  const std::size_t q = bench::arg_or(argc, argv, 2, 500000);
+  std::printf("keys=%zu queries=%zu\n", n, q);
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+  std::vector<std::string> urls(n);
+  for (auto &url : urls) url = make_url(state);
+  auto url_queries = queries_for(urls, q, state, make_url);
+  std::printf("url keys\n");
+  report<s21::set<std::string>>("s21::set<string>", urls, url_queries);
+  report<s21::radix_set<std::string>>("s21::radix_set<string>", urls,
+                                      url_queries);
+
+  std::vector<std::uint64_t> ints(n);
+  for (auto &key : ints) key = bench::next_random(state);
+  auto int_queries = queries_for(ints, q, state, make_int);
+  std::printf("uint64 keys\n");
+  report<s21::set<std::uint64_t>>("s21::set<uint64_t>", ints, int_queries);
+  report<s21::radix_set<std::uint64_t>>("s21::radix_set<uint64_t>", ints,
+                                        int_queries);
+  return 0;
+}
@@ -0,0 +1,52 @@
+#include "proj_bench.hpp"
+
+// usage: proj_range_scan_bench [keys] [passes]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 2000000);
+  const std::size_t passes = bench::arg_or(argc, argv, 2, 5);
+
+  std::uint64_t state = 0x9E3779B97F4A7C15ULL;
+  s21::map<std::uint64_t, std::uint64_t> m;
+  for (std::size_t i = 0; i < n; ++i) m.insert(bench::next_random(state), i);
+
+  // the middle half of the key space, about n / 2 entries
+  const std::uint64_t lo = 1ULL << 62, hi = 3ULL << 62;
+  std::size_t scanned = 0;
+  std::uint64_t sum = 0;
+
+  double iter_ns = bench::measure_ns([&] {
+    for (std::size_t p = 0; p < passes; ++p)
+      for (auto it = m.begin(); it != m.end(); ++it) {
+        if (it->first < lo) continue;
+        if (!(it->first < hi)) break;
+        sum += it->second;
+        ++scanned;
+      }
+  });
+  bench::keep(sum);
+  std::size_t in_range = scanned / passes;
+
+  double callback_ns = bench::measure_ns([&] {
+    for (std::size_t p = 0; p < passes; ++p)
+      m.for_each_in_range(lo, hi, [&](const std::uint64_t &,
+                                      std::uint64_t &value) { sum += value; });
+  });
+  bench::keep(sum);
+
+  double full_ns = bench::measure_ns([&] {
+    for (std::size_t p = 0; p < passes; ++p)
+      m.for_each([&](const std::uint64_t &, std::uint64_t &value) {
+        sum += value;
+      });
+  });
+  bench::keep(sum);
+
+  std::printf("keys=%zu in range=%zu passes=%zu\n", m.size(), in_range,
+              passes);
+  std::printf("%-26s %8.2f ns/element\n", "iterators", iter_ns / passes / n);
+  std::printf("%-26s %8.2f ns/element (x%.1f)\n", "for_each_in_range",
+              callback_ns / passes / in_range,
+              (iter_ns / n) / (callback_ns / in_range));
+  std::printf("%-26s %8.2f ns/element\n", "for_each", full_ns / passes / n);
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <vector>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+// Best time of rounds, in ns per element
+template <typename Fn>
+double per_element(std::size_t n, int rounds, Fn fn) {
+  double best = 0;
+  for (int r = 0; r < rounds; ++r) {
+    double ns = bench::measure_ns(fn);
+    if (r == 0 || ns < best) best = ns;
+  }
+  return best / n;
+}
+
+template <typename T>
+void rows(const char *type, std::size_t n, int rounds) {
+  s21::vector<T> v;
+  std::uint64_t state = 7;
+  for (std::size_t i = 0; i < n; ++i)
+    v.push_back(static_cast<T>(bench::next_random(state) % 1000));
+  s21::vector<T> w(v);
+  std::vector<T> s(v.begin(), v.end());
+  const T missing = static_cast<T>(5000);
+
+  auto row = [&](const char *op, auto own, auto plain) {
+    std::printf("  %-8s %-8s %10.3f %10.3f\n", type, op,
+                per_element(n, rounds, own), per_element(n, rounds, plain));
+  };
+  row(
+      "find", [&] { bench::keep(v.find(missing)); },
+      [&] { bench::keep(std::find(s.begin(), s.end(), missing)); });
+  row(
+      "count", [&] { bench::keep(v.count(T(7))); },
+      [&] { bench::keep(std::count(s.begin(), s.end(), T(7))); });
+  row(
+      "equal", [&] { bench::keep(v == w); },
+      [&] { bench::keep(std::equal(s.begin(), s.end(), w.begin())); });
+  row(
+      "max", [&] { bench::keep(v.max()); },
+      [&] { bench::keep(*std::max_element(s.begin(), s.end())); });
+  row(
+      "sum", [&] { bench::keep(v.sum()); },
+      [&] {
+        s21::simd::sum_type<T> total = 0;
+        for (T x : s) total += x;
+        bench::keep(total);
+      });
+}
+
+}  // namespace
+
+// usage: proj_simd_bench [elements] [rounds]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 1000000);
+  const int rounds = static_cast<int>(bench::arg_or(argc, argv, 2, 20));
+  std::printf("elements=%zu rounds=%d\n", n, rounds);
+  std::printf("  %-8s %-8s %10s %10s\n", "ns/elem", "", "s21", "std");
+  rows<int>("int", n, rounds);
+  rows<std::int16_t>("int16", n, rounds);
+  rows<float>("float", n, rounds);
+  rows<double>("double", n, rounds);
+  return 0;
+}
@@ -0,0 +1,117 @@
+#include <cstdint>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+// Twelve fields, 64 bytes: a scan over two of them uses an eighth of every
+// cache line it pulls in
+struct event {
+  std::int64_t id;
+  std::int64_t timestamp;
+  double price;
+  double quantity;
+  std::int32_t kind;
+  std::int32_t user;
+  std::int32_t region;
+  std::int32_t session;
+  float score;
+  float weight;
+  std::int16_t flags;
+  std::int16_t channel;
+};
+
+using event_table =
+    s21::soa_vector<std::int64_t, std::int64_t, double, double, std::int32_t,
+                    std::int32_t, std::int32_t, std::int32_t, float, float,
+                    std::int16_t, std::int16_t>;
+
+// Best time of rounds, in ns per row
+template <typename Fn>
+double per_row(std::size_t n, int rounds, Fn fn) {
+  double best = 0;
+  for (int r = 0; r < rounds; ++r) {
+    double ns = bench::measure_ns(fn);
+    if (r == 0 || ns < best) best = ns;
+  }
+  return best / n;
+}
+
+}  // namespace
+
+// usage: proj_soa_bench [rows] [rounds]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 1000000);
+  const int rounds = static_cast<int>(bench::arg_or(argc, argv, 2, 10));
+
+  s21::vector<event> aos;
+  event_table soa;
+  aos.reserve(n);
+  soa.reserve(n);
+  std::uint64_t state = 3;
+  for (std::size_t i = 0; i < n; ++i) {
+    std::uint64_t r = bench::next_random(state);
+    event e{std::int64_t(i), std::int64_t(r >> 20), double(r % 1000) / 8,
+            double(r % 7), std::int32_t(r % 16), std::int32_t(r >> 40),
+            std::int32_t(r % 50), std::int32_t(r % 999), float(r % 100),
+            1.0f, std::int16_t(r % 3), std::int16_t(r % 5)};
+    aos.push_back(e);
+    soa.emplace_back(e.id, e.timestamp, e.price, e.quantity, e.kind, e.user,
+                     e.region, e.session, e.score, e.weight, e.flags,
+                     e.channel);
+  }
+
+  std::printf("rows=%zu rounds=%d row_bytes=%zu\n", n, rounds, sizeof(event));
+  std::printf("  %-26s %10s %10s\n", "ns/row", "aos", "soa");
+
+  // total price of one kind of event: two of the twelve fields
+  double aos_ns = per_row(n, rounds, [&] {
+    double total = 0;
+    for (std::size_t i = 0; i < n; ++i)
+      if (aos[i].kind == 5) total += aos[i].price;
+    bench::keep(total);
+  });
+  double soa_ns = per_row(n, rounds, [&] {
+    const std::int32_t *kind = soa.data<4>();
+    const double *price = soa.data<2>();
+    double total = 0;
+    for (std::size_t i = 0; i < n; ++i)
+      if (kind[i] == 5) total += price[i];
+    bench::keep(total);
+  });
+  std::printf("  %-26s %10.3f %10.3f\n", "price where kind == 5", aos_ns,
+              soa_ns);
+
+  // one field through the SIMD kernels, which only the columns can feed
+  aos_ns = per_row(n, rounds, [&] {
+    std::int64_t total = 0;
+    for (std::size_t i = 0; i < n; ++i) total += aos[i].region;
+    bench::keep(total);
+  });
+  soa_ns = per_row(n, rounds,
+                   [&] { bench::keep(s21::simd::sum(soa.column<6>())); });
+  std::printf("  %-26s %10.3f %10.3f\n", "sum of region", aos_ns, soa_ns);
+
+  // every field of a row, where the record layout is at home
+  aos_ns = per_row(n, rounds, [&] {
+    double total = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      const event &e = aos[i];
+      total += e.id + e.timestamp + e.price + e.quantity + e.kind + e.user +
+               e.region + e.session + e.score + e.weight + e.flags + e.channel;
+    }
+    bench::keep(total);
+  });
+  soa_ns = per_row(n, rounds, [&] {
+    double total = 0;
+    for (auto row : soa) {
+      auto [id, ts, price, qty, kind, user, region, session, score, weight,
+            flags, channel] = row;
+      total += id + ts + price + qty + kind + user + region + session +
+               score + weight + flags + channel;
+    }
+    bench::keep(total);
+  });
+  std::printf("  %-26s %10.3f %10.3f\n", "all twelve fields", aos_ns, soa_ns);
+  return 0;
+}
@@ -0,0 +1,50 @@
+#include <cstring>
+#include <vector>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+// ns per packet copied into the back of a receive buffer that is cleared
+// when full, best of rounds
+template <typename Grow>
+double packet_ns(std::size_t packets, std::size_t packet, int rounds,
+                 Grow grow) {
+  std::vector<char> wire(packet, 'p');
+  s21::vector<char> buffer;
+  buffer.reserve(1 << 20);
+  double best = 0;
+  for (int r = 0; r < rounds; ++r) {
+    double ns = bench::measure_ns([&] {
+      for (std::size_t i = 0; i < packets; ++i) {
+        if (buffer.size() + packet > buffer.capacity()) buffer.resize(0);
+        std::memcpy(grow(buffer, packet), wire.data(), packet);
+      }
+      bench::keep(buffer.data());
+    });
+    if (r == 0 || ns < best) best = ns;
+  }
+  return best / packets;
+}
+
+}  // namespace
+
+// usage: proj_vector_append_bench [packets] [packet bytes] [rounds]
+int main(int argc, char **argv) {
+  const std::size_t packets = bench::arg_or(argc, argv, 1, 1000000);
+  const std::size_t packet = bench::arg_or(argc, argv, 2, 1500);
+  const int rounds = static_cast<int>(bench::arg_or(argc, argv, 3, 10));
+  std::printf("packets=%zu bytes=%zu rounds=%d\n", packets, packet, rounds);
+
+  std::printf("  %-24s %8.1f\n", "resize + memcpy",
+              packet_ns(packets, packet, rounds, [](auto &b, std::size_t n) {
+                std::size_t at = b.size();
+                b.resize(at + n);
+                return b.data() + at;
+              }));
+  std::printf("  %-24s %8.1f\n", "append_uninitialized",
+              packet_ns(packets, packet, rounds, [](auto &b, std::size_t n) {
+                return b.append_uninitialized(n);
+              }));
+  return 0;
+}
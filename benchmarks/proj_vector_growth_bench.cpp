@@ -0,0 +1,52 @@
+#include <string>
+#include <vector>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+// ns per push_back into a vector that grows from empty, best of rounds.
+// The elements are made beforehand and moved in, so the time is the growth.
+template <typename Vector, typename Make>
+double fill_ns(std::size_t n, int rounds, Make make) {
+  double best = 0;
+  for (int r = 0; r < rounds; ++r) {
+    std::vector<typename Vector::value_type> pool;
+    pool.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) pool.push_back(make(i));
+    Vector v;
+    double ns = bench::measure_ns([&] {
+      for (std::size_t i = 0; i < n; ++i) v.push_back(std::move(pool[i]));
+      bench::keep(v.data());
+    });
+    if (r == 0 || ns < best) best = ns;
+  }
+  return best / n;
+}
+
+template <typename T, typename Make>
+void row(const char *name, std::size_t n, int rounds, Make make) {
+  double own = fill_ns<s21::vector<T>>(n, rounds, make);
+  double std_ns = fill_ns<std::vector<T>>(n, rounds, make);
+  std::printf("  %-22s %10.2f %10.2f  x%.2f\n", name, own, std_ns,
+              std_ns / own);
+}
+
+}  // namespace
+
+// usage: proj_vector_growth_bench [elements] [rounds]
+int main(int argc, char **argv) {
+  const std::size_t n = bench::arg_or(argc, argv, 1, 100000);
+  const int rounds = static_cast<int>(bench::arg_or(argc, argv, 2, 30));
+  std::printf("elements=%zu rounds=%d\n", n, rounds);
+
+  std::printf("  %-22s %10s %10s\n", "ns/push_back", "s21", "std");
+  row<int>("int", n, rounds, [](std::size_t i) { return static_cast<int>(i); });
+  // long enough to live on the heap, past the small string buffer
+  row<std::string>("std::string", n, rounds,
+                   [](std::size_t i) { return std::string(24, 'a' + i % 26); });
+  row<s21::vector<int>>("s21::vector<int>", n, rounds, [](std::size_t i) {
+    return s21::vector<int>({static_cast<int>(i), 1, 2});
+  });
+  return 0;
+}
@@ -0,0 +1,58 @@
+#include <string>
+#include <vector>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+// ns per spliced element for blocks inserted into the middle of a vector,
+// best of rounds
+template <typename Vector, typename Insert>
+double splice_ns(std::size_t base, std::size_t block, int splices, int rounds,
+                 Insert insert) {
+  std::uint64_t seed = 42;
+  std::vector<int> src(block);
+  for (std::size_t i = 0; i < block; ++i)
+    src[i] = static_cast<int>(bench::next_random(seed) % 1000);
+  double best = 0;
+  for (int r = 0; r < rounds; ++r) {
+    Vector v;
+    for (std::size_t i = 0; i < base; ++i) v.push_back(static_cast<int>(i));
+    double ns = bench::measure_ns([&] {
+      for (int s = 0; s < splices; ++s) insert(v, v.size() / 2, src);
+      bench::keep(v.data());
+    });
+    if (r == 0 || ns < best) best = ns;
+  }
+  return best / (static_cast<double>(block) * splices);
+}
+
+}  // namespace
+
+// usage: proj_vector_insert_bench [base] [block] [splices] [rounds]
+int main(int argc, char **argv) {
+  const std::size_t base = bench::arg_or(argc, argv, 1, 100000);
+  const std::size_t block = bench::arg_or(argc, argv, 2, 10000);
+  const int splices = static_cast<int>(bench::arg_or(argc, argv, 3, 20));
+  const int rounds = static_cast<int>(bench::arg_or(argc, argv, 4, 5));
+  std::printf("base=%zu block=%zu splices=%d rounds=%d\n", base, block,
+              splices, rounds);
+
+  auto range = [](auto &v, std::size_t at, const std::vector<int> &src) {
+    v.insert(v.begin() + at, src.begin(), src.end());
+  };
+  // what a range insert used to cost: one shift of the tail per element
+  auto one_by_one = [](auto &v, std::size_t at, const std::vector<int> &src) {
+    for (std::size_t i = 0; i < src.size(); ++i)
+      v.insert(v.begin() + at + i, src[i]);
+  };
+
+  std::printf("  %-22s %10.3f\n", "s21 insert(range)",
+              splice_ns<s21::vector<int>>(base, block, splices, rounds, range));
+  std::printf("  %-22s %10.3f\n", "std insert(range)",
+              splice_ns<std::vector<int>>(base, block, splices, rounds, range));
+  std::printf("  %-22s %10.3f\n", "s21 per element",
+              splice_ns<s21::vector<int>>(base, block / 100 + 1, splices,
+                                          rounds, one_by_one));
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <memory>
+#include <vector>
+
+#include "proj_bench.hpp"
+
+namespace {
+
+// std::allocator under another name, which keeps s21::vector off realloc
+template <typename T>
+struct new_allocator : std::allocator<T> {
+  new_allocator() = default;
+  template <typename U>
+  new_allocator(const new_allocator<U> &) noexcept {}
+  template <typename U>
+  struct rebind {
+    using other = new_allocator<U>;
+  };
+};
+
+// Fills a vector with n values in a child process and prints the fill time
+// and the child's peak resident memory, so every row starts from a clean heap
+template <typename Vector>
+void row(const char *name, std::size_t n) {
+  std::fflush(stdout);
+  pid_t pid = fork();
+  if (pid == 0) {
+    Vector v;
+    double ns = bench::measure_ns([&] {
+      for (std::size_t i = 0; i < n; ++i) v.push_back(i);
+      bench::keep(v.data());
+    });
+    std::printf("  %-30s %8.2f %10.1f", name, ns / n,
+                v.capacity() * sizeof(std::uint64_t) / 1048576.0);
+    std::fflush(stdout);
+    _exit(0);
+  }
+  int status = 0;
+  rusage usage{};
+  wait4(pid, &status, 0, &usage);
+  std::printf(" %10.1f\n", usage.ru_maxrss / 1024.0);
+}
+
+}  // namespace
+
+// usage: proj_vector_policy_bench [elements]
+int main(int argc, char **argv) {
+  using u64 = std::uint64_t;
+  const std::size_t n = bench::arg_or(argc, argv, 1, 20000000);
+  std::printf("elements=%zu (%zu MiB of data)\n", n,
+              n * sizeof(u64) / 1048576);
+
+  std::printf("  %-30s %8s %10s %10s\n", "", "ns/push", "cap MiB", "peak MiB");
+  row<std::vector<u64>>("std::vector", n);
+  row<s21::vector<u64, new_allocator<u64>>>("s21 2x, copying", n);
+  row<s21::vector<u64>>("s21 2x, realloc", n);
+  row<s21::vector<u64, std::allocator<u64>, s21::golden_growth>>(
+      "s21 1.5x, realloc", n);
+  row<s21::vector<u64, std::allocator<u64>, s21::size_class_growth>>(
+      "s21 size classes, realloc", n);
+  return 0;
+}
@@ -4,8 +4,12 @@
 #include <initializer_list>
 #include <iterator>
 
+#include "../utilities/simd.hpp"
+
 namespace s21 {
-template <typename T, std::size_t N>
+// Align raises the alignment of the elements, e.g. to 64 for SIMD loads
+// that shouldn't cross cache lines
+template <typename T, std::size_t N, std::size_t Align = alignof(T)>
 struct array {
  public:
   using value_type = T;
@@ -60,31 +64,59 @@ struct array {
   constexpr size_type size() const noexcept { return end() - begin(); }
   constexpr size_type max_size() const noexcept { return size(); }
 
-  void swap(array &other) {
-    for (size_type i = 0; i < size(); ++i) std::swap(data_[i], other.data_[i]);
-  }
+  void swap(array &other) { simd::swap_ranges(data_, other.data_, N); }
+
+  void fill(const_reference value) { simd::fill(data_, N, value); }
 
-  void fill(const_reference value) {
-    for (size_type i = 0; i < size(); ++i) data_[i] = value;
+  // Linear scans, vectorized for arithmetic types (utilities/simd.hpp)
+  iterator find(const_reference value) {
+    return data_ + simd::find(data_, N, value);
+  }
+  const_iterator find(const_reference value) const {
+    return data_ + simd::find(data_, N, value);
+  }
+  size_type count(const_reference value) const {
+    return simd::count(data_, N, value);
   }
+  bool contains(const_reference value) const {
+    return simd::find(data_, N, value) != N;
+  }
+  value_type min() const { return simd::min(data_, N); }
+  value_type max() const { return simd::max(data_, N); }
+  simd::sum_type<T> sum() const { return simd::sum(data_, N); }
 
   /*** NON MEMBER ***/
-  friend bool operator==(const array<T, N> &lhs, const array<T, N> &rhs) {
-    for (size_t i = 0; i < N; ++i) {
-      if (lhs.data_[i] != rhs.data_[i]) {
-        return false;
-      }
-    }
-    return true;
+  friend bool operator==(const array &lhs, const array &rhs) {
+    return simd::equal(lhs.data_, rhs.data_, N);
+  }
+
+  friend bool operator!=(const array &lhs, const array &rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator<(const array &lhs, const array &rhs) {
+    return simd::compare(lhs.data_, N, rhs.data_, N) < 0;
+  }
+
+  friend bool operator>(const array &lhs, const array &rhs) {
+    return rhs < lhs;
+  }
+
+  friend bool operator<=(const array &lhs, const array &rhs) {
+    return !(rhs < lhs);
+  }
+
+  friend bool operator>=(const array &lhs, const array &rhs) {
+    return !(lhs < rhs);
   }
 
  private:
-  value_type data_[N]{};
+  alignas(Align < alignof(T) ? alignof(T) : Align) value_type data_[N]{};
 };
 
 // partial specialisation for zero-size array
-template <typename T>
-struct array<T, 0> {
+template <typename T, std::size_t Align>
+struct array<T, 0, Align> {
   using value_type = T;
   using reference = value_type &;
   using pointer = value_type *;
@@ -0,0 +1,190 @@
+#ifndef S21_FROZEN_MAP_HPP
+#define S21_FROZEN_MAP_HPP
+
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+#include "../utilities/eytzinger_layout.hpp"
+#include "proj_map.hpp"
+
+namespace s21 {
+
+// Read-only map: keys in an Eytzinger-ordered aligned array, the mapped
+// values in a parallel array indexed by the same slot
+template <typename Key, typename T>
+class frozen_map {
+  class FrozenMapConstIterator;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type &, const mapped_type &>;
+  using size_type = std::size_t;
+  using const_iterator = FrozenMapConstIterator;
+  using iterator = const_iterator;
+
+  frozen_map() {}
+
+  template <typename Allocator, typename Traits>
+  explicit frozen_map(const map<Key, T, Allocator, Traits> &m) {
+    std::vector<std::pair<Key, T>> sorted;
+    sorted.reserve(m.size());
+    for (auto it = m.begin(); it != m.end(); ++it)
+      sorted.emplace_back(it->first, it->second);
+    build(sorted);
+  }
+
+  frozen_map(std::initializer_list<std::pair<const Key, T>> const &items) {
+    std::vector<std::pair<Key, T>> sorted(items.begin(), items.end());
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const std::pair<Key, T> &lhs,
+                        const std::pair<Key, T> &rhs) {
+                       return lhs.first < rhs.first;
+                     });
+    sorted.erase(std::unique(sorted.begin(), sorted.end(),
+                             [](const std::pair<Key, T> &lhs,
+                                const std::pair<Key, T> &rhs) {
+                               return !(lhs.first < rhs.first);
+                             }),
+                 sorted.end());
+    build(sorted);
+  }
+
+  const_iterator begin() const noexcept {
+    return const_iterator(this, keys_.first());
+  }
+  const_iterator end() const noexcept {
+    return const_iterator(this, layout_type::npos);
+  }
+
+  bool empty() const noexcept { return keys_.size() == 0; }
+  size_type size() const noexcept { return keys_.size(); }
+
+  const mapped_type &at(const key_type &key) const {
+    size_type slot = keys_.find(key);
+    if (slot == layout_type::npos)
+      throw std::out_of_range("Key not found in the frozen map");
+    return values_[slot];
+  }
+
+  const_iterator find(const key_type &key) const noexcept {
+    return const_iterator(this, keys_.find(key));
+  }
+  const_iterator lower_bound(const key_type &key) const noexcept {
+    return const_iterator(this, keys_.lower_bound(key));
+  }
+  bool contains(const key_type &key) const noexcept {
+    return keys_.find(key) != layout_type::npos;
+  }
+  size_type count(const key_type &key) const noexcept {
+    return contains(key);
+  }
+
+  // Batched lookups with the searches interleaved level by level
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const {
+    keys_.find_many(first, last, [&](size_type slot) {
+      *out++ = const_iterator(this, slot);
+    });
+    return out;
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last,
+                         OutputIt out) const {
+    keys_.find_many(first, last, [&](size_type slot) {
+      *out++ = slot != layout_type::npos;
+    });
+    return out;
+  }
+
+  void swap(frozen_map &other) noexcept {
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+  }
+
+ private:
+  using layout_type = eytzinger_layout<Key>;
+
+  // Walks the keys of a sorted vector of pairs
+  struct key_iterator {
+    typename std::vector<std::pair<Key, T>>::const_iterator it;
+    const Key &operator*() const { return it->first; }
+    key_iterator &operator++() {
+      ++it;
+      return *this;
+    }
+  };
+
+  void build(const std::vector<std::pair<Key, T>> &sorted) {
+    keys_ = layout_type(key_iterator{sorted.begin()}, sorted.size());
+    values_.assign(sorted.size() + 1, T());
+    size_type slot = keys_.first();
+    for (const auto &item : sorted) {
+      values_[slot] = item.second;
+      slot = keys_.next(slot);
+    }
+  }
+
+  layout_type keys_;
+  std::vector<T> values_;
+};
+
+template <typename Key, typename T>
+class frozen_map<Key, T>::FrozenMapConstIterator {
+  // operator-> needs an object to point to, the pair of references is one
+  struct arrow_proxy {
+    value_type item;
+    const value_type *operator->() const noexcept { return &item; }
+  };
+
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type;
+
+  FrozenMapConstIterator() noexcept : map_(nullptr), slot_(0) {}
+  FrozenMapConstIterator(const frozen_map *m, size_type slot) noexcept
+      : map_(m), slot_(slot) {}
+
+  reference operator*() const noexcept {
+    return {map_->keys_[slot_], map_->values_[slot_]};
+  }
+  arrow_proxy operator->() const noexcept { return arrow_proxy{**this}; }
+
+  FrozenMapConstIterator &operator++() noexcept {
+    slot_ = map_->keys_.next(slot_);
+    return *this;
+  }
+
+  FrozenMapConstIterator operator++(int) noexcept {
+    FrozenMapConstIterator tmp(*this);
+    ++(*this);
+    return tmp;
+  }
+
+  friend bool operator==(const FrozenMapConstIterator &lhs,
+                         const FrozenMapConstIterator &rhs) noexcept {
+    return lhs.slot_ == rhs.slot_;
+  }
+
+  friend bool operator!=(const FrozenMapConstIterator &lhs,
+                         const FrozenMapConstIterator &rhs) noexcept {
+    return lhs.slot_ != rhs.slot_;
+  }
+
+ private:
+  const frozen_map *map_;
+  size_type slot_;
+};
+
+template <typename Key, typename T, typename Allocator, typename Traits>
+frozen_map<Key, T> freeze(const map<Key, T, Allocator, Traits> &m) {
+  return frozen_map<Key, T>(m);
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef S21_FROZEN_SET_HPP
+#define S21_FROZEN_SET_HPP
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+#include "../utilities/eytzinger_layout.hpp"
+#include "../utilities/kary_layout.hpp"
+#include "proj_set.hpp"
+
+namespace s21 {
+
+// Read-only set: the keys of a s21::set laid out in Eytzinger order in one
+// aligned array, searched without branches
+template <typename Key>
+class frozen_set {
+  class FrozenSetConstIterator;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using const_iterator = FrozenSetConstIterator;
+  using iterator = const_iterator;
+
+  frozen_set() {}
+
+  template <typename Compare, typename Allocator, typename Traits>
+  explicit frozen_set(const set<Key, Compare, Allocator, Traits> &s)
+      : layout_(s.begin(), s.size()) {}
+
+  frozen_set(std::initializer_list<value_type> const &items) {
+    std::vector<Key> sorted(items);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    layout_ = layout_type(sorted.begin(), sorted.size());
+  }
+
+  const_iterator begin() const noexcept {
+    return const_iterator(&layout_, layout_.first());
+  }
+  const_iterator end() const noexcept {
+    return const_iterator(&layout_, layout_type::npos);
+  }
+
+  bool empty() const noexcept { return layout_.size() == 0; }
+  size_type size() const noexcept { return layout_.size(); }
+
+  const_iterator find(const_reference key) const noexcept {
+    return const_iterator(&layout_, layout_.find(key));
+  }
+  const_iterator lower_bound(const_reference key) const noexcept {
+    return const_iterator(&layout_, layout_.lower_bound(key));
+  }
+  bool contains(const_reference key) const noexcept {
+    return layout_.find(key) != layout_type::npos;
+  }
+  size_type count(const_reference key) const noexcept {
+    return contains(key);
+  }
+
+  // Batched lookups with the searches interleaved level by level
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const {
+    layout_.find_many(first, last, [&](size_type slot) {
+      *out++ = const_iterator(&layout_, slot);
+    });
+    return out;
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last,
+                         OutputIt out) const {
+    layout_.find_many(first, last, [&](size_type slot) {
+      *out++ = slot != layout_type::npos;
+    });
+    return out;
+  }
+
+  void swap(frozen_set &other) noexcept { layout_.swap(other.layout_); }
+
+  friend bool operator==(const frozen_set &lhs, const frozen_set &rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  friend bool operator!=(const frozen_set &lhs, const frozen_set &rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  using layout_type = eytzinger_layout<Key>;
+
+  layout_type layout_;
+};
+
+template <typename Key>
+class frozen_set<Key>::FrozenSetConstIterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = Key;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const Key *;
+  using reference = const Key &;
+
+  FrozenSetConstIterator() noexcept : layout_(nullptr), slot_(0) {}
+  FrozenSetConstIterator(const layout_type *layout, size_type slot) noexcept
+      : layout_(layout), slot_(slot) {}
+
+  reference operator*() const noexcept { return (*layout_)[slot_]; }
+  pointer operator->() const noexcept { return &(*layout_)[slot_]; }
+
+  FrozenSetConstIterator &operator++() noexcept {
+    slot_ = layout_->next(slot_);
+    return *this;
+  }
+
+  FrozenSetConstIterator operator++(int) noexcept {
+    FrozenSetConstIterator tmp(*this);
+    ++(*this);
+    return tmp;
+  }
+
+  friend bool operator==(const FrozenSetConstIterator &lhs,
+                         const FrozenSetConstIterator &rhs) noexcept {
+    return lhs.slot_ == rhs.slot_;
+  }
+
+  friend bool operator!=(const FrozenSetConstIterator &lhs,
+                         const FrozenSetConstIterator &rhs) noexcept {
+    return lhs.slot_ != rhs.slot_;
+  }
+
+ private:
+  const layout_type *layout_;
+  size_type slot_;
+};
+
+// Membership-only frozen set of 32/64 bit integers in a SIMD k-ary layout
+template <typename Key>
+class frozen_kary_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using size_type = std::size_t;
+
+  frozen_kary_set() {}
+
+  template <typename Compare, typename Allocator, typename Traits>
+  explicit frozen_kary_set(const set<Key, Compare, Allocator, Traits> &s)
+      : layout_(s.begin(), s.size()) {}
+
+  frozen_kary_set(std::initializer_list<value_type> const &items) {
+    std::vector<Key> sorted(items);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    layout_ = kary_layout<Key>(sorted.begin(), sorted.size());
+  }
+
+  bool empty() const noexcept { return layout_.size() == 0; }
+  size_type size() const noexcept { return layout_.size(); }
+
+  bool contains(Key key) const noexcept { return layout_.contains(key); }
+  size_type count(Key key) const noexcept { return contains(key); }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last,
+                         OutputIt out) const {
+    layout_.contains_many(first, last, [&](bool found) { *out++ = found; });
+    return out;
+  }
+
+ private:
+  kary_layout<Key> layout_;
+};
+
+template <typename Key, typename Compare, typename Allocator, typename Traits>
+frozen_set<Key> freeze(const set<Key, Compare, Allocator, Traits> &s) {
+  return frozen_set<Key>(s);
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef S21_INTERVAL_MAP_HPP
+#define S21_INTERVAL_MAP_HPP
+
+#include <memory>
+#include <memory_resource>
+
+#include "../utilities/interval_tree.hpp"
+
+namespace s21 {
+
+// Values attached to closed intervals [lo, hi], overlapping intervals and
+// repeated ones are all kept
+template <typename Key, typename Value,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class interval_map : public interval_tree<Key, Value, Allocator> {
+  using base = interval_tree<Key, Value, Allocator>;
+
+ public:
+  using mapped_type = Value;
+
+  using base::base;
+
+  void insert(const Key &lo, const Key &hi, const Value &value) {
+    this->insert_entry(lo, typename base::entry_type{hi, value});
+  }
+};
+
+namespace pmr {
+template <typename Key, typename Value>
+using interval_map = s21::interval_map<
+    Key, Value, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+}  // namespace pmr
+
+}  // namespace s21
+
+#endif
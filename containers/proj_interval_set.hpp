@@ -0,0 +1,33 @@
+#ifndef S21_INTERVAL_SET_HPP
+#define S21_INTERVAL_SET_HPP
+
+#include <memory>
+#include <memory_resource>
+
+#include "../utilities/interval_tree.hpp"
+
+namespace s21 {
+
+// Closed intervals [lo, hi], overlapping intervals and repeated ones are
+// all kept
+template <typename Key, typename Allocator = std::allocator<Key>>
+class interval_set : public interval_tree<Key, void, Allocator> {
+  using base = interval_tree<Key, void, Allocator>;
+
+ public:
+  using base::base;
+
+  void insert(const Key &lo, const Key &hi) {
+    this->insert_entry(lo, typename base::entry_type{hi});
+  }
+};
+
+namespace pmr {
+template <typename Key>
+using interval_set =
+    s21::interval_set<Key, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+
+}  // namespace s21
+
+#endif
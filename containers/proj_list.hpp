@@ -3,6 +3,11 @@
 
 #include <initializer_list>
 #include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "../utilities/arena.hpp"
 
 namespace s21 {
 template <typename T, typename A = std::allocator<T>>
@@ -14,6 +19,7 @@ class list {
   using const_reference = const value_type &;
   using size_type = std::size_t;
   using allocator = A;
+  using allocator_type = A;
 
  private:
   struct Node {
@@ -24,6 +30,7 @@ class list {
 
   using node_allocator =
       typename std::allocator_traits<allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
 
  public:
   class ListIterator {
@@ -142,7 +149,6 @@ class list {
   friend iterator;
 
  private:
-  allocator alloc_;
   node_allocator node_alloc_;
   size_type sz_;
 
@@ -151,7 +157,7 @@ class list {
 
  public:
   list(const allocator &alloc = allocator()) try
-      : alloc_(alloc), sz_(0), end_(create_end()) {
+      : node_alloc_(alloc), sz_(0), end_(create_end()) {
   } catch (std::bad_alloc &t) {
     std::cerr << t.what() << std::endl;
     clear();
@@ -159,8 +165,8 @@ class list {
   }
 
   explicit list(size_type n, const allocator &alloc = allocator()) try
-      : alloc_(alloc), sz_(0), end_(create_end()) {
-    insert(end(), n);
+      : node_alloc_(alloc), sz_(0), end_(create_end()) {
+    insert(end(), n, value_type{});
   } catch (std::bad_alloc &t) {
     std::cerr << t.what() << std::endl;
     clear();
@@ -169,7 +175,7 @@ class list {
 
   template <class InputIt>
   list(InputIt first, InputIt last, const allocator &alloc = allocator()) try
-      : alloc_(alloc), sz_(0), end_(create_end()) {
+      : node_alloc_(alloc), sz_(0), end_(create_end()) {
     for (; first != last; ++first) push_back(*first);
   } catch (std::bad_alloc &t) {
     std::cerr << t.what() << std::endl;
@@ -179,7 +185,7 @@ class list {
 
   list(std::initializer_list<value_type> const &items,
        const allocator &alloc = allocator()) try
-      : alloc_(alloc), sz_(0), end_(create_end()) {
+      : node_alloc_(alloc), sz_(0), end_(create_end()) {
     for (const_reference item : items) push_back(item);
   } catch (std::bad_alloc &t) {
     std::cerr << t.what() << std::endl;
@@ -187,7 +193,12 @@ class list {
     throw;
   }
 
-  list(const list &l) try : alloc_(l.alloc_), sz_(0), end_(create_end()) {
+  list(const list &l)
+      : list(l, node_traits::select_on_container_copy_construction(
+                    l.node_alloc_)) {}
+
+  list(const list &l, const allocator &alloc) try
+      : node_alloc_(alloc), sz_(0), end_(create_end()) {
     for (const_iterator it = l.begin(); it != l.end(); ++it) {
       push_back(*it);
     }
@@ -197,8 +208,23 @@ class list {
     throw;
   }
 
-  list(list &&l) try : alloc_(allocator()), sz_(0), end_(create_end()) {
-    swap(l);
+  // The sentinel is made with the same allocator the nodes are moved with
+  list(list &&l) try : node_alloc_(l.node_alloc_), sz_(0), end_(create_end()) {
+    swap_nodes(l);
+  } catch (std::bad_alloc &t) {
+    std::cerr << t.what() << std::endl;
+    clear();
+    throw;
+  }
+
+  list(list &&l, const allocator &alloc) try
+      : node_alloc_(alloc), sz_(0), end_(create_end()) {
+    if (node_alloc_ == l.node_alloc_) {
+      swap_nodes(l);
+    } else {
+      for (iterator it = l.begin(); it != l.end(); ++it)
+        push_back(std::move(*it));
+    }
   } catch (std::bad_alloc &t) {
     std::cerr << t.what() << std::endl;
     clear();
@@ -207,16 +233,63 @@ class list {
 
   ~list() noexcept {
     clear();
-    node_alloc_.deallocate(end_, 1);
+    destroy_node(end_);
   }
 
-  list &operator=(list &&l) {
-    if (l != *this) swap(l);
+  list &operator=(const list &l) {
+    if (this == &l) return *this;
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+      if (node_alloc_ != l.node_alloc_) {
+        // the sentinel belongs to the old allocator as well
+        clear();
+        Node *old_end = end_;
+        node_allocator old_alloc(node_alloc_);
+        node_alloc_ = l.node_alloc_;
+        end_ = create_end();
+        node_traits::destroy(old_alloc, &old_end->value_);
+        node_traits::deallocate(old_alloc, old_end, 1);
+      }
+    }
+    clear();
+    for (const_iterator it = l.begin(); it != l.end(); ++it) push_back(*it);
     return *this;
   }
 
+  list &operator=(list &&l) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value) {
+    if (this == &l) return *this;
+    clear();
+    if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+      using std::swap;
+      swap(node_alloc_, l.node_alloc_);
+    } else if constexpr (!node_traits::is_always_equal::value) {
+      // nodes of a foreign allocator can't be adopted, move the values
+      if (node_alloc_ != l.node_alloc_) {
+        for (iterator it = l.begin(); it != l.end(); ++it)
+          push_back(std::move(*it));
+        return *this;
+      }
+    }
+    swap_nodes(l);
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(node_alloc_);
+  }
+
   void clear() noexcept {
-    while (sz_) pop_back();
+    if constexpr (is_arena_allocator<node_allocator>::value &&
+                  std::is_trivially_destructible<value_type>::value) {
+      // arena nodes are reclaimed in bulk, only the links are reset
+      if (!sz_) return;
+      end_->next_ = end_;
+      end_->prev_ = end_;
+      sz_ = 0;
+    } else {
+      while (sz_) pop_back();
+    }
   }
 
   reference front() { return *begin(); }
@@ -229,12 +302,26 @@ class list {
   iterator end() { return iterator(end_); }
   const_iterator end() const { return const_iterator(end_); }
 
-  void push_back(const_reference value = value_type{}) { insert(end(), value); }
+  void push_back(const_reference value = value_type{}) {
+    emplace(end(), value);
+  }
+  void push_back(value_type &&value) { emplace(end(), std::move(value)); }
   void pop_back() {
     if (sz_) erase(--end());
   }
   void push_front(const_reference value = value_type{}) {
-    insert(begin(), value);
+    emplace(begin(), value);
+  }
+  void push_front(value_type &&value) { emplace(begin(), std::move(value)); }
+
+  template <class... Args>
+  reference emplace_back(Args &&...args) {
+    return *emplace(end(), std::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  reference emplace_front(Args &&...args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
   }
   void pop_front() {
     if (sz_) erase(begin());
@@ -242,47 +329,53 @@ class list {
 
   bool empty() const noexcept { return sz_ == 0; }
   size_type size() const noexcept { return sz_; }
-  size_type max_size() const noexcept { return alloc_.max_size(); }
+  size_type max_size() const noexcept {
+    return node_traits::max_size(node_alloc_);
+  }
 
-  iterator insert(iterator pos, const_reference value) {
-    Node *new_node = create_node(value);
-    new_node->next_ = pos.ptr_;
-    if (pos.ptr_->prev_ == end_) {
-      new_node->prev_ = end_;
-      end_->next_ = new_node;
-    } else {
-      new_node->prev_ = pos.ptr_->prev_;
-      pos.ptr_->prev_->next_ = new_node;
-    }
-    pos.ptr_->prev_ = new_node;
+  // Builds the value right in a new node linked before pos
+  template <class... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    Node *next = const_cast<Node *>(pos.ptr_);
+    Node *new_node = create_node(std::forward<Args>(args)...);
+    new_node->next_ = next;
+    new_node->prev_ = next->prev_;
+    next->prev_->next_ = new_node;
+    next->prev_ = new_node;
     ++sz_;
-    return (iterator(--pos));
+    return iterator(new_node);
+  }
+
+  iterator insert(iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+
+  iterator insert(iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
   }
 
-  iterator insert(iterator pos, size_type count,
-                  const_reference value = value_type{}) {
+  iterator insert(iterator pos, size_type count, const_reference value) {
     while (count--) insert(pos, value);
     return begin();
   }
 
+  // Each argument becomes one element, moved from when passed as an rvalue
   template <class... Args>
   iterator insert_many(const_iterator pos, Args &&...args) {
     iterator it = iterator(const_cast<Node *>(pos.ptr_));
-    for (const auto &arg : {args...}) {
-      insert(it, arg);
-    }
+    (emplace(it, std::forward<Args>(args)), ...);
     return it;
   }
 
   template <class... Args>
   void insert_many_back(Args &&...args) {
-    for (const auto &arg : {args...}) push_back(arg);
+    (emplace(end(), std::forward<Args>(args)), ...);
   }
 
   template <class... Args>
   void insert_many_front(Args &&...args) {
     iterator it = begin();
-    for (const auto &arg : {args...}) insert(it, arg);
+    (emplace(it, std::forward<Args>(args)), ...);
   }
 
   iterator erase(iterator pos) {
@@ -298,20 +391,22 @@ class list {
     } else {
       pos.ptr_->next_->prev_ = pos.ptr_->prev_;
     }
-    node_alloc_.deallocate(pos.ptr_, 1);
+    destroy_node(pos.ptr_);
     --sz_;
     return tmp;
   }
 
+  // Allocators are exchanged only when they propagate on swap
   void swap(list &other) noexcept {
-    std::swap(end_, other.end_);
-    std::swap(sz_, other.sz_);
-    std::swap(alloc_, other.alloc_);
-    std::swap(node_alloc_, other.node_alloc_);
+    swap_nodes(other);
+    if constexpr (node_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(node_alloc_, other.node_alloc_);
+    }
   }
 
   void merge(list &other) {
-    if (alloc_ != other.alloc_)
+    if (node_alloc_ != other.node_alloc_)
       throw std::invalid_argument("The behavior is undefined");
     if (this != &other && other.sz_) {
       iterator it = begin();
@@ -332,7 +427,7 @@ class list {
   }
 
   void splice(iterator pos, list &other) {
-    if (alloc_ != other.alloc_)
+    if (node_alloc_ != other.node_alloc_)
       throw std::invalid_argument("The behavior is undefined");
     if (other.sz_) {
       iterator it = other.end();
@@ -404,12 +499,29 @@ class list {
 
   /*** UTILS ***/
  private:
-  Node *create_node(const_reference value = value_type{}) {
-    Node *node = node_alloc_.allocate(1);
-    node_alloc_.construct(&node->value_, value);
+  template <class... Args>
+  Node *create_node(Args &&...args) {
+    Node *node = node_traits::allocate(node_alloc_, 1);
+    try {
+      node_traits::construct(node_alloc_, &node->value_,
+                             std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(node_alloc_, node, 1);
+      throw;
+    }
     return node;
   }
 
+  void destroy_node(Node *node) noexcept {
+    node_traits::destroy(node_alloc_, &node->value_);
+    node_traits::deallocate(node_alloc_, node, 1);
+  }
+
+  void swap_nodes(list &other) noexcept {
+    std::swap(end_, other.end_);
+    std::swap(sz_, other.sz_);
+  }
+
   Node *create_end() {
     Node *end = create_node();
     end->prev_ = end;
@@ -453,6 +565,11 @@ class list {
   }
 };
 
+namespace pmr {
+template <typename T>
+using list = s21::list<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif
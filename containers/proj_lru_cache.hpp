@@ -0,0 +1,541 @@
+#ifndef S21_LRU_CACHE_HPP
+#define S21_LRU_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Capacity measures for lru_cache: every entry weighs one, or the bytes it
+// holds
+struct entry_count {
+  template <typename Key, typename T>
+  std::size_t operator()(const Key &, const T &) const noexcept {
+    return 1;
+  }
+};
+
+struct entry_bytes {
+  template <typename Key, typename T>
+  std::size_t operator()(const Key &key, const T &value) const noexcept {
+    return sizeof(Key) + sizeof(T) + heap_bytes(key, 0) +
+           heap_bytes(value, 0);
+  }
+
+ private:
+  // contiguous containers such as std::string and s21::vector count their
+  // elements as well
+  template <typename C>
+  static auto heap_bytes(const C &c, int) noexcept
+      -> decltype(c.size() * sizeof(typename C::value_type)) {
+    return c.size() * sizeof(typename C::value_type);
+  }
+  template <typename C>
+  static std::size_t heap_bytes(const C &, long) noexcept {
+    return 0;
+  }
+};
+
+// lru evicts the entry used longest ago, lfu the one used least often and
+// among those the one used longest ago
+enum class cache_policy { lru, lfu };
+
+struct cache_stats {
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t evictions = 0;
+};
+
+// Fixed-capacity cache with O(1) get, put and eviction. Entries sit in an
+// intrusive list ordered from the next victim to the latest use and in a
+// chained hash index. A touch relinks the entry in place; erased and
+// evicted nodes go to a free list and are reused by the next put, so a
+// cache at capacity stops allocating. Under lfu the list is grouped by use
+// count and every group knows its last entry, which keeps touches O(1).
+template <typename Key, typename T, typename Weigh = entry_count,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          cache_policy Policy = cache_policy::lru>
+class lru_cache {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  // called with each entry evicted for room, before it is destroyed
+  using evict_callback = std::function<void(const Key &, T &)>;
+
+ private:
+  struct links {
+    links *prev_;
+    links *next_;
+  };
+
+  struct group;
+
+  struct Node : links {
+    value_type value_;
+    Node *chain_;  // next in the hash bucket or in the free list
+    std::size_t hash_;
+    size_type weight_;
+    group *group_;  // lfu only
+  };
+
+  // A run of entries with the same use count, lfu only
+  struct group {
+    std::size_t uses_;
+    Node *last_;
+    group *free_;
+  };
+
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+  using bucket_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node *>;
+  using bucket_traits = std::allocator_traits<bucket_allocator>;
+  using group_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<group>;
+  using group_traits = std::allocator_traits<group_allocator>;
+
+  static constexpr bool lfu = Policy == cache_policy::lfu;
+  static constexpr size_type initial_buckets = 16;
+
+ public:
+  explicit lru_cache(size_type capacity, const Allocator &alloc = Allocator())
+      : node_alloc_(alloc), capacity_(capacity) {
+    reset_links();
+  }
+
+  lru_cache(const lru_cache &) = delete;
+  lru_cache &operator=(const lru_cache &) = delete;
+
+  lru_cache(lru_cache &&other) noexcept
+      : node_alloc_(std::move(other.node_alloc_)) {
+    reset_links();
+    swap_contents(other);
+  }
+
+  lru_cache &operator=(lru_cache &&other) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value) {
+    if (this == &other) return *this;
+    release();
+    if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+      node_alloc_ = std::move(other.node_alloc_);
+    } else if constexpr (!node_traits::is_always_equal::value) {
+      // nodes of a foreign allocator can't be adopted, the entries are put
+      // again in recency order and lfu use counts start over
+      if (node_alloc_ != other.node_alloc_) {
+        capacity_ = other.capacity_;
+        on_evict_ = other.on_evict_;
+        other.for_each([this](const Key &key, T &value) {
+          put(key, std::move(value));
+        });
+        other.clear();
+        return *this;
+      }
+    }
+    swap_contents(other);
+    return *this;
+  }
+
+  ~lru_cache() { release(); }
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(node_alloc_);
+  }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  size_type capacity() const noexcept { return capacity_; }
+  // sum of the entries' weights, never above capacity()
+  size_type weight() const noexcept { return weight_; }
+
+  // Evicts until the entries fit the new capacity
+  void set_capacity(size_type capacity) {
+    capacity_ = capacity;
+    shrink_to_capacity();
+  }
+
+  void on_evict(evict_callback fn) { on_evict_ = std::move(fn); }
+
+  // Value under key, counted as a use; nullptr when absent
+  T *get(const Key &key) {
+    Node *node = find_node(key);
+    if (node == nullptr) {
+      ++stats_.misses;
+      return nullptr;
+    }
+    ++stats_.hits;
+    touch(node);
+    return &node->value_.second;
+  }
+
+  // Value under key without counting a use
+  const T *peek(const Key &key) const {
+    const Node *node = find_node(key);
+    return node ? &node->value_.second : nullptr;
+  }
+
+  bool contains(const Key &key) const { return find_node(key) != nullptr; }
+
+  // Stores value under key as its latest use, evicting other entries as
+  // needed. An entry heavier than the whole capacity is evicted right away.
+  void put(const Key &key, T value) {
+    std::size_t hash = hash_of(key);
+    std::size_t weight = Weigh()(key, value);
+    Node *node = find_node(key, hash);
+    if (node != nullptr) {
+      node->value_.second = std::move(value);
+      weight_ = weight_ - node->weight_ + weight;
+      node->weight_ = weight;
+      touch(node);
+      if (weight > capacity_) {
+        evict(node);
+      } else {
+        shrink_to_capacity(node);
+      }
+      return;
+    }
+    if (weight > capacity_) {
+      if (on_evict_) on_evict_(key, value);
+      ++stats_.evictions;
+      return;
+    }
+    while (weight_ + weight > capacity_) evict(first());
+    if (size_ >= bucket_count_) grow_index();
+    node = make_node(key, std::move(value));
+    node->hash_ = hash;
+    node->weight_ = weight;
+    link_new(node);
+  }
+
+  bool erase(const Key &key) {
+    Node *node = find_node(key);
+    if (node == nullptr) return false;
+    remove(node);
+    return true;
+  }
+
+  // Drops every entry, their nodes stay for reuse
+  void clear() noexcept {
+    while (size_) remove(first());
+  }
+
+  // Returns the nodes kept for reuse to the allocator
+  void shrink_to_fit() noexcept {
+    while (free_nodes_ != nullptr) {
+      Node *next = free_nodes_->chain_;
+      node_traits::deallocate(node_alloc_, free_nodes_, 1);
+      free_nodes_ = next;
+    }
+    if constexpr (lfu) {
+      group_allocator alloc(node_alloc_);
+      while (free_groups_ != nullptr) {
+        group *next = free_groups_->free_;
+        group_traits::deallocate(alloc, free_groups_, 1);
+        free_groups_ = next;
+      }
+    }
+  }
+
+  // Visits entries from the next victim to the latest use, fn(key, value)
+  // may return false to stop
+  template <typename Fn>
+  void for_each(Fn fn) {
+    for (links *l = head_.next_; l != &head_; l = l->next_) {
+      Node *node = static_cast<Node *>(l);
+      if constexpr (std::is_void<decltype(fn(node->value_.first,
+                                             node->value_.second))>::value) {
+        fn(node->value_.first, node->value_.second);
+      } else {
+        if (!fn(node->value_.first, node->value_.second)) return;
+      }
+    }
+  }
+
+  cache_stats stats() const noexcept { return stats_; }
+  void reset_stats() noexcept { stats_ = cache_stats(); }
+
+  void swap(lru_cache &other) noexcept {
+    swap_contents(other);
+    if constexpr (node_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(node_alloc_, other.node_alloc_);
+    }
+  }
+
+ private:
+  void reset_links() noexcept { head_.prev_ = head_.next_ = &head_; }
+
+  Node *first() const noexcept { return static_cast<Node *>(head_.next_); }
+
+  static void unlink(links *l) noexcept {
+    l->prev_->next_ = l->next_;
+    l->next_->prev_ = l->prev_;
+  }
+
+  static void link_after(links *pos, links *l) noexcept {
+    l->prev_ = pos;
+    l->next_ = pos->next_;
+    pos->next_->prev_ = l;
+    pos->next_ = l;
+  }
+
+  // Spreads the low bits of std::hash over the whole index
+  std::size_t hash_of(const Key &key) const {
+    return static_cast<std::size_t>(
+        static_cast<std::uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ULL >>
+        32);
+  }
+
+  Node *find_node(const Key &key) const { return find_node(key, hash_of(key)); }
+
+  Node *find_node(const Key &key, std::size_t hash) const {
+    if (buckets_ == nullptr) return nullptr;
+    for (Node *node = buckets_[hash & (bucket_count_ - 1)]; node != nullptr;
+         node = node->chain_) {
+      if (node->hash_ == hash && KeyEqual()(node->value_.first, key))
+        return node;
+    }
+    return nullptr;
+  }
+
+  Node *make_node(const Key &key, T &&value) {
+    Node *node = free_nodes_;
+    if (node != nullptr) {
+      free_nodes_ = node->chain_;
+    } else {
+      node = node_traits::allocate(node_alloc_, 1);
+    }
+    try {
+      node_traits::construct(node_alloc_, &node->value_, key,
+                             std::move(value));
+    } catch (...) {
+      node->chain_ = free_nodes_;
+      free_nodes_ = node;
+      throw;
+    }
+    return node;
+  }
+
+  // Destroys the entry and keeps the node for the next put
+  void recycle(Node *node) noexcept {
+    node_traits::destroy(node_alloc_, &node->value_);
+    node->chain_ = free_nodes_;
+    free_nodes_ = node;
+  }
+
+  // Links a fresh node as the latest use, the index has room for it
+  void link_new(Node *node) {
+    if constexpr (lfu) {
+      group *g = size_ ? first()->group_ : nullptr;
+      if (g != nullptr && g->uses_ == 1) {
+        link_after(g->last_, node);
+        g->last_ = node;
+      } else {
+        try {
+          g = make_group(1, node);
+        } catch (...) {
+          recycle(node);
+          throw;
+        }
+        link_after(&head_, node);
+      }
+      node->group_ = g;
+    } else {
+      link_after(head_.prev_, node);
+    }
+
+    Node *&bucket = buckets_[node->hash_ & (bucket_count_ - 1)];
+    node->chain_ = bucket;
+    bucket = node;
+    ++size_;
+    weight_ += node->weight_;
+  }
+
+  void touch(Node *node) {
+    if constexpr (lfu) {
+      group *g = node->group_;
+      links *after = g->last_->next_;
+      group *next = after != &head_ ? static_cast<Node *>(after)->group_
+                                    : nullptr;
+      if (next != nullptr && next->uses_ == g->uses_ + 1) {
+        leave_group(node);
+        unlink(node);
+        link_after(next->last_, node);
+        next->last_ = node;
+        node->group_ = next;
+      } else if (g->last_ == node && node->prev_ != &head_ &&
+                 static_cast<Node *>(node->prev_)->group_ == g) {
+        // the last of a bigger group starts a group of its own in place
+        group *own = make_group(g->uses_ + 1, node);
+        g->last_ = static_cast<Node *>(node->prev_);
+        node->group_ = own;
+      } else if (g->last_ == node) {
+        ++g->uses_;
+      } else {
+        Node *last = g->last_;
+        group *own = make_group(g->uses_ + 1, node);
+        unlink(node);
+        link_after(last, node);
+        node->group_ = own;
+      }
+    } else {
+      unlink(node);
+      link_after(head_.prev_, node);
+    }
+  }
+
+  group *make_group(std::size_t uses, Node *last) {
+    group *g = free_groups_;
+    if (g != nullptr) {
+      free_groups_ = g->free_;
+    } else {
+      group_allocator alloc(node_alloc_);
+      g = group_traits::allocate(alloc, 1);
+    }
+    g->uses_ = uses;
+    g->last_ = last;
+    g->free_ = nullptr;
+    return g;
+  }
+
+  // Takes node out of its group, the group is freed once empty
+  void leave_group(Node *node) noexcept {
+    group *g = node->group_;
+    if (g->last_ != node) return;
+    links *prev = node->prev_;
+    if (prev != &head_ && static_cast<Node *>(prev)->group_ == g) {
+      g->last_ = static_cast<Node *>(prev);
+    } else {
+      g->free_ = free_groups_;
+      free_groups_ = g;
+    }
+  }
+
+  void remove(Node *node) noexcept {
+    Node **slot = &buckets_[node->hash_ & (bucket_count_ - 1)];
+    while (*slot != node) slot = &(*slot)->chain_;
+    *slot = node->chain_;
+    if constexpr (lfu) leave_group(node);
+    unlink(node);
+    --size_;
+    weight_ -= node->weight_;
+    recycle(node);
+  }
+
+  void evict(Node *victim) {
+    if (on_evict_) on_evict_(victim->value_.first, victim->value_.second);
+    ++stats_.evictions;
+    remove(victim);
+  }
+
+  // keep is the entry just put, which is not its own victim
+  void shrink_to_capacity(const Node *keep = nullptr) {
+    while (weight_ > capacity_ && size_) {
+      Node *victim = first();
+      if (victim == keep) victim = static_cast<Node *>(victim->next_);
+      evict(victim);
+    }
+  }
+
+  void grow_index() {
+    size_type count = bucket_count_ ? bucket_count_ * 2 : initial_buckets;
+    bucket_allocator alloc(node_alloc_);
+    Node **buckets = bucket_traits::allocate(alloc, count);
+    for (size_type i = 0; i < count; ++i) buckets[i] = nullptr;
+    for (size_type i = 0; i < bucket_count_; ++i) {
+      for (Node *node = buckets_[i]; node != nullptr;) {
+        Node *next = node->chain_;
+        Node *&bucket = buckets[node->hash_ & (count - 1)];
+        node->chain_ = bucket;
+        bucket = node;
+        node = next;
+      }
+    }
+    if (buckets_ != nullptr)
+      bucket_traits::deallocate(alloc, buckets_, bucket_count_);
+    buckets_ = buckets;
+    bucket_count_ = count;
+  }
+
+  void release() noexcept {
+    clear();
+    shrink_to_fit();
+    if (buckets_ != nullptr) {
+      bucket_allocator alloc(node_alloc_);
+      bucket_traits::deallocate(alloc, buckets_, bucket_count_);
+    }
+    buckets_ = nullptr;
+    bucket_count_ = 0;
+  }
+
+  // The list head lives inside the object, the end nodes are pointed back
+  // at it after a swap
+  void adopt_head(bool linked) noexcept {
+    if (linked) {
+      head_.next_->prev_ = &head_;
+      head_.prev_->next_ = &head_;
+    } else {
+      reset_links();
+    }
+  }
+
+  // Exchanges everything but the allocators
+  void swap_contents(lru_cache &other) noexcept {
+    std::swap(head_, other.head_);
+    adopt_head(other.size_ != 0);
+    other.adopt_head(size_ != 0);
+    std::swap(buckets_, other.buckets_);
+    std::swap(bucket_count_, other.bucket_count_);
+    std::swap(size_, other.size_);
+    std::swap(weight_, other.weight_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(free_nodes_, other.free_nodes_);
+    std::swap(free_groups_, other.free_groups_);
+    std::swap(on_evict_, other.on_evict_);
+    std::swap(stats_, other.stats_);
+  }
+
+  node_allocator node_alloc_;
+  links head_;
+  Node **buckets_ = nullptr;
+  size_type bucket_count_ = 0;
+  size_type size_ = 0;
+  size_type weight_ = 0;
+  size_type capacity_ = 0;
+  Node *free_nodes_ = nullptr;
+  group *free_groups_ = nullptr;
+  evict_callback on_evict_;
+  cache_stats stats_;
+};
+
+// Least frequently used eviction, ties go to the least recently used
+template <typename Key, typename T, typename Weigh = entry_count,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+using lfu_cache =
+    lru_cache<Key, T, Weigh, Hash, KeyEqual, Allocator, cache_policy::lfu>;
+
+namespace pmr {
+template <typename Key, typename T, typename Weigh = entry_count>
+using lru_cache =
+    s21::lru_cache<Key, T, Weigh, std::hash<Key>, std::equal_to<Key>,
+                   std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+
+}  // namespace s21
+
+#endif
@@ -3,12 +3,18 @@
 
 #include <initializer_list>
 #include <memory>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include "../utilities/rb_tree.hpp"
 #include "proj_vector.hpp"
 
 namespace s21 {
-template <typename Key, typename T>
+template <typename Key, typename T,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          typename Traits = tree_traits>
 class map {
   class MapIterator;
   class MapConstIterator;
@@ -20,38 +26,69 @@ class map {
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = std::size_t;
-  using tree_type = RedBlackTree<Key, T>;
+  using allocator_type = Allocator;
+  using tree_type = RedBlackTree<Key, T, Allocator, Traits>;
   using iterator = MapIterator;
   using const_iterator = MapConstIterator;
+  using batch_op = s21::batch_op<Key, T>;
+  // Under aggregate_tree_traits every value is folded into the nodes above
+  // it, so at(), operator[], iterators and for_each only read the values
+  // and they change through insert_or_assign() or apply_batch()
+  static constexpr bool folded = !std::is_void<typename Traits::augment>::value;
+  using mapped_reference =
+      std::conditional_t<folded, const mapped_type &, mapped_type &>;
+  // for_each callbacks take the key as const, so one declared with a
+  // mutable key is rejected at the call
+  template <typename Fn, typename Value>
+  using visitor = std::enable_if_t<
+      std::is_invocable<Fn &, const key_type &, Value>::value>;
 
   map() : rb_tree_() {}
+  explicit map(const allocator_type &alloc) : rb_tree_(alloc) {}
 
-  map(std::initializer_list<value_type> const &items) : rb_tree_() {
-    for (const_reference item : items) rb_tree_.insert(item.first, item.second);
+  map(std::initializer_list<value_type> const &items,
+      const allocator_type &alloc = allocator_type())
+      : rb_tree_(alloc) {
+    for (const_reference item : items)
+      rb_tree_.tryEmplace(item.first, item.second);
   }
 
   map(const map &m) : rb_tree_(m.rb_tree_) {}
+  map(const map &m, const allocator_type &alloc)
+      : rb_tree_(m.rb_tree_, alloc) {}
 
-  map(map &&m) : rb_tree_(std::move(m.rb_tree_)) {}
+  map(map &&m) noexcept : rb_tree_(std::move(m.rb_tree_)) {}
+  map(map &&m, const allocator_type &alloc)
+      : rb_tree_(std::move(m.rb_tree_), alloc) {}
 
-  map &operator=(map &&m) {
-    if (m != *this) swap(m);
+  map &operator=(const map &m) {
+    rb_tree_ = m.rb_tree_;
     return *this;
   }
 
+  map &operator=(map &&m) noexcept(
+      std::is_nothrow_move_assignable<tree_type>::value) {
+    rb_tree_ = std::move(m.rb_tree_);
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return rb_tree_.get_allocator();
+  }
+
   ~map() {}
 
-  mapped_type &at(const key_type &key) {
+  mapped_reference at(const key_type &key) {
     if (!contains(key)) throw std::out_of_range("Key not found in the map");
     return *iterator(rb_tree_.searchTree(key));
   }
 
-  mapped_type &operator[](const key_type &key) {
-    iterator place(rb_tree_.searchTree(key));
-    if (place == rb_tree_.getNullNode()) {
-      rb_tree_.insert(key, mapped_type());
-    }
-    return *place;
+  mapped_reference operator[](const key_type &key) {
+    return (*rb_tree_.tryEmplace(key).first)->value;
+  }
+
+  mapped_reference operator[](key_type &&key) {
+    return (*rb_tree_.tryEmplace(std::move(key)).first)->value;
   }
 
   iterator begin() { return MapIterator(rb_tree_.begin()); }
@@ -66,51 +103,74 @@ class map {
   void clear() noexcept { rb_tree_.clear(); }
 
   std::pair<iterator, bool> insert(const_reference value) {
-    iterator place(rb_tree_.searchTree(value.first));
-    bool placed = false;
-    if (place == rb_tree_.getNullNode()) {
-      placed = true;
-      rb_tree_.insert(value.first, value.second);
-      place = iterator(rb_tree_.searchTree(value.first));
-    }
-    return std::pair<iterator, bool>(place, placed);
+    return placed(rb_tree_.tryEmplace(value.first, value.second));
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return placed(rb_tree_.tryEmplace(value.first, std::move(value.second)));
   }
 
   std::pair<iterator, bool> insert(const key_type &key,
                                    const mapped_type &obj) {
-    iterator place(rb_tree_.searchTree(key));
-    bool placed = false;
-    if (place == rb_tree_.getNullNode()) {
-      placed = true;
-      rb_tree_.insert(key, obj);
-      place = iterator(rb_tree_.searchTree(key));
-    }
-    return std::pair<iterator, bool>(rb_tree_.getNullNode(), placed);
+    return placed(rb_tree_.tryEmplace(key, obj));
   }
 
   std::pair<iterator, bool> insert_or_assign(const key_type &key,
                                              const mapped_type &obj) {
-    iterator place(rb_tree_.searchTree(key));
-    bool placed = false;
-    if (place == rb_tree_.getNullNode()) {
-      placed = true;
-      rb_tree_.insert(key, obj);
-      place = rb_tree_.searchTree(key);
-    } else {
-      *place = obj;
-    }
-    return std::pair<iterator, bool>(rb_tree_.getNullNode(), placed);
+    auto place = rb_tree_.tryEmplace(key, obj);
+    if (!place.second) rb_tree_.assign(key, obj);
+    return placed(place);
   }
 
-  void erase(iterator &pos) { rb_tree_.deleteNode(pos->first); }
-  void erase(iterator pos) { rb_tree_.deleteNode(pos->first); }
+  // Takes a key and a mapped value, a pair of them or std::piecewise_construct
+  // with two tuples; the node is built in place and freed again when the key
+  // is taken
+  template <typename K, typename V>
+  std::pair<iterator, bool> emplace(K &&key, V &&obj) {
+    return placed(
+        rb_tree_.emplaceUnique(std::forward<K>(key), std::forward<V>(obj)));
+  }
 
-  void swap(map &other) {
-    RedBlackTree new_tree(other.rb_tree_);
-    other.rb_tree_ = rb_tree_;
-    rb_tree_ = new_tree;
+  template <typename P>
+  std::pair<iterator, bool> emplace(P &&pair) {
+    return emplace(std::get<0>(std::forward<P>(pair)),
+                   std::get<1>(std::forward<P>(pair)));
   }
 
+  template <typename... KeyArgs, typename... ValueArgs>
+  std::pair<iterator, bool> emplace(std::piecewise_construct_t,
+                                    std::tuple<KeyArgs...> key,
+                                    std::tuple<ValueArgs...> obj) {
+    return placed(rb_tree_.emplaceUnique(std::piecewise_construct,
+                                         std::move(key), std::move(obj)));
+  }
+
+  // Builds the mapped value from args only when key is not in the map yet
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return placed(rb_tree_.tryEmplace(key, std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return placed(
+        rb_tree_.tryEmplace(std::move(key), std::forward<Args>(args)...));
+  }
+
+  // A hint right after where the key belongs saves the walk from the root,
+  // so filling the map in order with end() as the hint doesn't search
+  template <typename K, typename V>
+  iterator emplace_hint(const_iterator hint, K &&key, V &&obj) {
+    return iterator(rb_tree_
+                        .emplaceHint(*hint.rb_it, true, std::forward<K>(key),
+                                     std::forward<V>(obj))
+                        .first);
+  }
+
+  void erase(iterator pos) { rb_tree_.deleteNode(pos->first); }
+
+  void swap(map &other) noexcept { rb_tree_.swap(other.rb_tree_); }
+
   void merge(map &other) {
     if (this == &other) return;
     for (iterator it = other.begin(); it != other.end(); ++it) {
@@ -118,14 +178,95 @@ class map {
     }
   }
 
-  bool contains(const Key &key) {
+  bool contains(const Key &key) const {
     return rb_tree_.searchTree(key) != rb_tree_.getNullNode();
   }
 
+  iterator find(const key_type &key) {
+    iterator place(rb_tree_.searchTree(key));
+    return place == rb_tree_.getNullNode() ? end() : place;
+  }
+
+  // Looks up a batch of keys with interleaved tree walks, writes one
+  // iterator per key (end() for a miss)
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) {
+    rb_tree_.searchMany(first, last, [&](auto *node, bool found) {
+      *out++ = found ? iterator(typename tree_type::iterator(node))
+                     : iterator(rb_tree_.getNullNode());
+    });
+    return out;
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last,
+                         OutputIt out) const {
+    rb_tree_.searchMany(first, last,
+                        [&](const void *, bool found) { *out++ = found; });
+    return out;
+  }
+
+  // Applies a change-set sorted by key in one pass over the tree and writes
+  // one batch_outcome per op
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt apply_batch(ForwardIt first, ForwardIt last, OutputIt outcomes) {
+    return rb_tree_.applyBatch(first, last, outcomes, true);
+  }
+
+  template <typename Ops>
+  vector<batch_outcome> apply_batch(const Ops &sorted_ops) {
+    vector<batch_outcome> outcomes;
+    apply_batch(sorted_ops.begin(), sorted_ops.end(),
+                std::back_inserter(outcomes));
+    return outcomes;
+  }
+
+  // Visits elements in key order as fn(key, value) straight on the tree
+  // nodes, a false return from fn ends the scan
+  template <typename Fn, typename = visitor<Fn, mapped_reference>>
+  void for_each(Fn fn) {
+    if constexpr (folded)
+      std::as_const(rb_tree_).forEach(fn);
+    else
+      rb_tree_.forEach(fn);
+  }
+
+  template <typename Fn, typename = visitor<Fn, const mapped_type &>>
+  void for_each(Fn fn) const {
+    rb_tree_.forEach(fn);
+  }
+
+  // Same for the keys in [lo, hi)
+  template <typename Fn, typename = visitor<Fn, mapped_reference>>
+  void for_each_in_range(const key_type &lo, const key_type &hi, Fn fn) {
+    if constexpr (folded)
+      std::as_const(rb_tree_).forEachInRange(lo, hi, fn);
+    else
+      rb_tree_.forEachInRange(lo, hi, fn);
+  }
+
+  template <typename Fn, typename = visitor<Fn, const mapped_type &>>
+  void for_each_in_range(const key_type &lo, const key_type &hi,
+                         Fn fn) const {
+    rb_tree_.forEachInRange(lo, hi, fn);
+  }
+
+  // Fold of the values with keys in [lo, hi) under the monoid of
+  // aggregate_tree_traits, in O(log n)
+  auto aggregate(const key_type &lo, const key_type &hi) const {
+    return rb_tree_.aggregate(lo, hi);
+  }
+
+  tree_stats stats() const { return rb_tree_.stats(); }
+  void reset_stats() noexcept { rb_tree_.reset_stats(); }
+  bloom_filter_stats bloom_stats() const { return rb_tree_.bloom_stats(); }
+  void reset_bloom_stats() noexcept { rb_tree_.reset_bloom_stats(); }
+
+  // Each argument is a key-value pair, moved from when passed as an rvalue
   template <typename... Args>
   vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
     vector<std::pair<iterator, bool>> vec;
-    for (const auto &arg : {args...}) vec.push_back(insert(arg, arg));
+    (vec.push_back(emplace(std::forward<Args>(args))), ...);
     return vec;
   }
 
@@ -139,22 +280,25 @@ class map {
   }
 
  private:
+  static std::pair<iterator, bool> placed(
+      std::pair<typename tree_type::iterator, bool> place) {
+    return {iterator(place.first), place.second};
+  }
+
   tree_type rb_tree_;
 };
 
-template <typename Key, typename T>
-class map<Key, T>::MapIterator {
+template <typename Key, typename T, typename Allocator, typename Traits>
+class map<Key, T, Allocator, Traits>::MapIterator {
  public:
   MapIterator() noexcept {}
 
   MapIterator(const MapIterator &it) noexcept : rb_it(it.rb_it) {}
   MapIterator(MapIterator &&it) noexcept : rb_it(std::move(it.rb_it)) {}
 
-  MapIterator(const typename RedBlackTree<Key, T>::iterator &it) noexcept
-      : rb_it(it) {}
-  MapIterator(typename RedBlackTree<Key, T>::iterator &it) noexcept
-      : rb_it(it) {}
-  MapIterator(typename RedBlackTree<Key, T>::iterator &&it) noexcept
+  MapIterator(const typename tree_type::iterator &it) noexcept : rb_it(it) {}
+  MapIterator(typename tree_type::iterator &it) noexcept : rb_it(it) {}
+  MapIterator(typename tree_type::iterator &&it) noexcept
       : rb_it(std::move(it)) {}
   ~MapIterator() {}
 
@@ -175,7 +319,7 @@ class map<Key, T>::MapIterator {
     return lhs.rb_it != rhs.rb_it;
   }
 
-  T &operator*() noexcept { return (*rb_it)->value; }
+  mapped_reference operator*() noexcept { return (*rb_it)->value; }
   std::pair<Key, T> *operator->() noexcept {
     data.first = (*rb_it)->key;
     data.second = (*rb_it)->value;
@@ -214,12 +358,15 @@ class map<Key, T>::MapIterator {
   }
 
  private:
-  typename RedBlackTree<Key, T>::iterator rb_it;
+  friend class map;
+  friend class MapConstIterator;
+
+  typename tree_type::iterator rb_it;
   std::pair<Key, T> data;
 };
 
-template <typename Key, typename T>
-class map<Key, T>::MapConstIterator {
+template <typename Key, typename T, typename Allocator, typename Traits>
+class map<Key, T, Allocator, Traits>::MapConstIterator {
  public:
   MapConstIterator() noexcept {}
 
@@ -227,10 +374,11 @@ class map<Key, T>::MapConstIterator {
   MapConstIterator(MapConstIterator &&it) noexcept
       : rb_it(std::move(it.rb_it)) {}
 
-  MapConstIterator(
-      const typename RedBlackTree<Key, T>::const_iterator &it) noexcept
+  MapConstIterator(const MapIterator &it) noexcept
+      : rb_it(*it.rb_it) {}
+  MapConstIterator(const typename tree_type::const_iterator &it) noexcept
       : rb_it(it) {}
-  MapConstIterator(typename RedBlackTree<Key, T>::const_iterator &&it) noexcept
+  MapConstIterator(typename tree_type::const_iterator &&it) noexcept
       : rb_it(std::move(it)) {}
   ~MapConstIterator() {}
 
@@ -251,9 +399,11 @@ class map<Key, T>::MapConstIterator {
     return lhs.rb_it != rhs.rb_it;
   }
 
-  // const_reference operator*() const noexcept { return (*rb_it)->value; }
-  std::pair<Key, T> operator->() noexcept {
-    return {(*rb_it)->key, (*rb_it)->value};
+  const T &operator*() noexcept { return (*rb_it)->value; }
+  const std::pair<Key, T> *operator->() noexcept {
+    data.first = (*rb_it)->key;
+    data.second = (*rb_it)->value;
+    return &data;
   }
 
   MapConstIterator &operator++() noexcept {
@@ -288,8 +438,17 @@ class map<Key, T>::MapConstIterator {
   }
 
  private:
-  typename RedBlackTree<Key, T>::const_iterator rb_it;
+  friend class map;
+
+  typename tree_type::const_iterator rb_it;
+  std::pair<Key, T> data;
 };
 
+namespace pmr {
+template <typename Key, typename T>
+using map =
+    s21::map<Key, T, std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+
 }  // namespace s21
 #endif
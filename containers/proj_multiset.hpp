@@ -2,14 +2,41 @@
 #define S21_MULTISET_H
 
 #include <initializer_list>
+#include <memory_resource>
 
 #include "../utilities/rb_tree.hpp"
 #include "proj_vector.hpp"
 
 namespace s21 {
 
+// Which copy of its key an iterator stands on. Only counted multisets step
+// through copies inside one node; otherwise the base is empty and every
+// iterator is on copy 0.
+template <bool Counted>
+class multiset_copy_index {
+ public:
+  multiset_copy_index() noexcept {}
+  explicit multiset_copy_index(std::size_t) noexcept {}
+
+ protected:
+  std::size_t copy() const noexcept { return 0; }
+};
+
+template <>
+class multiset_copy_index<true> {
+ public:
+  multiset_copy_index() noexcept {}
+  explicit multiset_copy_index(std::size_t copy) noexcept : copy_(copy) {}
+
+ protected:
+  std::size_t copy() const noexcept { return copy_; }
+
+  std::size_t copy_ = 0;
+};
+
 template <typename Key, typename Compare = std::less<Key>,
-          typename Allocator = std::allocator<Key>>
+          typename Allocator = std::allocator<Key>,
+          typename Traits = tree_traits>
 class multiset {
   class MultisetIterator;
   class MultisetConstIterator;
@@ -21,55 +48,118 @@ class multiset {
   using const_reference = const value_type &;
   using size_type = std::size_t;
   using allocator = Allocator;
+  using allocator_type = Allocator;
+  // Traits::count_duplicates stores each distinct key once with the number
+  // of its copies as the mapped value
+  static constexpr bool counted = Traits::count_duplicates;
+  using tree_type =
+      RedBlackTree<Key, std::conditional_t<counted, size_type, Key>, Allocator,
+                   Traits>;
+  using batch_op = s21::batch_op<Key>;
   using iterator = MultisetIterator;
   using const_iterator = MultisetConstIterator;
 
   multiset() : rb() {}
+  explicit multiset(const allocator_type &alloc) : rb(alloc) {}
 
-  multiset(std::initializer_list<Key> const &items) {
-    for (const auto item : items) rb.insert(item, item);
+  multiset(std::initializer_list<Key> const &items,
+           const allocator_type &alloc = allocator_type())
+      : rb(alloc) {
+    for (const auto &item : items) add(item);
   }
 
-  multiset(const multiset &s) : rb(s.rb) {}
-  multiset(multiset &&s) { rb = std::move(s.rb); }
+  multiset(const multiset &s) : rb(s.rb), copies_(s.copies_) {}
+  multiset(const multiset &s, const allocator_type &alloc)
+      : rb(s.rb, alloc), copies_(s.copies_) {}
+  multiset(multiset &&s) noexcept
+      : rb(std::move(s.rb)), copies_(std::exchange(s.copies_, 0)) {}
+  multiset(multiset &&s, const allocator_type &alloc)
+      : rb(std::move(s.rb), alloc), copies_(s.copies_) {
+    if (s.rb.empty()) s.copies_ = 0;
+  }
 
   ~multiset() {}
 
-  multiset &operator=(multiset s) {
-    std::swap(rb, s.rb);
+  multiset &operator=(const multiset &s) {
+    rb = s.rb;
+    copies_ = s.copies_;
+    return *this;
+  }
+
+  multiset &operator=(multiset &&s) noexcept(
+      std::is_nothrow_move_assignable<tree_type>::value) {
+    rb = std::move(s.rb);
+    copies_ = s.copies_;
+    if (s.rb.empty()) s.copies_ = 0;
     return *this;
   }
 
+  allocator_type get_allocator() const noexcept { return rb.get_allocator(); }
+
   iterator begin() { return MultisetIterator(rb.begin()); }
   iterator end() { return MultisetIterator(rb.end()); }
   const_iterator begin() const { return MultisetIterator(rb.begin()); }
   const_iterator end() const { return MultisetIterator(rb.end()); }
 
   constexpr inline bool empty() const noexcept { return rb.empty(); }
-  constexpr inline size_type size() const noexcept { return rb.size(); }
+  constexpr inline size_type size() const noexcept {
+    if constexpr (counted) return copies_;
+    return rb.size();
+  }
   size_type max_size() const noexcept { return rb.max_size(); }
 
-  void clear() noexcept { rb.clear(); }
+  void clear() noexcept {
+    rb.clear();
+    copies_ = 0;
+  }
+
+  iterator insert(const_reference value) { return placed(add(value)); }
+  iterator insert(value_type &&value) { return placed(add(std::move(value))); }
 
-  iterator insert(const_reference value) {
-    iterator place(rb.searchTree(value));
-    rb.insert(value, value);
-    place = iterator(rb.searchTree(value));
-    return place;
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  // A hint right after where the key belongs saves the walk from the root,
+  // the new copy goes right before hint when it is one of the equal keys
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    if constexpr (counted) {
+      return emplace(std::forward<Args>(args)...);
+    } else {
+      value_type key(std::forward<Args>(args)...);
+      return iterator(
+          rb.emplaceHint(*hint.rb_it, false, key, std::move(key)).first);
+    }
   }
 
+  // Every argument is inserted, the bool is always true
   template <typename... Args>
   vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
     vector<std::pair<iterator, bool>> vec;
-    for (const auto &arg : {args...})
-      vec.push_back({insert(arg), rb.searchTree(arg) == rb.getNullNode()});
+    (vec.push_back({insert(std::forward<Args>(args)), true}), ...);
     return vec;
   }
 
-  void erase(iterator &pos) { rb.deleteNode(*pos); }
-  void erase(iterator pos) { rb.deleteNode(*pos); }
+  void erase(iterator pos) {
+    if constexpr (counted) {
+      auto node = *pos.rb_it;
+      if (node->value > 1) {
+        --node->value;
+      } else {
+        rb.deleteNode(node->key);
+      }
+      --copies_;
+    } else {
+      rb.deleteNode(*pos);
+    }
+  }
 
-  void swap(multiset &other) noexcept { std::swap(rb, other.rb); }
+  void swap(multiset &other) noexcept {
+    rb.swap(other.rb);
+    std::swap(copies_, other.copies_);
+  }
 
   void merge(multiset &other) {
     for (iterator it : other) {
@@ -80,10 +170,14 @@ class multiset {
   iterator find(const_reference key) { return iterator(rb.searchTree(key)); }
 
   bool contains(const_reference key) const noexcept {
-    return rb.searchTree(key) == rb.getNullNode();
+    return rb.searchTree(key) != rb.getNullNode();
   }
 
   size_type count(const Key &key) {
+    if constexpr (counted) {
+      auto node = rb.searchTree(key);
+      return node == rb.getNullNode() ? 0 : (*node)->value;
+    }
     iterator st(lower_bound(key));
     size_type count = 0;
     while (*st == key) {
@@ -94,22 +188,14 @@ class multiset {
   }
 
   std::pair<iterator, iterator> equal_range(const Key &key) {
-    iterator node(rb.searchTree(key));
-    if (node == rb.getNullNode())
-      return std::pair<iterator, iterator>({end(), end()});
-    iterator lhs(node), rhs(node), ll, rr;
-    while (*lhs == key) {
-      ll = lhs;
-      lhs--;
-    }
-    while (*rhs == key) {
-      rr = rhs;
-      rhs++;
-    }
-    return std::pair<iterator, iterator>({ll, rr});
+    return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
   }
 
   iterator lower_bound(const Key &key) {
+    if constexpr (counted) {
+      auto node = rb.searchTree(key);
+      return node == rb.getNullNode() ? end() : iterator(node);
+    }
     iterator it(rb.searchTree(key));
     if (it == rb.getNullNode()) return end();
     iterator lhs(it), ll;
@@ -121,6 +207,10 @@ class multiset {
   }
 
   iterator upper_bound(const Key &key) {
+    if constexpr (counted) {
+      auto node = rb.searchTree(key);
+      return node == rb.getNullNode() ? end() : iterator(++node);
+    }
     iterator it(rb.searchTree(key));
     if (it == rb.getNullNode()) return end();
     iterator lhs(it), ll;
@@ -131,6 +221,76 @@ class multiset {
     return ll;
   }
 
+  // Looks up a batch of keys with interleaved tree walks, writes one
+  // iterator per key (end() for a miss)
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) {
+    rb.searchMany(first, last, [&](auto *node, bool found) {
+      *out++ = found ? iterator(typename tree_type::iterator(node))
+                     : iterator(rb.getNullNode());
+    });
+    return out;
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last,
+                         OutputIt out) const {
+    rb.searchMany(first, last,
+                  [&](const void *, bool found) { *out++ = found; });
+    return out;
+  }
+
+  // Applies a change-set sorted by key in one pass over the tree and writes
+  // one batch_outcome per op. Counted nodes only change their multiplicity,
+  // so there each op is a lookup.
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt apply_batch(ForwardIt first, ForwardIt last, OutputIt outcomes) {
+    if constexpr (counted) {
+      for (; first != last; ++first) {
+        if (first->kind == batch_kind::upsert) {
+          add(first->key);
+          *outcomes++ = batch_outcome::inserted;
+        } else {
+          *outcomes++ = remove_one(first->key) ? batch_outcome::erased
+                                               : batch_outcome::missing;
+        }
+      }
+      return outcomes;
+    } else {
+      return rb.applyBatch(first, last, outcomes, false);
+    }
+  }
+
+  template <typename Ops>
+  vector<batch_outcome> apply_batch(const Ops &sorted_ops) {
+    vector<batch_outcome> outcomes;
+    apply_batch(sorted_ops.begin(), sorted_ops.end(),
+                std::back_inserter(outcomes));
+    return outcomes;
+  }
+
+  // Visits the keys in order as fn(key) straight on the tree nodes, a false
+  // return from fn ends the scan
+  template <typename Fn>
+  void for_each(Fn fn) const {
+    rb.forEach([&](const Key &key, const auto &value) {
+      return visit_copies(fn, key, value);
+    });
+  }
+
+  // Same for the keys in [lo, hi)
+  template <typename Fn>
+  void for_each_in_range(const Key &lo, const Key &hi, Fn fn) const {
+    rb.forEachInRange(lo, hi, [&](const Key &key, const auto &value) {
+      return visit_copies(fn, key, value);
+    });
+  }
+
+  tree_stats stats() const { return rb.stats(); }
+  void reset_stats() noexcept { rb.reset_stats(); }
+  bloom_filter_stats bloom_stats() const { return rb.bloom_stats(); }
+  void reset_bloom_stats() noexcept { rb.reset_bloom_stats(); }
+
   friend bool operator==(const multiset &lhs, const multiset &rhs) noexcept {
     return lhs.rb == rhs.rb;
   }
@@ -140,26 +300,77 @@ class multiset {
   }
 
  private:
-  RedBlackTree<Key, Key, Allocator> rb;
+  // One more copy of key, returns the node holding it
+  template <typename K>
+  typename tree_type::iterator add(K &&key) {
+    if constexpr (counted) {
+      auto node = rb.tryEmplace(std::forward<K>(key), size_type(0)).first;
+      ++(*node)->value;
+      ++copies_;
+      return node;
+    } else {
+      return rb.emplace(key, std::forward<K>(key));
+    }
+  }
+
+  // The copy just added, the last one of its key in counted mode
+  static iterator placed(typename tree_type::iterator node) {
+    if constexpr (counted) return iterator(node, (*node)->value - 1);
+    return iterator(node);
+  }
+
+  bool remove_one(const Key &key) {
+    auto node = rb.searchTree(key);
+    if (node == rb.getNullNode()) return false;
+    erase(iterator(node));
+    return true;
+  }
+
+  // fn(key) once per copy, false once fn asks to stop
+  template <typename Fn, typename Value>
+  static bool visit_copies(Fn &fn, const Key &key, const Value &value) {
+    size_type copies = 1;
+    if constexpr (counted) copies = value;
+    for (size_type i = 0; i < copies; ++i) {
+      if constexpr (std::is_void<decltype(fn(key))>::value) {
+        fn(key);
+      } else if (!fn(key)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  tree_type rb;
+  // total number of copies, only kept in counted mode
+  size_type copies_ = 0;
 };
 
-template <typename Key, typename Compare, typename Allocator>
-class multiset<Key, Compare, Allocator>::MultisetIterator {
+template <typename Key, typename Compare, typename Allocator, typename Traits>
+class multiset<Key, Compare, Allocator, Traits>::MultisetIterator
+    : private multiset_copy_index<Traits::count_duplicates> {
+  using copy_index = multiset_copy_index<Traits::count_duplicates>;
+
  public:
   MultisetIterator() noexcept {}
 
-  MultisetIterator(const MultisetIterator &it) noexcept : rb_it(it.rb_it) {}
+  MultisetIterator(const MultisetIterator &it) noexcept
+      : copy_index(it), rb_it(it.rb_it) {}
   MultisetIterator(MultisetIterator &&it) noexcept
-      : rb_it(std::move(it.rb_it)) {}
+      : copy_index(it), rb_it(std::move(it.rb_it)) {}
 
-  MultisetIterator(const typename RedBlackTree<Key>::iterator &it) noexcept
+  MultisetIterator(const typename tree_type::iterator &it) noexcept
       : rb_it(it) {}
-  MultisetIterator(typename RedBlackTree<Key>::iterator &&it) noexcept
+  MultisetIterator(typename tree_type::iterator &&it) noexcept
       : rb_it(std::move(it)) {}
+  MultisetIterator(const typename tree_type::iterator &it,
+                  size_type copy) noexcept
+      : copy_index(copy), rb_it(it) {}
   ~MultisetIterator() {}
 
   MultisetIterator &operator=(const MultisetIterator &other) {
     if (&other != this) {
+      copy_index::operator=(other);
       rb_it = other.rb_it;
     }
     return *this;
@@ -167,22 +378,37 @@ class multiset<Key, Compare, Allocator>::MultisetIterator {
 
   friend bool operator==(const MultisetIterator &lhs,
                          const MultisetIterator &rhs) noexcept {
-    return lhs.rb_it == rhs.rb_it;
+    return lhs.rb_it == rhs.rb_it && lhs.copy() == rhs.copy();
   }
 
   friend bool operator!=(const MultisetIterator &lhs,
                          const MultisetIterator &rhs) noexcept {
-    return lhs.rb_it != rhs.rb_it;
+    return !(lhs == rhs);
   }
 
-  reference operator*() noexcept { return (*rb_it)->value; }
+  reference operator*() noexcept { return (*rb_it)->key; }
 
+  // counted nodes are stepped through once per copy
   MultisetIterator &operator++() noexcept {
+    if constexpr (counted) {
+      if (++this->copy_ < (*rb_it)->value) return *this;
+      this->copy_ = 0;
+    }
     rb_it++;
     return *this;
   }
   MultisetIterator &operator--() noexcept {
+    if constexpr (counted) {
+      if (this->copy_) {
+        --this->copy_;
+        return *this;
+      }
+    }
     rb_it--;
+    if constexpr (counted) {
+      auto node = *rb_it;
+      this->copy_ = node && node->value ? node->value - 1 : 0;
+    }
     return *this;
   }
 
@@ -213,29 +439,39 @@ class multiset<Key, Compare, Allocator>::MultisetIterator {
   }
 
  private:
-  typename RedBlackTree<Key>::iterator rb_it;
+  friend class multiset;
+  friend class MultisetConstIterator;
+
+  typename tree_type::iterator rb_it;
 };
 
-template <typename Key, typename Compare, typename Allocator>
-class multiset<Key, Compare, Allocator>::MultisetConstIterator {
+template <typename Key, typename Compare, typename Allocator, typename Traits>
+class multiset<Key, Compare, Allocator, Traits>::MultisetConstIterator
+    : private multiset_copy_index<Traits::count_duplicates> {
+  using copy_index = multiset_copy_index<Traits::count_duplicates>;
+
  public:
   MultisetConstIterator() noexcept {}
 
   MultisetConstIterator(const MultisetConstIterator &it) noexcept
-      : rb_it(it.rb_it) {}
+      : copy_index(it), rb_it(it.rb_it) {}
   MultisetConstIterator(MultisetConstIterator &&it) noexcept
-      : rb_it(std::move(it.rb_it)) {}
+      : copy_index(it), rb_it(std::move(it.rb_it)) {}
 
-  MultisetConstIterator(
-      const typename RedBlackTree<Key>::const_iterator &it) noexcept
+  MultisetConstIterator(const MultisetIterator &it) noexcept
+      : copy_index(it), rb_it(*it.rb_it) {}
+  MultisetConstIterator(const typename tree_type::const_iterator &it) noexcept
       : rb_it(it) {}
-  MultisetConstIterator(
-      typename RedBlackTree<Key>::const_iterator &&it) noexcept
+  MultisetConstIterator(typename tree_type::const_iterator &&it) noexcept
       : rb_it(std::move(it)) {}
+  MultisetConstIterator(const typename tree_type::const_iterator &it,
+                       size_type copy) noexcept
+      : copy_index(copy), rb_it(it) {}
   ~MultisetConstIterator() {}
 
   MultisetConstIterator &operator=(const MultisetConstIterator &other) {
     if (&other != this) {
+      copy_index::operator=(other);
       rb_it = other.rb_it;
     }
     return *this;
@@ -243,22 +479,37 @@ class multiset<Key, Compare, Allocator>::MultisetConstIterator {
 
   friend bool operator==(const MultisetConstIterator &lhs,
                          const MultisetConstIterator &rhs) noexcept {
-    return lhs.rb_it == rhs.rb_it;
+    return lhs.rb_it == rhs.rb_it && lhs.copy() == rhs.copy();
   }
 
   friend bool operator!=(const MultisetConstIterator &lhs,
                          const MultisetConstIterator &rhs) noexcept {
-    return lhs.rb_it != rhs.rb_it;
+    return !(lhs == rhs);
   }
 
-  reference operator*() noexcept { return (*rb_it)->value; }
+  reference operator*() noexcept { return (*rb_it)->key; }
 
+  // counted nodes are stepped through once per copy
   MultisetConstIterator &operator++() noexcept {
+    if constexpr (counted) {
+      if (++this->copy_ < (*rb_it)->value) return *this;
+      this->copy_ = 0;
+    }
     rb_it++;
     return *this;
   }
   MultisetConstIterator &operator--() noexcept {
+    if constexpr (counted) {
+      if (this->copy_) {
+        --this->copy_;
+        return *this;
+      }
+    }
     rb_it--;
+    if constexpr (counted) {
+      auto node = *rb_it;
+      this->copy_ = node && node->value ? node->value - 1 : 0;
+    }
     return *this;
   }
 
@@ -290,8 +541,16 @@ class multiset<Key, Compare, Allocator>::MultisetConstIterator {
   }
 
  private:
-  typename RedBlackTree<Key>::const_iterator rb_it;
+  friend class multiset;
+
+  typename tree_type::const_iterator rb_it;
 };
 
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using multiset =
+    s21::multiset<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+
 }  // namespace s21
 #endif
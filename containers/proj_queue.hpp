@@ -2,6 +2,9 @@
 #define S21_QUEUE_HPP
 
 #include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 #include "proj_list.hpp"
 
@@ -34,7 +37,13 @@ class queue {
     throw;
   }
 
-  queue(queue &&q) try : container_(q.container_) {
+  queue(queue &&q) : container_(std::move(q.container_)) {}
+
+  // Forwards the allocator to the underlying container
+  template <typename Alloc,
+            typename = std::enable_if_t<
+                std::uses_allocator<container_type, Alloc>::value>>
+  explicit queue(const Alloc &alloc) try : container_(alloc) {
   } catch (std::bad_alloc &t) {
     std::cerr << t.what() << std::endl;
     throw;
@@ -42,8 +51,13 @@ class queue {
 
   ~queue() {}
 
+  queue &operator=(const queue &q) {
+    container_ = q.container_;
+    return *this;
+  }
+
   queue &operator=(queue &&q) {
-    if (q != *this) swap(q);
+    container_ = std::move(q.container_);
     return *this;
   }
 
@@ -64,12 +78,19 @@ class queue {
     }
   }
 
+  void push(value_type &&value) { container_.push_back(std::move(value)); }
+
+  template <class... Args>
+  decltype(auto) emplace(Args &&...args) {
+    return container_.emplace_back(std::forward<Args>(args)...);
+  }
+
   void pop() { container_.pop_front(); }
   void swap(queue &other) noexcept { container_.swap(other.container_); }
 
   template <class... Args>
   void insert_many_back(Args &&...args) {
-    for (const auto &arg : {args...}) container_.push_back(arg);
+    (container_.emplace_back(std::forward<Args>(args)), ...);
   }
 
   /*** NON-MEMBER ***/
@@ -81,6 +102,11 @@ class queue {
   container_type container_;
 };
 
+namespace pmr {
+template <typename T>
+using queue = s21::queue<T, s21::pmr::list<T>>;
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif
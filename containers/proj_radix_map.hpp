@@ -0,0 +1,78 @@
+#ifndef S21_RADIX_MAP_HPP
+#define S21_RADIX_MAP_HPP
+
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+
+#include "../utilities/art_tree.hpp"
+
+namespace s21 {
+
+// Ordered map over an adaptive radix tree: lookups cost O(key length)
+// instead of O(log n) key comparisons. Keys are strings or integers, see
+// s21::radix_key. Iterators are forward only.
+template <typename Key, typename T,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class radix_map : public art_tree<Key, T, Allocator> {
+  using base = art_tree<Key, T, Allocator>;
+
+ public:
+  using mapped_type = T;
+  using typename base::allocator_type;
+  using typename base::const_iterator;
+  using typename base::iterator;
+  using typename base::value_type;
+
+  using base::base;
+
+  radix_map(std::initializer_list<value_type> const &items,
+            const allocator_type &alloc = allocator_type())
+      : base(alloc) {
+    for (const value_type &item : items) insert(item);
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return insert(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return this->emplace_with(key,
+                              [&] { return this->make_leaf(key, obj); });
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    auto placed = insert(key, obj);
+    if (!placed.second) placed.first->second = obj;
+    return placed;
+  }
+
+  T &operator[](const Key &key) {
+    return this->emplace_with(key, [&] { return this->make_leaf(key, T()); })
+        .first->second;
+  }
+
+  T &at(const Key &key) {
+    iterator it = this->find(key);
+    if (it == this->end()) throw std::out_of_range("Key not found in the map");
+    return it->second;
+  }
+
+  const T &at(const Key &key) const {
+    const_iterator it = this->find(key);
+    if (it == this->end()) throw std::out_of_range("Key not found in the map");
+    return it->second;
+  }
+};
+
+namespace pmr {
+template <typename Key, typename T>
+using radix_map =
+    s21::radix_map<Key, T,
+                   std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef S21_RADIX_SET_HPP
+#define S21_RADIX_SET_HPP
+
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+
+#include "../utilities/art_tree.hpp"
+
+namespace s21 {
+
+// Ordered set over an adaptive radix tree, see radix_map
+template <typename Key, typename Allocator = std::allocator<Key>>
+class radix_set : public art_tree<Key, void, Allocator> {
+  using base = art_tree<Key, void, Allocator>;
+
+ public:
+  using typename base::allocator_type;
+  using typename base::iterator;
+
+  using base::base;
+
+  radix_set(std::initializer_list<Key> const &items,
+            const allocator_type &alloc = allocator_type())
+      : base(alloc) {
+    for (const Key &item : items) insert(item);
+  }
+
+  std::pair<iterator, bool> insert(const Key &key) {
+    return this->emplace_with(key, [&] { return this->make_leaf(key); });
+  }
+};
+
+namespace pmr {
+template <typename Key>
+using radix_set = s21::radix_set<Key, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+
+}  // namespace s21
+
+#endif
@@ -2,6 +2,8 @@
 #define S21_SET_H
 
 #include <initializer_list>
+#include <memory_resource>
+#include <utility>
 
 #include "../utilities/rb_tree.hpp"
 #include "proj_vector.hpp"
@@ -9,7 +11,8 @@
 namespace s21 {
 
 template <typename Key, typename Compare = std::less<Key>,
-          typename Allocator = std::allocator<Key>>
+          typename Allocator = std::allocator<Key>,
+          typename Traits = tree_traits>
 class set {
   class SetIterator;
   class SetConstIterator;
@@ -21,29 +24,45 @@ class set {
   using const_reference = const value_type &;
   using size_type = std::size_t;
   using allocator = Allocator;
+  using allocator_type = Allocator;
+  using tree_type = RedBlackTree<Key, Key, Allocator, Traits>;
+  using batch_op = s21::batch_op<Key>;
   using iterator = SetIterator;
   using const_iterator = SetConstIterator;
 
   set() : rb() {}
+  explicit set(const allocator_type &alloc) : rb(alloc) {}
 
-  set(std::initializer_list<Key> const &items) {
-    for (const auto item : items) rb.insert(item, item);
+  set(std::initializer_list<Key> const &items,
+      const allocator_type &alloc = allocator_type())
+      : rb(alloc) {
+    for (const auto &item : items) rb.tryEmplace(item, item);
   }
 
   set(const set &s) : rb(s.rb) {}
-  set(set &&s) { rb = std::move(s.rb); }
+  set(const set &s, const allocator_type &alloc) : rb(s.rb, alloc) {}
+  set(set &&s) noexcept : rb(std::move(s.rb)) {}
+  set(set &&s, const allocator_type &alloc) : rb(std::move(s.rb), alloc) {}
 
   ~set() {}
 
-  set &operator=(set s) {
-    std::swap(rb, s.rb);
+  set &operator=(const set &s) {
+    rb = s.rb;
     return *this;
   }
 
+  set &operator=(set &&s) noexcept(
+      std::is_nothrow_move_assignable<tree_type>::value) {
+    rb = std::move(s.rb);
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept { return rb.get_allocator(); }
+
   iterator begin() { return SetIterator(rb.begin()); }
   iterator end() { return SetIterator(rb.end()); }
-  const_iterator begin() const { return SetIterator(rb.begin()); }
-  const_iterator end() const { return SetIterator(rb.end()); }
+  const_iterator begin() const { return SetConstIterator(rb.begin()); }
+  const_iterator end() const { return SetConstIterator(rb.end()); }
 
   constexpr inline bool empty() const noexcept { return rb.empty(); }
   constexpr inline size_type size() const noexcept { return rb.size(); }
@@ -52,39 +71,38 @@ class set {
   void clear() noexcept { rb.clear(); }
 
   std::pair<iterator, bool> insert(const_reference value) {
-    iterator place(rb.searchTree(value));
-    bool placed = false;
-    if (place == rb.getNullNode()) {
-      placed = true;
-      rb.insert(value, value);
-      place = iterator(rb.searchTree(value));
-    }
-    return std::pair<iterator, bool>(place, placed);
+    return placed(rb.tryEmplace(value, value));
   }
 
+  // The node keeps the key twice, one copy is moved from value
   std::pair<iterator, bool> insert(value_type &&value) {
-    iterator place(rb.searchTree(std::move(value)));
-    bool placed = false;
-    if (place == rb.getNullNode()) {
-      placed = true;
-      rb.insert(std::move(value), std::move(value));
-      place = iterator(rb.searchTree(std::move(value)));
-    }
-    return std::pair<iterator, bool>(place, placed);
+    return placed(rb.tryEmplace(value, std::move(value)));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    value_type key(std::forward<Args>(args)...);
+    return placed(rb.tryEmplace(key, std::move(key)));
+  }
+
+  // A hint right after where the key belongs saves the walk from the root
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    value_type key(std::forward<Args>(args)...);
+    return iterator(rb.emplaceHint(*hint.rb_it, true, key, std::move(key))
+                        .first);
   }
 
   template <typename... Args>
   vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
     vector<std::pair<iterator, bool>> vec;
-    for (const auto &arg : {args...})
-      vec.push_back({insert(arg), rb.searchTree(arg) == rb.getNullNode()});
+    (vec.push_back(insert(std::forward<Args>(args))), ...);
     return vec;
   }
 
   void erase(iterator pos) { rb.deleteNode(*pos); }
-  void erase(iterator &pos) { rb.deleteNode(*pos); }
 
-  void swap(set &other) noexcept { std::swap(rb, other.rb); }
+  void swap(set &other) noexcept { rb.swap(other.rb); }
 
   void merge(set &other) {
     for (iterator it : other) {
@@ -92,14 +110,68 @@ class set {
     }
   }
 
-  iterator find(const_reference key) const {
-    return iterator(rb.searchTree(key));
+  iterator find(const_reference key) { return iterator(rb.searchTree(key)); }
+  const_iterator find(const_reference key) const {
+    return const_iterator(rb.searchTree(key));
   }
 
   bool contains(const_reference key) const noexcept {
-    return rb.searchTree(key) == rb.getNullNode();
+    return rb.searchTree(key) != rb.getNullNode();
+  }
+
+  // Looks up a batch of keys with interleaved tree walks, writes one
+  // iterator per key (end() for a miss)
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) {
+    rb.searchMany(first, last, [&](auto *node, bool found) {
+      *out++ = found ? iterator(typename tree_type::iterator(node))
+                     : iterator(rb.getNullNode());
+    });
+    return out;
+  }
+
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last,
+                         OutputIt out) const {
+    rb.searchMany(first, last,
+                  [&](const void *, bool found) { *out++ = found; });
+    return out;
   }
 
+  // Applies a change-set sorted by key in one pass over the tree and writes
+  // one batch_outcome per op
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt apply_batch(ForwardIt first, ForwardIt last, OutputIt outcomes) {
+    return rb.applyBatch(first, last, outcomes, true);
+  }
+
+  template <typename Ops>
+  vector<batch_outcome> apply_batch(const Ops &sorted_ops) {
+    vector<batch_outcome> outcomes;
+    apply_batch(sorted_ops.begin(), sorted_ops.end(),
+                std::back_inserter(outcomes));
+    return outcomes;
+  }
+
+  // Visits the keys in order as fn(key) straight on the tree nodes, a false
+  // return from fn ends the scan
+  template <typename Fn>
+  void for_each(Fn fn) const {
+    rb.forEach([&](const Key &key, const Key &) { return fn(key); });
+  }
+
+  // Same for the keys in [lo, hi)
+  template <typename Fn>
+  void for_each_in_range(const Key &lo, const Key &hi, Fn fn) const {
+    rb.forEachInRange(lo, hi,
+                      [&](const Key &key, const Key &) { return fn(key); });
+  }
+
+  tree_stats stats() const { return rb.stats(); }
+  void reset_stats() noexcept { rb.reset_stats(); }
+  bloom_filter_stats bloom_stats() const { return rb.bloom_stats(); }
+  void reset_bloom_stats() noexcept { rb.reset_bloom_stats(); }
+
   friend bool operator==(const set &lhs, const set &rhs) noexcept {
     return lhs.rb == rhs.rb;
   }
@@ -109,20 +181,24 @@ class set {
   }
 
  private:
-  RedBlackTree<Key, Key, Allocator> rb;
+  static std::pair<iterator, bool> placed(
+      std::pair<typename tree_type::iterator, bool> place) {
+    return {iterator(place.first), place.second};
+  }
+
+  tree_type rb;
 };
 
-template <typename Key, typename Compare, typename Allocator>
-class set<Key, Compare, Allocator>::SetIterator {
+template <typename Key, typename Compare, typename Allocator, typename Traits>
+class set<Key, Compare, Allocator, Traits>::SetIterator {
  public:
   SetIterator() noexcept {}
 
   SetIterator(const SetIterator &it) noexcept : rb_it(it.rb_it) {}
   SetIterator(SetIterator &&it) noexcept : rb_it(std::move(it.rb_it)) {}
 
-  SetIterator(const typename RedBlackTree<Key>::iterator &it) noexcept
-      : rb_it(it) {}
-  SetIterator(typename RedBlackTree<Key>::iterator &&it) noexcept
+  SetIterator(const typename tree_type::iterator &it) noexcept : rb_it(it) {}
+  SetIterator(typename tree_type::iterator &&it) noexcept
       : rb_it(std::move(it)) {}
   ~SetIterator() {}
 
@@ -181,11 +257,14 @@ class set<Key, Compare, Allocator>::SetIterator {
   }
 
  private:
-  typename RedBlackTree<Key>::iterator rb_it;
+  friend class set;
+  friend class SetConstIterator;
+
+  typename tree_type::iterator rb_it;
 };
 
-template <typename Key, typename Compare, typename Allocator>
-class set<Key, Compare, Allocator>::SetConstIterator {
+template <typename Key, typename Compare, typename Allocator, typename Traits>
+class set<Key, Compare, Allocator, Traits>::SetConstIterator {
  public:
   SetConstIterator() noexcept {}
 
@@ -193,10 +272,10 @@ class set<Key, Compare, Allocator>::SetConstIterator {
   SetConstIterator(SetConstIterator &&it) noexcept
       : rb_it(std::move(it.rb_it)) {}
 
-  SetConstIterator(
-      const typename RedBlackTree<Key>::const_iterator &it) noexcept
+  SetConstIterator(const SetIterator &it) noexcept : rb_it(*it.rb_it) {}
+  SetConstIterator(const typename tree_type::const_iterator &it) noexcept
       : rb_it(it) {}
-  SetConstIterator(typename RedBlackTree<Key>::const_iterator &&it) noexcept
+  SetConstIterator(typename tree_type::const_iterator &&it) noexcept
       : rb_it(std::move(it)) {}
   ~SetConstIterator() {}
 
@@ -217,7 +296,7 @@ class set<Key, Compare, Allocator>::SetConstIterator {
     return lhs.rb_it != rhs.rb_it;
   }
 
-  reference operator*() noexcept { return (*rb_it)->value; }
+  const_reference operator*() noexcept { return (*rb_it)->value; }
 
   SetConstIterator &operator++() noexcept {
     rb_it++;
@@ -255,8 +334,15 @@ class set<Key, Compare, Allocator>::SetConstIterator {
   }
 
  private:
-  typename RedBlackTree<Key>::const_iterator rb_it;
+  friend class set;
+
+  typename tree_type::const_iterator rb_it;
 };
 
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using set = s21::set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+
 }  // namespace s21
 #endif
@@ -0,0 +1,890 @@
+#ifndef S21_SMALL_VECTOR_H
+#define S21_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "../utilities/relocate.hpp"
+#include "../utilities/simd.hpp"
+
+namespace s21 {
+
+// s21::vector with room for N elements inside the object itself. Nothing is
+// allocated until the size passes N; from then on the elements live on the
+// heap as in a vector, and shrink_to_fit() brings them back inline once they
+// fit again. Moving a small_vector that is still inline moves its elements
+// (memcpy for trivially relocatable types) instead of stealing a pointer.
+template <class T, std::size_t N, class Allocator = std::allocator<T>>
+class small_vector {
+  static_assert(N > 0, "s21::small_vector needs inline storage");
+
+ public:
+  using value_type = T;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = T*;
+  using const_iterator = const T*;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  static constexpr size_type inline_capacity = N;
+
+  small_vector() noexcept(noexcept(Allocator())) : small_vector(Allocator()) {}
+  explicit small_vector(const Allocator& alloc) noexcept;
+  explicit small_vector(size_type size, const Allocator& alloc = Allocator());
+  small_vector(small_vector&& v) noexcept(nothrow_relocatable);
+  small_vector(small_vector&& v, const Allocator& alloc);
+  small_vector(const small_vector& v);
+  small_vector(const small_vector& v, const Allocator& alloc);
+  small_vector(std::initializer_list<value_type> items,
+               const Allocator& alloc = Allocator());
+  ~small_vector();
+
+  inline size_type size() const noexcept { return _size; }
+  inline size_type max_size() const {
+    return alloc_traits::max_size(_allocator);
+  }
+  void reserve(size_type size);
+  inline size_type capacity() const noexcept { return _capacity; }
+  inline bool empty() const noexcept { return _size == 0; }
+  // Whether the elements are in the inline buffer
+  inline bool is_inline() const noexcept { return _data == inline_data(); }
+  void clear() noexcept { destroy_from(0); }
+  // New elements are value-initialized, or copies of value
+  void resize(size_type size);
+  void resize(size_type size, const_reference value);
+  // New elements are default-initialized: trivial types keep whatever bytes
+  // the storage holds, for a caller that is about to overwrite them
+  void resize_for_overwrite(size_type size);
+  // Adds count default-initialized elements and returns the first of them,
+  // e.g. for read() or recv() to fill
+  T* append_uninitialized(size_type count) {
+    size_type old_size = _size;
+    resize_for_overwrite(_size + count);
+    return _data + old_size;
+  }
+  allocator_type get_allocator() const noexcept { return _allocator; }
+
+  inline reference back();
+  inline const_reference back() const;
+
+  inline reference front();
+  inline const_reference front() const;
+
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+  template <typename... Args>
+  reference emplace_back(Args&&... args);
+  void pop_back();
+  void swap(small_vector& other) noexcept(nothrow_swappable);
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, T&& value) {
+    return emplace(pos, std::move(value));
+  }
+  iterator insert(const_iterator pos, size_type count, const_reference value);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  iterator insert(const_iterator pos, InputIt first, InputIt last);
+  iterator insert(const_iterator pos, std::initializer_list<T> items) {
+    return insert(pos, items.begin(), items.end());
+  }
+  void erase(iterator pos);
+
+  inline iterator begin() noexcept { return _data; }
+  inline iterator end() noexcept { return _data + _size; }
+  inline const_iterator begin() const noexcept { return _data; }
+  inline const_iterator end() const noexcept { return _data + _size; }
+  inline T* data() noexcept { return _data; }
+  inline const T* data() const noexcept { return _data; }
+
+  void shrink_to_fit();
+
+  const_reference operator[](size_type i) const;
+  reference operator[](size_type i);
+  small_vector& operator=(small_vector&& v) noexcept(
+      nothrow_relocatable &&
+      (alloc_traits::propagate_on_container_move_assignment::value ||
+       alloc_traits::is_always_equal::value));
+  small_vector& operator=(const small_vector& v);
+  small_vector& operator=(std::initializer_list<value_type> ilist);
+
+  template <typename... Args>
+  iterator insert_many(const_iterator pos, Args&&... args);
+
+  template <typename... Args>
+  void insert_many_back(Args&&... args) {
+    insert_many(end(), std::forward<Args>(args)...);
+  }
+
+  // Linear scans, vectorized for arithmetic types (utilities/simd.hpp)
+  iterator find(const_reference value) {
+    return _data + simd::find(_data, _size, value);
+  }
+  const_iterator find(const_reference value) const {
+    return _data + simd::find(_data, _size, value);
+  }
+  size_type count(const_reference value) const {
+    return simd::count(_data, _size, value);
+  }
+  bool contains(const_reference value) const {
+    return simd::find(_data, _size, value) != _size;
+  }
+  void fill(const_reference value) { simd::fill(_data, _size, value); }
+  // Smallest and largest element, and the sum of arithmetic elements
+  value_type min() const;
+  value_type max() const;
+  simd::sum_type<T> sum() const { return simd::sum(_data, _size); }
+
+  friend bool operator==(const small_vector& lhs, const small_vector& rhs) {
+    return lhs.size() == rhs.size() &&
+           simd::equal(lhs.data(), rhs.data(), lhs.size());
+  }
+
+  friend bool operator!=(const small_vector& lhs, const small_vector& rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator<(const small_vector& lhs, const small_vector& rhs) {
+    return simd::compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0;
+  }
+
+  friend bool operator>(const small_vector& lhs, const small_vector& rhs) {
+    return rhs < lhs;
+  }
+
+  friend bool operator<=(const small_vector& lhs, const small_vector& rhs) {
+    return !(rhs < lhs);
+  }
+
+  friend bool operator>=(const small_vector& lhs, const small_vector& rhs) {
+    return !(lhs < rhs);
+  }
+
+ private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  static constexpr bool nothrow_relocatable =
+      relocate_by_memcpy<T, Allocator> ||
+      std::is_nothrow_move_constructible<T>::value;
+  // Swapping with an inline side copies elements to the other allocator's
+  // heap unless the allocators travel with them or are all the same
+  static constexpr bool nothrow_swappable =
+      nothrow_relocatable &&
+      (alloc_traits::propagate_on_container_swap::value ||
+       alloc_traits::is_always_equal::value);
+
+  iterator inline_data() noexcept {
+    return reinterpret_cast<iterator>(_buffer);
+  }
+  const_iterator inline_data() const noexcept {
+    return reinterpret_cast<const_iterator>(_buffer);
+  }
+  size_type grown_capacity() const noexcept { return _capacity * 2; }
+
+  void reallocate(size_type new_capacity);
+  void relocate_to(iterator new_data);
+  void relocate(iterator from, size_type count, iterator to) noexcept;
+  void transfer(iterator from, size_type count, iterator to);
+  void destroy_range(iterator from, size_type count) noexcept;
+  void shift_tail(size_type idx, size_type count) noexcept;
+  void unshift_tail(size_type idx, size_type count) noexcept;
+  template <typename Fill>
+  iterator insert_with(size_type idx, size_type count, Fill fill);
+  bool in_tail(const void* p, size_type idx) const noexcept;
+  template <typename Init>
+  void resize_with(size_type size, Init init);
+  void adopt(iterator new_data, size_type new_capacity) noexcept;
+  template <typename... Args>
+  void grow_append(Args&&... args);
+  void destroy_from(size_type idx) noexcept;
+  void release() noexcept;
+  void take(small_vector& v);
+  void take_heap(small_vector& v) noexcept;
+  void steal(small_vector& v) noexcept(nothrow_relocatable);
+  void take_elements(small_vector& v);
+  template <typename InputIt>
+  void construct_from(InputIt first, size_type count);
+
+  Allocator _allocator;
+  iterator _data;
+  size_type _size;
+  size_type _capacity;
+  alignas(T) unsigned char _buffer[N * sizeof(T)];
+};
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::small_vector(const Allocator& alloc) noexcept
+    : _allocator(alloc), _data(inline_data()), _size(0), _capacity(N) {}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::small_vector(size_type size,
+                                            const Allocator& alloc)
+    : small_vector(alloc) {
+  try {
+    reserve(size);
+    resize(size);
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::~small_vector() {
+  release();
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::reserve(size_type size) {
+  if (size > max_size()) throw "Cant allocate memory";
+  if (size > _capacity) reallocate(size);
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::resize(size_type size) {
+  if constexpr (relocate_by_memcpy<T, Allocator> &&
+                std::is_trivially_default_constructible<T>::value) {
+    // value-initialized trivial elements are all zero bytes
+    size_type old_size = _size;
+    resize_for_overwrite(size);
+    if (_size > old_size)
+      std::memset(static_cast<void*>(_data + old_size), 0,
+                  (_size - old_size) * sizeof(T));
+    return;
+  }
+  resize_with(size, [&](iterator slot) {
+    alloc_traits::construct(_allocator, slot);
+  });
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::resize(size_type size,
+                                           const_reference value) {
+  if (size > _capacity && in_tail(std::addressof(value), 0)) {
+    value_type copy(value);
+    return resize(size, copy);
+  }
+  resize_with(size, [&](iterator slot) {
+    alloc_traits::construct(_allocator, slot, value);
+  });
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::resize_for_overwrite(size_type size) {
+  resize_with(size, [&](iterator slot) {
+    if constexpr (!std::is_trivially_default_constructible<T>::value)
+      alloc_traits::construct(_allocator, slot);
+    else
+      static_cast<void>(slot);
+  });
+}
+
+// Ends the elements past size, or grows to size with init(slot) building
+// each new element; a throw leaves the elements as they were
+template <class T, std::size_t N, class Allocator>
+template <typename Init>
+void small_vector<T, N, Allocator>::resize_with(size_type size, Init init) {
+  if (size <= _size) {
+    destroy_from(size);
+    return;
+  }
+  if (size > max_size()) throw "Cant allocate memory";
+  if (size > _capacity) reallocate(std::max(grown_capacity(), size));
+  size_type built = _size;
+  try {
+    for (; built < size; built++) init(_data + built);
+  } catch (...) {
+    destroy_range(_data + _size, built - _size);
+    throw;
+  }
+  _size = size;
+}
+
+// Moves the elements into a fresh heap block of new_capacity slots
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::reallocate(size_type new_capacity) {
+  iterator new_data = alloc_traits::allocate(_allocator, new_capacity);
+  try {
+    relocate_to(new_data);
+  } catch (...) {
+    alloc_traits::deallocate(_allocator, new_data, new_capacity);
+    throw;
+  }
+  adopt(new_data, new_capacity);
+}
+
+// Same as in s21::vector: one memcpy for trivially relocatable types, nothrow
+// moves for the rest, and copies kept until they are all made otherwise
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::relocate_to(iterator new_data) {
+  if constexpr (nothrow_relocatable) {
+    relocate(_data, _size, new_data);
+  } else {
+    transfer(_data, _size, new_data);
+    destroy_range(_data, _size);
+  }
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::relocate(iterator from, size_type count,
+                                             iterator to) noexcept {
+  static_assert(nothrow_relocatable);
+  if constexpr (relocate_by_memcpy<T, Allocator>) {
+    if (count)
+      std::memcpy(static_cast<void*>(to), static_cast<void*>(from),
+                  count * sizeof(T));
+  } else {
+    for (size_type i = 0; i < count; i++) {
+      alloc_traits::construct(_allocator, to + i, std::move(from[i]));
+      alloc_traits::destroy(_allocator, from + i);
+    }
+  }
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::transfer(iterator from, size_type count,
+                                             iterator to) {
+  size_type built = 0;
+  try {
+    for (; built < count; built++)
+      alloc_traits::construct(_allocator, to + built,
+                              std::move_if_noexcept(from[built]));
+  } catch (...) {
+    destroy_range(to, built);
+    throw;
+  }
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::destroy_range(iterator from,
+                                                  size_type count) noexcept {
+  for (size_type i = 0; i < count; i++)
+    alloc_traits::destroy(_allocator, from + i);
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::shift_tail(size_type idx,
+                                               size_type count) noexcept {
+  if constexpr (relocate_by_memcpy<T, Allocator>) {
+    std::memmove(static_cast<void*>(_data + idx + count),
+                 static_cast<void*>(_data + idx), (_size - idx) * sizeof(T));
+  } else {
+    for (size_type i = _size; i-- > idx;) {
+      alloc_traits::construct(_allocator, _data + i + count,
+                              std::move(_data[i]));
+      alloc_traits::destroy(_allocator, _data + i);
+    }
+  }
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::unshift_tail(size_type idx,
+                                                 size_type count) noexcept {
+  if constexpr (relocate_by_memcpy<T, Allocator>) {
+    std::memmove(static_cast<void*>(_data + idx),
+                 static_cast<void*>(_data + idx + count),
+                 (_size - idx) * sizeof(T));
+  } else {
+    for (size_type i = idx; i < _size; i++) {
+      alloc_traits::construct(_allocator, _data + i,
+                              std::move(_data[i + count]));
+      alloc_traits::destroy(_allocator, _data + i + count);
+    }
+  }
+}
+
+// See s21::vector::insert_with. Types whose moves may throw always take the
+// fresh block, which for them means the heap even below N elements.
+template <class T, std::size_t N, class Allocator>
+template <typename Fill>
+T* small_vector<T, N, Allocator>::insert_with(size_type idx, size_type count,
+                                              Fill fill) {
+  if (count == 0) return _data + idx;
+  size_type built = 0;
+  if (_size + count <= _capacity && nothrow_relocatable) {
+    shift_tail(idx, count);
+    try {
+      fill(_data + idx, built);
+    } catch (...) {
+      destroy_range(_data + idx, built);
+      unshift_tail(idx, count);
+      throw;
+    }
+    _size += count;
+    return _data + idx;
+  }
+
+  size_type new_capacity = grown_capacity();
+  if (new_capacity < _size + count) new_capacity = _size + count;
+  iterator new_data = alloc_traits::allocate(_allocator, new_capacity);
+  try {
+    fill(new_data + idx, built);
+  } catch (...) {
+    destroy_range(new_data + idx, built);
+    alloc_traits::deallocate(_allocator, new_data, new_capacity);
+    throw;
+  }
+  if constexpr (nothrow_relocatable) {
+    relocate(_data, idx, new_data);
+    relocate(_data + idx, _size - idx, new_data + idx + count);
+  } else {
+    try {
+      transfer(_data, idx, new_data);
+      try {
+        transfer(_data + idx, _size - idx, new_data + idx + count);
+      } catch (...) {
+        destroy_range(new_data, idx);
+        throw;
+      }
+    } catch (...) {
+      destroy_range(new_data + idx, count);
+      alloc_traits::deallocate(_allocator, new_data, new_capacity);
+      throw;
+    }
+    destroy_range(_data, _size);
+  }
+  adopt(new_data, new_capacity);
+  _size += count;
+  return _data + idx;
+}
+
+template <class T, std::size_t N, class Allocator>
+bool small_vector<T, N, Allocator>::in_tail(const void* p,
+                                            size_type idx) const noexcept {
+  std::less_equal<const void*> le;
+  std::less<const void*> lt;
+  return le(static_cast<const void*>(_data + idx), p) &&
+         lt(p, static_cast<const void*>(_data + _size));
+}
+
+template <class T, std::size_t N, class Allocator>
+T* small_vector<T, N, Allocator>::insert(const_iterator pos, size_type count,
+                                         const_reference value) {
+  size_type idx = pos - begin();
+  if (idx > _size) throw "incorrect iterator";
+  if (in_tail(std::addressof(value), idx)) {
+    value_type copy(value);
+    return insert(pos, count, copy);
+  }
+  return insert_with(idx, count, [&](iterator slot, size_type& built) {
+    for (; built < count; built++)
+      alloc_traits::construct(_allocator, slot + built, value);
+  });
+}
+
+template <class T, std::size_t N, class Allocator>
+template <typename InputIt, typename>
+T* small_vector<T, N, Allocator>::insert(const_iterator pos, InputIt first,
+                                         InputIt last) {
+  size_type idx = pos - begin();
+  if (idx > _size) throw "incorrect iterator";
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    size_type count = std::distance(first, last);
+    if constexpr (std::is_pointer<InputIt>::value) {
+      std::less<const void*> lt;
+      if (nothrow_relocatable && _size + count <= _capacity &&
+          lt(first, _data + _size) && lt(_data + idx, last)) {
+        // the range overlaps the part that moves, copy it aside first
+        small_vector aside(_allocator);
+        aside.reserve(count);
+        aside.insert(aside.end(), first, last);
+        return insert(pos, std::make_move_iterator(aside.begin()),
+                      std::make_move_iterator(aside.end()));
+      }
+    }
+    return insert_with(idx, count, [&](iterator slot, size_type& built) {
+      for (; built < count; built++, ++first)
+        alloc_traits::construct(_allocator, slot + built, *first);
+    });
+  } else {
+    size_type old_size = _size;
+    for (; first != last; ++first) emplace_back(*first);
+    std::rotate(_data + idx, _data + old_size, _data + _size);
+    return _data + idx;
+  }
+}
+
+template <class T, std::size_t N, class Allocator>
+template <typename... Args>
+T* small_vector<T, N, Allocator>::insert_many(const_iterator pos,
+                                              Args&&... args) {
+  constexpr size_type count = sizeof...(Args);
+  size_type idx = pos - begin();
+  if (idx > _size) throw "incorrect iterator";
+  if constexpr (count == 0) {
+    return _data + idx;
+  } else {
+    if (nothrow_relocatable && _size + count <= _capacity &&
+        (in_tail(std::addressof(args), idx) || ...)) {
+      small_vector aside(_allocator);
+      aside.reserve(count);
+      (aside.emplace_back(std::forward<Args>(args)), ...);
+      return insert(pos, std::make_move_iterator(aside.begin()),
+                    std::make_move_iterator(aside.end()));
+    }
+    return insert_with(idx, count, [&](iterator slot, size_type& built) {
+      ((alloc_traits::construct(_allocator, slot + built,
+                                std::forward<Args>(args)),
+        built++),
+       ...);
+    });
+  }
+}
+
+// Swaps in a heap block that already holds the elements
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::adopt(iterator new_data,
+                                          size_type new_capacity) noexcept {
+  if (!is_inline()) alloc_traits::deallocate(_allocator, _data, _capacity);
+  _data = new_data;
+  _capacity = new_capacity;
+}
+
+template <class T, std::size_t N, class Allocator>
+template <typename... Args>
+void small_vector<T, N, Allocator>::grow_append(Args&&... args) {
+  size_type new_capacity = grown_capacity();
+  iterator new_data = alloc_traits::allocate(_allocator, new_capacity);
+  try {
+    alloc_traits::construct(_allocator, new_data + _size,
+                            std::forward<Args>(args)...);
+  } catch (...) {
+    alloc_traits::deallocate(_allocator, new_data, new_capacity);
+    throw;
+  }
+  try {
+    relocate_to(new_data);
+  } catch (...) {
+    alloc_traits::destroy(_allocator, new_data + _size);
+    alloc_traits::deallocate(_allocator, new_data, new_capacity);
+    throw;
+  }
+  adopt(new_data, new_capacity);
+  _size++;
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::destroy_from(size_type idx) noexcept {
+  while (_size > idx) alloc_traits::destroy(_allocator, _data + --_size);
+}
+
+// Ends the elements and goes back to the inline buffer
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::release() noexcept {
+  destroy_from(0);
+  if (!is_inline()) alloc_traits::deallocate(_allocator, _data, _capacity);
+  _data = inline_data();
+  _capacity = N;
+}
+
+// Leaves the elements of v here and v empty; this must be empty and inline.
+// A heap block is adopted when this allocator can free it.
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::take(small_vector& v) {
+  if (!v.is_inline() && _allocator == v._allocator) {
+    take_heap(v);
+  } else {
+    take_elements(v);
+  }
+}
+
+// Takes over the heap block of v, which must have one; this must be empty
+// and inline
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::take_heap(small_vector& v) noexcept {
+  _data = v._data;
+  _size = v._size;
+  _capacity = v._capacity;
+  v._data = v.inline_data();
+  v._size = 0;
+  v._capacity = N;
+}
+
+// Trades allocators with v and takes its elements without allocating; this
+// must be empty and inline
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::steal(small_vector& v) noexcept(
+    nothrow_relocatable) {
+  using std::swap;
+  swap(_allocator, v._allocator);
+  if (v.is_inline()) {
+    take_elements(v);
+  } else {
+    take_heap(v);
+  }
+}
+
+// Moves the elements of v over one by one and leaves v empty; this must be
+// empty and inline
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::take_elements(small_vector& v) {
+  if (v._size > _capacity) {
+    construct_from(std::make_move_iterator(v._data), v._size);
+  } else if constexpr (nothrow_relocatable) {
+    relocate(v._data, v._size, _data);
+    _size = v._size;
+    v._size = 0;
+    return;
+  } else {
+    transfer(v._data, v._size, _data);
+    _size = v._size;
+  }
+  v.clear();
+}
+
+// Fills an empty inline small_vector with count elements, on the heap only
+// when they don't fit
+template <class T, std::size_t N, class Allocator>
+template <typename InputIt>
+void small_vector<T, N, Allocator>::construct_from(InputIt first,
+                                                   size_type count) {
+  if (count > _capacity) {
+    _data = alloc_traits::allocate(_allocator, count);
+    _capacity = count;
+  }
+  try {
+    for (; _size < count; ++_size, ++first)
+      alloc_traits::construct(_allocator, _data + _size, *first);
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::small_vector(small_vector&& v) noexcept(
+    nothrow_relocatable)
+    : small_vector(v._allocator) {
+  if (v.is_inline()) {
+    take_elements(v);
+  } else {
+    take_heap(v);
+  }
+}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::small_vector(small_vector&& v,
+                                            const Allocator& alloc)
+    : small_vector(alloc) {
+  take(v);
+}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::small_vector(const small_vector& v)
+    : small_vector(v, alloc_traits::select_on_container_copy_construction(
+                          v._allocator)) {}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::small_vector(const small_vector& v,
+                                            const Allocator& alloc)
+    : small_vector(alloc) {
+  construct_from(v._data, v._size);
+}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>::small_vector(
+    std::initializer_list<value_type> items, const Allocator& alloc)
+    : small_vector(alloc) {
+  construct_from(items.begin(), items.size());
+}
+
+template <class T, std::size_t N, class Allocator>
+T& small_vector<T, N, Allocator>::back() {
+  if (_size == 0) throw "size is equal to zero";
+  return _data[_size - 1];
+}
+
+template <class T, std::size_t N, class Allocator>
+const T& small_vector<T, N, Allocator>::back() const {
+  if (_size == 0) throw "size is equal to zero";
+  return _data[_size - 1];
+}
+
+template <class T, std::size_t N, class Allocator>
+T& small_vector<T, N, Allocator>::front() {
+  if (_size == 0) throw "size is equal to zero";
+  return *_data;
+}
+
+template <class T, std::size_t N, class Allocator>
+const T& small_vector<T, N, Allocator>::front() const {
+  if (_size == 0) throw "size is equal to zero";
+  return *_data;
+}
+
+template <class T, std::size_t N, class Allocator>
+inline void small_vector<T, N, Allocator>::pop_back() {
+  if (_size == 0) throw "size is equal to zero";
+  destroy_from(_size - 1);
+}
+
+// Two heap blocks trade pointers; inline elements are moved across, and
+// with allocators that neither propagate nor compare equal a heap side is
+// copied into a new block of the other allocator
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::swap(small_vector& other) noexcept(
+    nothrow_swappable) {
+  if (this == &other) return;
+  if (is_inline() || other.is_inline()) {
+    small_vector tmp(std::move(other));
+    other.release();
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      other.steal(*this);
+      release();
+      steal(tmp);
+    } else {
+      other.take(*this);
+      release();
+      take(tmp);
+    }
+    return;
+  }
+  std::swap(_data, other._data);
+  std::swap(_size, other._size);
+  std::swap(_capacity, other._capacity);
+  if constexpr (alloc_traits::propagate_on_container_swap::value) {
+    using std::swap;
+    swap(_allocator, other._allocator);
+  }
+}
+
+template <class T, std::size_t N, class Allocator>
+template <typename... Args>
+T* small_vector<T, N, Allocator>::emplace(const_iterator pos, Args&&... args) {
+  size_type idx = pos - begin();
+  if (idx > _size) throw "incorrect iterator";
+  if (idx == _size) return &emplace_back(std::forward<Args>(args)...);
+
+  value_type value(std::forward<Args>(args)...);
+  if (_size == _capacity) reallocate(grown_capacity());
+  alloc_traits::construct(_allocator, _data + _size,
+                          std::move(_data[_size - 1]));
+  _size++;
+  std::move_backward(_data + idx, _data + _size - 2, _data + _size - 1);
+  _data[idx] = std::move(value);
+  return _data + idx;
+}
+
+template <class T, std::size_t N, class Allocator>
+T small_vector<T, N, Allocator>::min() const {
+  if (_size == 0) throw "size is equal to zero";
+  return simd::min(_data, _size);
+}
+
+template <class T, std::size_t N, class Allocator>
+T small_vector<T, N, Allocator>::max() const {
+  if (_size == 0) throw "size is equal to zero";
+  return simd::max(_data, _size);
+}
+
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::erase(iterator pos) {
+  if (!_size) throw "Vector is already empty!";
+
+  std::move(pos + 1, end(), pos);
+  destroy_from(_size - 1);
+}
+
+template <class T, std::size_t N, class Allocator>
+template <typename... Args>
+T& small_vector<T, N, Allocator>::emplace_back(Args&&... args) {
+  if (_size >= _capacity) {
+    grow_append(std::forward<Args>(args)...);
+  } else {
+    alloc_traits::construct(_allocator, _data + _size,
+                            std::forward<Args>(args)...);
+    _size++;
+  }
+  return _data[_size - 1];
+}
+
+// Comes back to the inline buffer when the elements fit there
+template <class T, std::size_t N, class Allocator>
+void small_vector<T, N, Allocator>::shrink_to_fit() {
+  if (is_inline() || _capacity == _size) return;
+  if (_size > N) {
+    reallocate(_size);
+    return;
+  }
+  iterator heap = _data;
+  size_type heap_capacity = _capacity;
+  if constexpr (nothrow_relocatable) {
+    relocate(heap, _size, inline_data());
+  } else {
+    transfer(heap, _size, inline_data());
+    destroy_range(heap, _size);
+  }
+  _data = inline_data();
+  _capacity = N;
+  alloc_traits::deallocate(_allocator, heap, heap_capacity);
+}
+
+template <class T, std::size_t N, class Allocator>
+const T& small_vector<T, N, Allocator>::operator[](size_type i) const {
+  if (i >= _size) throw "Invalid vector index";
+  return _data[i];
+}
+
+template <class T, std::size_t N, class Allocator>
+T& small_vector<T, N, Allocator>::operator[](size_type i) {
+  if (i >= _size) throw "Invalid vector index";
+  return _data[i];
+}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>& small_vector<T, N, Allocator>::operator=(
+    small_vector&& v) noexcept(nothrow_relocatable &&
+                               (alloc_traits::
+                                    propagate_on_container_move_assignment::
+                                        value ||
+                                alloc_traits::is_always_equal::value)) {
+  if (this == &v) return *this;
+
+  release();
+  if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+    _allocator = v._allocator;
+  take(v);
+  return *this;
+}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>& small_vector<T, N, Allocator>::operator=(
+    const small_vector& v) {
+  if (this == &v) return *this;
+
+  release();
+  if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+    _allocator = v._allocator;
+  construct_from(v._data, v._size);
+  return *this;
+}
+
+template <class T, std::size_t N, class Allocator>
+small_vector<T, N, Allocator>& small_vector<T, N, Allocator>::operator=(
+    std::initializer_list<value_type> ilist) {
+  release();
+  construct_from(ilist.begin(), ilist.size());
+  return *this;
+}
+
+namespace pmr {
+template <typename T, std::size_t N>
+using small_vector =
+    s21::small_vector<T, N, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+
+}  // namespace s21
+#endif
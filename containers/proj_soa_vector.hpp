@@ -0,0 +1,576 @@
+#ifndef S21_SOA_VECTOR_H
+#define S21_SOA_VECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../utilities/growth.hpp"
+#include "../utilities/relocate.hpp"
+
+namespace s21 {
+
+// One column of an s21::soa_vector: a pointer and a length, valid until the
+// vector reallocates. With data() and size() it is a container for the
+// s21::simd functions and a range for s21::parallel.
+template <typename T>
+class column_span {
+ public:
+  using value_type = std::remove_const_t<T>;
+  using reference = T &;
+  using iterator = T *;
+  using size_type = std::size_t;
+
+  constexpr column_span() noexcept = default;
+  constexpr column_span(T *data, size_type size) noexcept
+      : _data(data), _size(size) {}
+  template <typename U,
+            typename = std::enable_if_t<std::is_same<const U, T>::value>>
+  constexpr column_span(column_span<U> other) noexcept
+      : _data(other.data()), _size(other.size()) {}
+
+  constexpr T *data() const noexcept { return _data; }
+  constexpr size_type size() const noexcept { return _size; }
+  constexpr bool empty() const noexcept { return _size == 0; }
+  constexpr T &operator[](size_type i) const { return _data[i]; }
+  constexpr iterator begin() const noexcept { return _data; }
+  constexpr iterator end() const noexcept { return _data + _size; }
+
+ private:
+  T *_data = nullptr;
+  size_type _size = 0;
+};
+
+// A row of an s21::soa_vector: references to the fields at one index, read
+// with get<I>() or a structured binding (whose names then refer to the
+// fields in the columns). Assigning a tuple or another row writes the
+// fields, as with std::vector<bool>::reference.
+template <bool Const, typename... Fields>
+class soa_row {
+  using columns = std::tuple<Fields *...>;
+
+ public:
+  using value_type = std::tuple<Fields...>;
+  template <std::size_t I>
+  using field = std::conditional_t<Const,
+                                   const std::tuple_element_t<I, value_type>,
+                                   std::tuple_element_t<I, value_type>>;
+
+  soa_row(const columns *cols, std::size_t idx) noexcept
+      : _columns(cols), _idx(idx) {}
+  soa_row(const soa_row &) noexcept = default;
+  template <bool C = Const, typename = std::enable_if_t<C>>
+  soa_row(const soa_row<false, Fields...> &other) noexcept
+      : _columns(other._columns), _idx(other._idx) {}
+
+  template <std::size_t I>
+  field<I> &get() const noexcept {
+    return std::get<I>(*_columns)[_idx];
+  }
+
+  operator value_type() const {
+    return load(std::index_sequence_for<Fields...>());
+  }
+
+  const soa_row &operator=(const soa_row &other) const {
+    return assign(other, std::index_sequence_for<Fields...>());
+  }
+  template <bool C>
+  const soa_row &operator=(const soa_row<C, Fields...> &other) const {
+    return assign(other, std::index_sequence_for<Fields...>());
+  }
+  const soa_row &operator=(const value_type &values) const {
+    return assign(values, std::index_sequence_for<Fields...>());
+  }
+
+ private:
+  template <bool, typename...>
+  friend class soa_row;
+
+  template <std::size_t... I>
+  value_type load(std::index_sequence<I...>) const {
+    return value_type(get<I>()...);
+  }
+
+  template <std::size_t... I>
+  const soa_row &assign(const value_type &values,
+                        std::index_sequence<I...>) const {
+    static_assert(!Const, "row is read-only");
+    ((get<I>() = std::get<I>(values)), ...);
+    return *this;
+  }
+
+  template <bool C, std::size_t... I>
+  const soa_row &assign(const soa_row<C, Fields...> &other,
+                        std::index_sequence<I...>) const {
+    static_assert(!Const, "row is read-only");
+    ((get<I>() = other.template get<I>()), ...);
+    return *this;
+  }
+
+  const columns *_columns;
+  std::size_t _idx;
+};
+
+template <std::size_t I, bool Const, typename... Fields>
+decltype(auto) get(const soa_row<Const, Fields...> &row) noexcept {
+  return row.template get<I>();
+}
+
+// Random access iterator over the rows of an s21::soa_vector. Like
+// std::vector<bool>, it dereferences to a proxy rather than a reference.
+template <bool Const, typename... Fields>
+class soa_iterator {
+  using columns = std::tuple<Fields *...>;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::tuple<Fields...>;
+  using difference_type = std::ptrdiff_t;
+  using reference = soa_row<Const, Fields...>;
+  using pointer = void;
+
+  soa_iterator() noexcept = default;
+  soa_iterator(const columns *cols, std::size_t idx) noexcept
+      : _columns(cols), _idx(idx) {}
+  template <bool C = Const, typename = std::enable_if_t<C>>
+  soa_iterator(const soa_iterator<false, Fields...> &other) noexcept
+      : _columns(other._columns), _idx(other._idx) {}
+
+  reference operator*() const noexcept { return reference(_columns, _idx); }
+  reference operator[](difference_type n) const noexcept {
+    return reference(_columns, _idx + n);
+  }
+  // Index of the row the iterator points at
+  std::size_t index() const noexcept { return _idx; }
+
+  soa_iterator &operator++() noexcept { return ++_idx, *this; }
+  soa_iterator &operator--() noexcept { return --_idx, *this; }
+  soa_iterator operator++(int) noexcept { return {_columns, _idx++}; }
+  soa_iterator operator--(int) noexcept { return {_columns, _idx--}; }
+  soa_iterator &operator+=(difference_type n) noexcept {
+    return _idx += n, *this;
+  }
+  soa_iterator &operator-=(difference_type n) noexcept {
+    return _idx -= n, *this;
+  }
+  friend soa_iterator operator+(soa_iterator it, difference_type n) noexcept {
+    return it += n;
+  }
+  friend soa_iterator operator+(difference_type n, soa_iterator it) noexcept {
+    return it += n;
+  }
+  friend soa_iterator operator-(soa_iterator it, difference_type n) noexcept {
+    return it -= n;
+  }
+  friend difference_type operator-(const soa_iterator &lhs,
+                                   const soa_iterator &rhs) noexcept {
+    return difference_type(lhs._idx) - difference_type(rhs._idx);
+  }
+
+  friend bool operator==(const soa_iterator &lhs,
+                         const soa_iterator &rhs) noexcept {
+    return lhs._idx == rhs._idx;
+  }
+  friend bool operator!=(const soa_iterator &lhs,
+                         const soa_iterator &rhs) noexcept {
+    return lhs._idx != rhs._idx;
+  }
+  friend bool operator<(const soa_iterator &lhs,
+                        const soa_iterator &rhs) noexcept {
+    return lhs._idx < rhs._idx;
+  }
+  friend bool operator>(const soa_iterator &lhs,
+                        const soa_iterator &rhs) noexcept {
+    return lhs._idx > rhs._idx;
+  }
+  friend bool operator<=(const soa_iterator &lhs,
+                         const soa_iterator &rhs) noexcept {
+    return lhs._idx <= rhs._idx;
+  }
+  friend bool operator>=(const soa_iterator &lhs,
+                         const soa_iterator &rhs) noexcept {
+    return lhs._idx >= rhs._idx;
+  }
+
+ private:
+  template <bool, typename...>
+  friend class soa_iterator;
+
+  const columns *_columns = nullptr;
+  std::size_t _idx = 0;
+};
+
+// Vector of records stored as a struct of arrays: field I of every row sits
+// in column I, and all columns share one size and capacity. A scan over a
+// few fields reads only their columns instead of pulling whole records
+// through the cache. The columns live in one block, each starting on a
+// column_alignment boundary, so vector loads over a column never split a
+// cache line at its start.
+template <typename... Fields>
+class soa_vector {
+  static_assert(sizeof...(Fields) > 0, "s21::soa_vector needs a field");
+  static_assert(((alignof(Fields) <= 64) && ...),
+                "fields may be aligned to 64 bytes at most");
+
+ public:
+  using value_type = std::tuple<Fields...>;
+  using reference = soa_row<false, Fields...>;
+  using const_reference = soa_row<true, Fields...>;
+  using iterator = soa_iterator<false, Fields...>;
+  using const_iterator = soa_iterator<true, Fields...>;
+  using size_type = std::size_t;
+  template <std::size_t I>
+  using field_type = std::tuple_element_t<I, value_type>;
+
+  static constexpr size_type columns = sizeof...(Fields);
+  static constexpr size_type column_alignment = 64;
+
+  soa_vector() noexcept = default;
+  explicit soa_vector(size_type size) {
+    try {
+      resize(size);
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+  soa_vector(std::initializer_list<value_type> rows) {
+    try {
+      reserve(rows.size());
+      for (const auto &row : rows) push_back(row);
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+  soa_vector(const soa_vector &other) {
+    try {
+      reserve(other._size);
+      copy_from(other, index_sequence());
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+  soa_vector(soa_vector &&other) noexcept { swap(other); }
+  ~soa_vector() { release(); }
+
+  soa_vector &operator=(const soa_vector &other) {
+    if (this != &other) {
+      soa_vector copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  soa_vector &operator=(soa_vector &&other) noexcept {
+    soa_vector moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  size_type size() const noexcept { return _size; }
+  size_type capacity() const noexcept { return _capacity; }
+  bool empty() const noexcept { return _size == 0; }
+  size_type max_size() const noexcept {
+    return std::numeric_limits<std::ptrdiff_t>::max() / row_bytes;
+  }
+
+  void reserve(size_type size) {
+    if (size > max_size()) throw "Cant allocate memory";
+    if (size > _capacity) reallocate(size);
+  }
+  void shrink_to_fit() {
+    if (_capacity > _size) reallocate(_size);
+  }
+  void clear() noexcept { destroy_from(0); }
+  // New rows are value-initialized
+  void resize(size_type size) {
+    if (size <= _size) return destroy_from(size);
+    reserve(size);
+    while (_size < size) emplace_back(Fields()...);
+  }
+
+  void push_back(const value_type &row) {
+    std::apply([this](const auto &...fields) { emplace_back(fields...); },
+               row);
+  }
+  void push_back(value_type &&row) {
+    std::apply(
+        [this](auto &&...fields) {
+          emplace_back(std::forward<decltype(fields)>(fields)...);
+        },
+        std::move(row));
+  }
+  // Builds field I of the new row from args[I]
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    static_assert(sizeof...(Args) == sizeof...(Fields),
+                  "one argument per field");
+    if (_size == _capacity) {
+      // the arguments may refer to rows that are about to move
+      value_type row(std::forward<Args>(args)...);
+      reallocate(Growth::grow(_capacity, _size + 1, row_bytes));
+      std::apply(
+          [this](auto &&...fields) {
+            construct_row(index_sequence(),
+                          std::forward<decltype(fields)>(fields)...);
+          },
+          std::move(row));
+    } else {
+      construct_row(index_sequence(), std::forward<Args>(args)...);
+    }
+    return back();
+  }
+  void pop_back() {
+    if (_size == 0) throw "size is equal to zero";
+    destroy_from(_size - 1);
+  }
+
+  reference operator[](size_type i) {
+    if (i >= _size) throw "Invalid vector index";
+    return reference(&_columns, i);
+  }
+  const_reference operator[](size_type i) const {
+    if (i >= _size) throw "Invalid vector index";
+    return const_reference(&_columns, i);
+  }
+  reference front() {
+    if (_size == 0) throw "size is equal to zero";
+    return reference(&_columns, 0);
+  }
+  const_reference front() const {
+    if (_size == 0) throw "size is equal to zero";
+    return const_reference(&_columns, 0);
+  }
+  reference back() {
+    if (_size == 0) throw "size is equal to zero";
+    return reference(&_columns, _size - 1);
+  }
+  const_reference back() const {
+    if (_size == 0) throw "size is equal to zero";
+    return const_reference(&_columns, _size - 1);
+  }
+
+  iterator begin() noexcept { return iterator(&_columns, 0); }
+  iterator end() noexcept { return iterator(&_columns, _size); }
+  const_iterator begin() const noexcept { return cbegin(); }
+  const_iterator end() const noexcept { return cend(); }
+  const_iterator cbegin() const noexcept {
+    return const_iterator(&_columns, 0);
+  }
+  const_iterator cend() const noexcept {
+    return const_iterator(&_columns, _size);
+  }
+
+  // Column I, aligned to column_alignment while the vector has storage
+  template <std::size_t I>
+  field_type<I> *data() noexcept {
+    return std::get<I>(_columns);
+  }
+  template <std::size_t I>
+  const field_type<I> *data() const noexcept {
+    return std::get<I>(_columns);
+  }
+  template <std::size_t I>
+  column_span<field_type<I>> column() noexcept {
+    return {data<I>(), _size};
+  }
+  template <std::size_t I>
+  column_span<const field_type<I>> column() const noexcept {
+    return {data<I>(), _size};
+  }
+
+  void swap(soa_vector &other) noexcept {
+    std::swap(_columns, other._columns);
+    std::swap(_size, other._size);
+    std::swap(_capacity, other._capacity);
+  }
+
+ private:
+  using Growth = double_growth;
+  using column_pointers = std::tuple<Fields *...>;
+  using index_sequence = std::index_sequence_for<Fields...>;
+
+  static constexpr size_type row_bytes = (sizeof(Fields) + ...);
+
+  template <typename T>
+  static constexpr bool moves_quietly =
+      is_trivially_relocatable<T>::value ||
+      std::is_nothrow_move_constructible<T>::value;
+
+  static constexpr size_type padded(size_type bytes) noexcept {
+    return (bytes + column_alignment - 1) & ~(column_alignment - 1);
+  }
+
+  // One block holding every column; column 0 starts it
+  static column_pointers allocate(size_type capacity) {
+    if (capacity == 0) return {};
+    char *block = static_cast<char *>(::operator new(
+        (padded(capacity * sizeof(Fields)) + ...),
+        std::align_val_t(column_alignment)));
+    size_type offset = 0;
+    return column_pointers{place<Fields>(block, offset, capacity)...};
+  }
+
+  template <typename T>
+  static T *place(char *block, size_type &offset, size_type capacity) {
+    T *column = reinterpret_cast<T *>(block + offset);
+    offset += padded(capacity * sizeof(T));
+    return column;
+  }
+
+  static void deallocate(const column_pointers &cols) noexcept {
+    if (std::get<0>(cols))
+      ::operator delete(std::get<0>(cols), std::align_val_t(column_alignment));
+  }
+
+  // Moves every column to a block for capacity rows. Columns that could
+  // throw on the way go first, copied or, when they can't be copied, moved,
+  // and a failure frees the new block and leaves the old one in place; the
+  // rest then relocate without throwing. As with std::vector, a column of
+  // move-only fields keeps its moved-from values when the move throws.
+  void reallocate(size_type capacity) {
+    column_pointers fresh = allocate(capacity);
+    size_type copied = 0;
+    try {
+      copy_columns(fresh, copied, index_sequence());
+    } catch (...) {
+      destroy_columns(fresh, copied, index_sequence());
+      deallocate(fresh);
+      throw;
+    }
+    move_columns(fresh, index_sequence());
+    deallocate(_columns);
+    _columns = fresh;
+    _capacity = capacity;
+  }
+
+  template <std::size_t... I>
+  void copy_columns(const column_pointers &to, size_type &copied,
+                    std::index_sequence<I...>) {
+    auto copy = [&](auto *from, auto *dest) {
+      using T = std::remove_pointer_t<decltype(from)>;
+      if constexpr (!moves_quietly<T>) {
+        if constexpr (std::is_copy_constructible<T>::value)
+          std::uninitialized_copy_n(from, _size, dest);
+        else
+          std::uninitialized_move_n(from, _size, dest);
+        ++copied;
+      }
+    };
+    (copy(std::get<I>(_columns), std::get<I>(to)), ...);
+  }
+
+  // Ends the copies of the first copied columns that could throw
+  template <std::size_t... I>
+  void destroy_columns(const column_pointers &cols, size_type copied,
+                       std::index_sequence<I...>) noexcept {
+    size_type seen = 0;
+    auto destroy = [&](auto *column) {
+      using T = std::remove_pointer_t<decltype(column)>;
+      if constexpr (!moves_quietly<T>)
+        if (seen++ < copied) std::destroy_n(column, _size);
+    };
+    (destroy(std::get<I>(cols)), ...);
+  }
+
+  template <std::size_t... I>
+  void move_columns(const column_pointers &to,
+                    std::index_sequence<I...>) noexcept {
+    auto move = [&](auto *from, auto *dest) {
+      using T = std::remove_pointer_t<decltype(from)>;
+      if constexpr (is_trivially_relocatable<T>::value) {
+        if (_size)
+          std::memcpy(static_cast<void *>(dest),
+                      static_cast<const void *>(from), _size * sizeof(T));
+        return;
+      } else if constexpr (moves_quietly<T>) {
+        std::uninitialized_move_n(from, _size, dest);
+      }
+      std::destroy_n(from, _size);
+    };
+    (move(std::get<I>(_columns), std::get<I>(to)), ...);
+  }
+
+  // Constructs row _size field by field, ending the fields already built if
+  // a later one throws
+  template <std::size_t... I, typename... Args>
+  void construct_row(std::index_sequence<I...>, Args &&...args) {
+    size_type built = 0;
+    try {
+      ((::new (static_cast<void *>(std::get<I>(_columns) + _size))
+            Fields(std::forward<Args>(args)),
+        ++built),
+       ...);
+    } catch (...) {
+      ((I < built ? std::destroy_at(std::get<I>(_columns) + _size) : void()),
+       ...);
+      throw;
+    }
+    ++_size;
+  }
+
+  template <std::size_t... I>
+  void copy_from(const soa_vector &other, std::index_sequence<I...>) {
+    size_type copied = 0;
+    try {
+      ((std::uninitialized_copy_n(std::get<I>(other._columns), other._size,
+                                  std::get<I>(_columns)),
+        ++copied),
+       ...);
+    } catch (...) {
+      ((I < copied ? std::destroy(std::get<I>(_columns),
+                                  std::get<I>(_columns) + other._size)
+                   : void()),
+       ...);
+      throw;
+    }
+    _size = other._size;
+  }
+
+  // Returns the block, the vector stays empty
+  void release() noexcept {
+    clear();
+    deallocate(_columns);
+    _columns = column_pointers{};
+    _capacity = 0;
+  }
+
+  void destroy_from(size_type idx) noexcept {
+    std::apply(
+        [&](auto *...column) {
+          (std::destroy(column + idx, column + _size), ...);
+        },
+        _columns);
+    _size = idx;
+  }
+
+  column_pointers _columns{};
+  size_type _size = 0;
+  size_type _capacity = 0;
+};
+
+}  // namespace s21
+
+namespace std {
+
+template <bool Const, typename... Fields>
+struct tuple_size<s21::soa_row<Const, Fields...>>
+    : integral_constant<size_t, sizeof...(Fields)> {};
+
+template <size_t I, bool Const, typename... Fields>
+struct tuple_element<I, s21::soa_row<Const, Fields...>> {
+  using type = typename s21::soa_row<Const, Fields...>::template field<I> &;
+};
+
+}  // namespace std
+
+#endif
@@ -2,6 +2,9 @@
 #define S21_STACK_HPP
 
 #include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 #include "proj_list.hpp"
 
@@ -34,7 +37,13 @@ class stack {
     throw;
   }
 
-  stack(stack &&s) try : container_(container_type(s.container_)) {
+  stack(stack &&s) : container_(std::move(s.container_)) {}
+
+  // Forwards the allocator to the underlying container
+  template <typename Alloc,
+            typename = std::enable_if_t<
+                std::uses_allocator<container_type, Alloc>::value>>
+  explicit stack(const Alloc &alloc) try : container_(alloc) {
   } catch (std::bad_alloc &t) {
     std::cerr << t.what() << std::endl;
     throw;
@@ -42,8 +51,13 @@ class stack {
 
   ~stack() {}
 
+  stack &operator=(const stack &s) {
+    container_ = s.container_;
+    return *this;
+  }
+
   stack &operator=(stack &&s) {
-    if (s != *this) swap(s);
+    container_ = std::move(s.container_);
     return *this;
   }
 
@@ -62,13 +76,20 @@ class stack {
     }
   }
 
+  void push(value_type &&value) { container_.push_back(std::move(value)); }
+
+  template <class... Args>
+  decltype(auto) emplace(Args &&...args) {
+    return container_.emplace_back(std::forward<Args>(args)...);
+  }
+
   void pop() { container_.pop_back(); }
   void swap(stack &other) noexcept { container_.swap(other.container_); }
 
+  // Pushes the arguments in order, the last one ends up on top
   template <class... Args>
   void insert_many_front(Args &&...args) {
-    s21::list<T> it = container_.begin();
-    for (const auto &arg : {args...}) insert(it, arg);
+    (container_.emplace_back(std::forward<Args>(args)), ...);
   }
 
   /*** NON-MEMBER ***/
@@ -80,6 +101,11 @@ class stack {
   container_type container_;
 };
 
+namespace pmr {
+template <typename T>
+using stack = s21::stack<T, s21::pmr::list<T>>;
+}  // namespace pmr
+
 }  // namespace s21
 
 #endif
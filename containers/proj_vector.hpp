@@ -1,12 +1,28 @@
 #ifndef S21_VECTOR_H
 #define S21_VECTOR_H
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../utilities/growth.hpp"
+#include "../utilities/relocate.hpp"
+#include "../utilities/simd.hpp"
 
 namespace s21 {
 
-template <class T, class Allocator = std::allocator<T>>
+// Growth is one of the policies in utilities/growth.hpp: double_growth,
+// golden_growth or size_class_growth
+template <class T, class Allocator = std::allocator<T>,
+          class Growth = double_growth>
 class vector {
  public:
   using value_type = T;
@@ -15,20 +31,41 @@ class vector {
   using iterator = T*;
   using const_iterator = const T*;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
 
-  vector();
-  vector(unsigned size);
+  vector() noexcept(noexcept(Allocator())) : vector(Allocator()) {}
+  explicit vector(const Allocator& alloc) noexcept;
+  vector(size_type size, const Allocator& alloc = Allocator());
   vector(vector&& v) noexcept;
+  vector(vector&& v, const Allocator& alloc);
   vector(const vector& v);
-  vector(std::initializer_list<value_type> items);
+  vector(const vector& v, const Allocator& alloc);
+  vector(std::initializer_list<value_type> items,
+         const Allocator& alloc = Allocator());
   ~vector();
 
   inline size_type size() const noexcept { return _size; }
-  inline size_type max_size() const { return _allocator.max_size(); }
+  inline size_type max_size() const {
+    return alloc_traits::max_size(_allocator);
+  }
   void reserve(size_type size);
   inline size_type capacity() const noexcept { return _capacity; }
   inline bool empty() const noexcept { return _size == 0; }
-  void clear() noexcept { _size = 0; }
+  void clear() noexcept { destroy_from(0); }
+  // New elements are value-initialized, or copies of value
+  void resize(size_type size);
+  void resize(size_type size, const_reference value);
+  // New elements are default-initialized: trivial types keep whatever bytes
+  // the storage holds, for a caller that is about to overwrite them
+  void resize_for_overwrite(size_type size);
+  // Adds count default-initialized elements and returns the first of them,
+  // e.g. for read() or recv() to fill
+  T* append_uninitialized(size_type count) {
+    size_type old_size = _size;
+    resize_for_overwrite(_size + count);
+    return _data + old_size;
+  }
+  allocator_type get_allocator() const noexcept { return _allocator; }
 
   inline reference back();
   inline const_reference back() const;
@@ -36,240 +73,753 @@ class vector {
   inline reference front();
   inline const_reference front() const;
 
-  void push_back(const_reference value);
-  void push_back(T&& value);
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+  template <typename... Args>
+  reference emplace_back(Args&&... args);
   void pop_back();
   void swap(vector& other) noexcept;
-  iterator insert(iterator pos, const_reference value);
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, T&& value) {
+    return emplace(pos, std::move(value));
+  }
+  iterator insert(const_iterator pos, size_type count, const_reference value);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  iterator insert(const_iterator pos, InputIt first, InputIt last);
+  iterator insert(const_iterator pos, std::initializer_list<T> items) {
+    return insert(pos, items.begin(), items.end());
+  }
   void erase(iterator pos);
 
   inline iterator begin() const noexcept { return _data; }
   inline iterator end() const noexcept { return _data + _size; }
   inline T* data() const noexcept { return _data; };
 
-  void shrink_to_fit() noexcept;
+  void shrink_to_fit();
 
   value_type operator[](size_type i) const;
   reference operator[](size_type i);
-  vector& operator=(vector&& v) noexcept;
+  vector& operator=(vector&& v) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value);
   vector& operator=(const vector& v);
   vector& operator=(std::initializer_list<value_type> ilist);
 
+  // Each argument becomes one element, moved from when passed as an rvalue.
+  // The tail moves once and the storage grows at most once.
   template <typename... Args>
-  iterator insert_many(const_iterator pos, Args&&... args) {
-    size_type idx = pos - begin();
-    for (const auto& arg : {args...}) {
-      insert(begin() + idx, arg);
-      idx++;
-    }
-    return (iterator)pos;
-  }
+  iterator insert_many(const_iterator pos, Args&&... args);
 
   template <typename... Args>
   void insert_many_back(Args&&... args) {
-    for (const auto& arg : {args...}) push_back(arg);
+    insert_many(end(), std::forward<Args>(args)...);
+  }
+
+  // Linear scans, vectorized for arithmetic types (utilities/simd.hpp)
+  iterator find(const_reference value) const {
+    return _data + simd::find(_data, _size, value);
+  }
+  size_type count(const_reference value) const {
+    return simd::count(_data, _size, value);
   }
+  bool contains(const_reference value) const {
+    return simd::find(_data, _size, value) != _size;
+  }
+  void fill(const_reference value) { simd::fill(_data, _size, value); }
+  // Smallest and largest element, and the sum of arithmetic elements
+  value_type min() const;
+  value_type max() const;
+  simd::sum_type<T> sum() const { return simd::sum(_data, _size); }
 
   friend bool operator==(const vector& lhs, const vector& rhs) {
-    if (lhs.size() != rhs.size()) return false;
-    for (size_type idx = 0; idx < lhs.size(); idx++)
-      if (lhs[idx] != rhs[idx]) return false;
-    return true;
+    return lhs.size() == rhs.size() &&
+           simd::equal(lhs.data(), rhs.data(), lhs.size());
   }
 
   friend bool operator!=(const vector& lhs, const vector& rhs) {
     return !(lhs == rhs);
   }
 
+  friend bool operator<(const vector& lhs, const vector& rhs) {
+    return simd::compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0;
+  }
+
+  friend bool operator>(const vector& lhs, const vector& rhs) {
+    return rhs < lhs;
+  }
+
+  friend bool operator<=(const vector& lhs, const vector& rhs) {
+    return !(rhs < lhs);
+  }
+
+  friend bool operator>=(const vector& lhs, const vector& rhs) {
+    return !(lhs < rhs);
+  }
+
  private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  size_type grown_capacity(size_type needed) const noexcept {
+    return Growth::grow(_capacity, needed, sizeof(T));
+  }
+  // Whether elements can change places without a chance of throwing
+  static constexpr bool nothrow_relocatable =
+      relocate_by_memcpy<T, Allocator> ||
+      std::is_nothrow_move_constructible<T>::value;
+  // Trivially copyable elements on the default allocator are kept in malloc
+  // blocks so that growing can go through realloc: glibc extends a block in
+  // place when the memory after it is free and moves large (mmap'd) blocks
+  // with mremap, remapping their pages instead of copying them
+  static constexpr bool by_realloc =
+      std::is_same<Allocator, std::allocator<T>>::value &&
+      std::is_trivially_copyable<T>::value &&
+      alignof(T) <= alignof(std::max_align_t);
+
+  iterator allocate_block(size_type count);
+  void deallocate_block(iterator block, size_type count) noexcept;
+
+  void reallocate(size_type new_capacity);
+  void relocate_to(iterator new_data);
+  void relocate(iterator from, size_type count, iterator to) noexcept;
+  void transfer(iterator from, size_type count, iterator to);
+  void destroy_range(iterator from, size_type count) noexcept;
+  void shift_tail(size_type idx, size_type count) noexcept;
+  void unshift_tail(size_type idx, size_type count) noexcept;
+  template <typename Fill>
+  iterator insert_with(size_type idx, size_type count, Fill fill);
+  bool in_tail(const void* p, size_type idx) const noexcept;
+  template <typename Init>
+  void resize_with(size_type size, Init init);
+  void adopt(iterator new_data, size_type new_capacity) noexcept;
+  template <typename... Args>
+  void grow_append(Args&&... args);
+  void destroy_from(size_type idx) noexcept;
+  void release() noexcept;
+  template <typename InputIt>
+  void construct_from(InputIt first, size_type count);
+
   Allocator _allocator;
   iterator _data;
   size_type _size;
-  unsigned _capacity;
+  size_type _capacity;
 };
 
-template <class T, class Allocator>
-vector<T, Allocator>::vector()
-    : _allocator(std::allocator<value_type>()),
-      _data(nullptr),
-      _size(0),
-      _capacity(0) {}
+template <class T, class Allocator, class Growth>
+vector<T, Allocator, Growth>::vector(const Allocator& alloc) noexcept
+    : _allocator(alloc), _data(nullptr), _size(0), _capacity(0) {}
+
+template <class T, class Allocator, class Growth>
+vector<T, Allocator, Growth>::vector(size_type size,
+                                     const Allocator& alloc)
+    : vector(alloc) {
+  try {
+    reserve(size);
+    resize(size);
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+template <class T, class Allocator, class Growth>
+vector<T, Allocator, Growth>::~vector() {
+  release();
+}
+
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::reserve(size_type size) {
+  if (size > max_size()) throw "Cant allocate memory";
+  if (size > _capacity) reallocate(Growth::grow(0, size, sizeof(T)));
+}
+
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::resize(size_type size) {
+  if constexpr (relocate_by_memcpy<T, Allocator> &&
+                std::is_trivially_default_constructible<T>::value) {
+    // value-initialized trivial elements are all zero bytes
+    size_type old_size = _size;
+    resize_for_overwrite(size);
+    if (_size > old_size)
+      std::memset(static_cast<void*>(_data + old_size), 0,
+                  (_size - old_size) * sizeof(T));
+    return;
+  }
+  resize_with(size, [&](iterator slot) {
+    alloc_traits::construct(_allocator, slot);
+  });
+}
 
-template <class T, class Allocator>
-vector<T, Allocator>::vector(unsigned size) : _size(size), _capacity(size) {
-  _data = _allocator.allocate(_capacity);
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::resize(size_type size,
+                                          const_reference value) {
+  if (size > _capacity && in_tail(std::addressof(value), 0)) {
+    value_type copy(value);
+    return resize(size, copy);
+  }
+  resize_with(size, [&](iterator slot) {
+    alloc_traits::construct(_allocator, slot, value);
+  });
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>::~vector() {
-  for (size_t i = 0; i < _size; i++) _allocator.destroy(_data + i);
-  _allocator.deallocate(_data, _capacity);
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::resize_for_overwrite(size_type size) {
+  resize_with(size, [&](iterator slot) {
+    if constexpr (!std::is_trivially_default_constructible<T>::value)
+      alloc_traits::construct(_allocator, slot);
+    else
+      static_cast<void>(slot);
+  });
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::reserve(size_type size) {
+// Ends the elements past size, or grows to size with init(slot) building
+// each new element; a throw leaves the elements as they were
+template <class T, class Allocator, class Growth>
+template <typename Init>
+void vector<T, Allocator, Growth>::resize_with(size_type size, Init init) {
+  if (size <= _size) {
+    destroy_from(size);
+    return;
+  }
   if (size > max_size()) throw "Cant allocate memory";
-  if (size <= _size) return;
+  if (size > _capacity) reallocate(grown_capacity(size));
+  size_type built = _size;
+  try {
+    for (; built < size; built++) init(_data + built);
+  } catch (...) {
+    destroy_range(_data + _size, built - _size);
+    throw;
+  }
+  _size = size;
+}
 
-  vector<T> new_data(size);
+template <class T, class Allocator, class Growth>
+T* vector<T, Allocator, Growth>::allocate_block(size_type count) {
+  if constexpr (by_realloc) {
+    void* block = std::malloc(count * sizeof(T));
+    if (!block) throw std::bad_alloc();
+    return static_cast<iterator>(block);
+  } else {
+    return alloc_traits::allocate(_allocator, count);
+  }
+}
 
-  for (size_t i = 0; i < _size; i++) new_data[i] = _data[i];
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::deallocate_block(iterator block,
+                                                    size_type count) noexcept {
+  if constexpr (by_realloc) {
+    std::free(block);
+  } else {
+    alloc_traits::deallocate(_allocator, block, count);
+  }
+}
 
-  for (size_t i = 0; i < _size; i++) _allocator.destroy(_data + i);
-  _allocator.deallocate(_data, _capacity);
+// Moves the elements into a block of new_capacity slots, the same one
+// resized when realloc can do it
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::reallocate(size_type new_capacity) {
+  if constexpr (by_realloc) {
+    if (_data && new_capacity) {
+      void* block = std::realloc(_data, new_capacity * sizeof(T));
+      if (!block) throw std::bad_alloc();
+      _data = static_cast<iterator>(block);
+      _capacity = new_capacity;
+      return;
+    }
+  }
+  iterator new_data = new_capacity ? allocate_block(new_capacity) : nullptr;
+  try {
+    relocate_to(new_data);
+  } catch (...) {
+    deallocate_block(new_data, new_capacity);
+    throw;
+  }
+  adopt(new_data, new_capacity);
+}
 
-  if (!_capacity) _capacity = 1;
-  while (_capacity < size) _capacity <<= 1;
+// Leaves the elements in new_data and ends them here. Trivially relocatable
+// types go over in one memcpy, the rest are moved and destroyed one by one
+// when the move can't throw; otherwise they are copied first and destroyed
+// after, so a throw leaves the vector as it was.
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::relocate_to(iterator new_data) {
+  if constexpr (nothrow_relocatable) {
+    relocate(_data, _size, new_data);
+  } else {
+    transfer(_data, _size, new_data);
+    destroy_range(_data, _size);
+  }
+}
 
-  _data = _allocator.allocate(_capacity);
-  for (size_t i = 0; i < size; i++) _data[i] = new_data[i];
+// Moves count elements to raw storage that doesn't overlap them, only for
+// types that relocate without throwing
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::relocate(iterator from, size_type count,
+                                    iterator to) noexcept {
+  static_assert(nothrow_relocatable);
+  if constexpr (relocate_by_memcpy<T, Allocator>) {
+    if (count)
+      std::memcpy(static_cast<void*>(to), static_cast<void*>(from),
+                  count * sizeof(T));
+  } else {
+    for (size_type i = 0; i < count; i++) {
+      alloc_traits::construct(_allocator, to + i, std::move(from[i]));
+      alloc_traits::destroy(_allocator, from + i);
+    }
+  }
+}
 
-  _size = size;
+// Builds copies (or nothrow moves) of count elements in raw storage and
+// keeps the sources, a throw destroys what it built
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::transfer(iterator from, size_type count,
+                                    iterator to) {
+  size_type built = 0;
+  try {
+    for (; built < count; built++)
+      alloc_traits::construct(_allocator, to + built,
+                              std::move_if_noexcept(from[built]));
+  } catch (...) {
+    destroy_range(to, built);
+    throw;
+  }
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>::vector(vector&& v) noexcept {
-  for (size_t i = 0; i < _size; i++) _allocator.destroy(_data + i);
-  _allocator.deallocate(_data, _capacity);
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::destroy_range(iterator from,
+                                         size_type count) noexcept {
+  for (size_type i = 0; i < count; i++)
+    alloc_traits::destroy(_allocator, from + i);
+}
 
-  _data = v._data;
-  _size = v._size;
-  _capacity = v._capacity;
+// Moves the elements from idx on count slots up within the capacity,
+// leaving raw slots at [idx, idx + count)
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::shift_tail(size_type idx,
+                                              size_type count) noexcept {
+  if constexpr (relocate_by_memcpy<T, Allocator>) {
+    std::memmove(static_cast<void*>(_data + idx + count),
+                 static_cast<void*>(_data + idx), (_size - idx) * sizeof(T));
+  } else {
+    for (size_type i = _size; i-- > idx;) {
+      alloc_traits::construct(_allocator, _data + i + count,
+                              std::move(_data[i]));
+      alloc_traits::destroy(_allocator, _data + i);
+    }
+  }
+}
 
+// Closes the raw gap shift_tail left
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::unshift_tail(size_type idx,
+                                        size_type count) noexcept {
+  if constexpr (relocate_by_memcpy<T, Allocator>) {
+    std::memmove(static_cast<void*>(_data + idx),
+                 static_cast<void*>(_data + idx + count),
+                 (_size - idx) * sizeof(T));
+  } else {
+    for (size_type i = idx; i < _size; i++) {
+      alloc_traits::construct(_allocator, _data + i,
+                              std::move(_data[i + count]));
+      alloc_traits::destroy(_allocator, _data + i + count);
+    }
+  }
+}
+
+// Makes room for count elements at idx and has fill(slot, built) construct
+// them in the raw slots from slot on, counting each one in built. The tail
+// moves once; when the storage has to grow the new elements are built in
+// the fresh block before anything moves, so they may be made from elements
+// of this vector. A throw from fill leaves the vector as it was.
+template <class T, class Allocator, class Growth>
+template <typename Fill>
+T* vector<T, Allocator, Growth>::insert_with(size_type idx, size_type count,
+                                     Fill fill) {
+  if (count == 0) return _data + idx;
+  size_type built = 0;
+  if (_size + count <= _capacity && nothrow_relocatable) {
+    shift_tail(idx, count);
+    try {
+      fill(_data + idx, built);
+    } catch (...) {
+      destroy_range(_data + idx, built);
+      unshift_tail(idx, count);
+      throw;
+    }
+    _size += count;
+    return _data + idx;
+  }
+
+  size_type new_capacity = grown_capacity(_size + count);
+  iterator new_data = allocate_block(new_capacity);
+  try {
+    fill(new_data + idx, built);
+  } catch (...) {
+    destroy_range(new_data + idx, built);
+    deallocate_block(new_data, new_capacity);
+    throw;
+  }
+  if constexpr (nothrow_relocatable) {
+    relocate(_data, idx, new_data);
+    relocate(_data + idx, _size - idx, new_data + idx + count);
+  } else {
+    try {
+      transfer(_data, idx, new_data);
+      try {
+        transfer(_data + idx, _size - idx, new_data + idx + count);
+      } catch (...) {
+        destroy_range(new_data, idx);
+        throw;
+      }
+    } catch (...) {
+      destroy_range(new_data + idx, count);
+      deallocate_block(new_data, new_capacity);
+      throw;
+    }
+    destroy_range(_data, _size);
+  }
+  adopt(new_data, new_capacity);
+  _size += count;
+  return _data + idx;
+}
+
+// Whether p points into an element at idx or after it, which shift_tail
+// would move away
+template <class T, class Allocator, class Growth>
+bool vector<T, Allocator, Growth>::in_tail(const void* p,
+                                   size_type idx) const noexcept {
+  std::less_equal<const void*> le;
+  std::less<const void*> lt;
+  return le(static_cast<const void*>(_data + idx), p) &&
+         lt(p, static_cast<const void*>(_data + _size));
+}
+
+template <class T, class Allocator, class Growth>
+T* vector<T, Allocator, Growth>::insert(const_iterator pos, size_type count,
+                                const_reference value) {
+  size_type idx = pos - begin();
+  if (idx > _size) throw "incorrect iterator";
+  if (in_tail(std::addressof(value), idx)) {
+    value_type copy(value);
+    return insert(pos, count, copy);
+  }
+  return insert_with(idx, count, [&](iterator slot, size_type& built) {
+    for (; built < count; built++)
+      alloc_traits::construct(_allocator, slot + built, value);
+  });
+}
+
+// Sized ranges go into place in one step; a single-pass range is appended
+// and rotated into place, which still moves the tail only once more
+template <class T, class Allocator, class Growth>
+template <typename InputIt, typename>
+T* vector<T, Allocator, Growth>::insert(const_iterator pos, InputIt first,
+                                InputIt last) {
+  size_type idx = pos - begin();
+  if (idx > _size) throw "incorrect iterator";
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    size_type count = std::distance(first, last);
+    if constexpr (std::is_pointer<InputIt>::value) {
+      std::less<const void*> lt;
+      if (nothrow_relocatable && _size + count <= _capacity &&
+          lt(first, _data + _size) && lt(_data + idx, last)) {
+        // the range overlaps the part that moves, copy it aside first
+        vector aside(_allocator);
+        aside.reallocate(count);
+        aside.insert(aside.end(), first, last);
+        return insert(pos, std::make_move_iterator(aside.begin()),
+                      std::make_move_iterator(aside.end()));
+      }
+    }
+    return insert_with(idx, count, [&](iterator slot, size_type& built) {
+      for (; built < count; built++, ++first)
+        alloc_traits::construct(_allocator, slot + built, *first);
+    });
+  } else {
+    size_type old_size = _size;
+    for (; first != last; ++first) emplace_back(*first);
+    std::rotate(_data + idx, _data + old_size, _data + _size);
+    return _data + idx;
+  }
+}
+
+template <class T, class Allocator, class Growth>
+template <typename... Args>
+T* vector<T, Allocator, Growth>::insert_many(const_iterator pos,
+                                             Args&&... args) {
+  constexpr size_type count = sizeof...(Args);
+  size_type idx = pos - begin();
+  if (idx > _size) throw "incorrect iterator";
+  if constexpr (count == 0) {
+    return _data + idx;
+  } else {
+    if (nothrow_relocatable && _size + count <= _capacity &&
+        (in_tail(std::addressof(args), idx) || ...)) {
+      // an argument lives in the part that moves, build the values aside
+      vector aside(_allocator);
+      aside.reallocate(count);
+      (aside.emplace_back(std::forward<Args>(args)), ...);
+      return insert(pos, std::make_move_iterator(aside.begin()),
+                    std::make_move_iterator(aside.end()));
+    }
+    return insert_with(idx, count, [&](iterator slot, size_type& built) {
+      ((alloc_traits::construct(_allocator, slot + built,
+                                std::forward<Args>(args)),
+        built++),
+       ...);
+    });
+  }
+}
+
+// Swaps in a block that already holds the elements
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::adopt(iterator new_data,
+                                 size_type new_capacity) noexcept {
+  if (_data) deallocate_block(_data, _capacity);
+  _data = new_data;
+  _capacity = new_capacity;
+}
+
+// Grows the capacity and appends T(args...). The new element is built
+// before the old ones move, so args may refer into the vector itself.
+template <class T, class Allocator, class Growth>
+template <typename... Args>
+void vector<T, Allocator, Growth>::grow_append(Args&&... args) {
+  size_type new_capacity = grown_capacity(_size + 1);
+  if constexpr (by_realloc) {
+    if (_data) {
+      value_type value(std::forward<Args>(args)...);
+      reallocate(new_capacity);
+      alloc_traits::construct(_allocator, _data + _size, value);
+      _size++;
+      return;
+    }
+  }
+  iterator new_data = allocate_block(new_capacity);
+  try {
+    alloc_traits::construct(_allocator, new_data + _size,
+                            std::forward<Args>(args)...);
+  } catch (...) {
+    deallocate_block(new_data, new_capacity);
+    throw;
+  }
+  try {
+    relocate_to(new_data);
+  } catch (...) {
+    alloc_traits::destroy(_allocator, new_data + _size);
+    deallocate_block(new_data, new_capacity);
+    throw;
+  }
+  adopt(new_data, new_capacity);
+  _size++;
+}
+
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::destroy_from(size_type idx) noexcept {
+  while (_size > idx) alloc_traits::destroy(_allocator, _data + --_size);
+}
+
+// Returns the storage to the allocator, the vector stays empty
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::release() noexcept {
+  destroy_from(0);
+  if (_data) deallocate_block(_data, _capacity);
+  _data = nullptr;
+  _capacity = 0;
+}
+
+// Fills an empty vector with exactly count elements
+template <class T, class Allocator, class Growth>
+template <typename InputIt>
+void vector<T, Allocator, Growth>::construct_from(InputIt first,
+                                                  size_type count) {
+  if (!count) return;
+  _data = allocate_block(count);
+  _capacity = count;
+  try {
+    for (; _size < count; ++_size, ++first)
+      alloc_traits::construct(_allocator, _data + _size, *first);
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+template <class T, class Allocator, class Growth>
+vector<T, Allocator, Growth>::vector(vector&& v) noexcept
+    : _allocator(std::move(v._allocator)),
+      _data(v._data),
+      _size(v._size),
+      _capacity(v._capacity) {
   v._data = nullptr;
   v._size = 0;
   v._capacity = 0;
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>::vector(const vector& v) {
-  _size = v._size;
-  _capacity = v._capacity;
+// Storage changes hands only when the allocators are interchangeable
+template <class T, class Allocator, class Growth>
+vector<T, Allocator, Growth>::vector(vector&& v, const Allocator& alloc)
+    : vector(alloc) {
+  if (_allocator == v._allocator) {
+    swap(v);
+  } else {
+    construct_from(std::make_move_iterator(v._data), v._size);
+  }
+}
+
+template <class T, class Allocator, class Growth>
+vector<T, Allocator, Growth>::vector(const vector& v)
+    : vector(v, alloc_traits::select_on_container_copy_construction(
+                    v._allocator)) {}
 
-  _data = _allocator.allocate(_capacity);
-  for (size_t i = 0; i < _size; i++) _data[i] = v._data[i];
+template <class T, class Allocator, class Growth>
+vector<T, Allocator, Growth>::vector(const vector& v, const Allocator& alloc)
+    : vector(alloc) {
+  construct_from(v._data, v._size);
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>::vector(std::initializer_list<value_type> items)
-    : _size(items.size()), _capacity(items.size()) {
-  _data = _allocator.allocate(_capacity);
-  size_type idx = 0;
-  for (value_type item : items) {
-    _data[idx] = item;
-    idx++;
-  }
+template <class T, class Allocator, class Growth>
+vector<T, Allocator, Growth>::vector(std::initializer_list<value_type> items,
+                             const Allocator& alloc)
+    : vector(alloc) {
+  construct_from(items.begin(), items.size());
 }
 
-template <class T, class Allocator>
-T& vector<T, Allocator>::back() {
+template <class T, class Allocator, class Growth>
+T& vector<T, Allocator, Growth>::back() {
   if (_size == 0) throw "size is equal to zero";
   return _data[_size - 1];
 }
 
-template <class T, class Allocator>
-const T& vector<T, Allocator>::back() const {
+template <class T, class Allocator, class Growth>
+const T& vector<T, Allocator, Growth>::back() const {
   if (_size == 0) throw "size is equal to zero";
   return _data[_size - 1];
 }
 
-template <class T, class Allocator>
-T& vector<T, Allocator>::front() {
+template <class T, class Allocator, class Growth>
+T& vector<T, Allocator, Growth>::front() {
   if (_size == 0) throw "size is equal to zero";
   return *_data;
 }
 
-template <class T, class Allocator>
-const T& vector<T, Allocator>::front() const {
+template <class T, class Allocator, class Growth>
+const T& vector<T, Allocator, Growth>::front() const {
   if (_size == 0) throw "size is equal to zero";
   return *_data;
 }
 
-template <class T, class Allocator>
-inline void vector<T, Allocator>::pop_back() {
+template <class T, class Allocator, class Growth>
+inline void vector<T, Allocator, Growth>::pop_back() {
   if (_size == 0) throw "size is equal to zero";
-  _allocator.destroy(_data + _size);
-  _size--;
+  destroy_from(_size - 1);
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::swap(vector& other) noexcept {
+// Allocators are exchanged only when they propagate on swap
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::swap(vector& other) noexcept {
   std::swap(_data, other._data);
   std::swap(_size, other._size);
   std::swap(_capacity, other._capacity);
+  if constexpr (alloc_traits::propagate_on_container_swap::value) {
+    using std::swap;
+    swap(_allocator, other._allocator);
+  }
 }
 
-template <class T, class Allocator>
-T* vector<T, Allocator>::insert(iterator pos, const_reference value) {
-  size_t idx = pos - begin();
+// The new element is built aside first, args may refer into the vector
+template <class T, class Allocator, class Growth>
+template <typename... Args>
+T* vector<T, Allocator, Growth>::emplace(const_iterator pos, Args&&... args) {
+  size_type idx = pos - begin();
   if (idx > _size) throw "incorrect iterator";
-  reserve(_size + 1);
-  for (size_t i = _size - 1; i > idx; i--) {
-    _data[i] = _data[i - 1];
-  }
-  _data[idx] = value;
-  return pos;
+  if (idx == _size) return &emplace_back(std::forward<Args>(args)...);
+
+  value_type value(std::forward<Args>(args)...);
+  if (_size == _capacity) reallocate(grown_capacity(_size + 1));
+  alloc_traits::construct(_allocator, _data + _size,
+                          std::move(_data[_size - 1]));
+  _size++;
+  std::move_backward(_data + idx, _data + _size - 2, _data + _size - 1);
+  _data[idx] = std::move(value);
+  return _data + idx;
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::erase(iterator pos) {
-  if (!_size) throw "Vector is already empty!";
+template <class T, class Allocator, class Growth>
+T vector<T, Allocator, Growth>::min() const {
+  if (_size == 0) throw "size is equal to zero";
+  return simd::min(_data, _size);
+}
 
-  for (iterator it = pos; it < end() - 1; it++) *it = *(it + 1);
-  _size--;
+template <class T, class Allocator, class Growth>
+T vector<T, Allocator, Growth>::max() const {
+  if (_size == 0) throw "size is equal to zero";
+  return simd::max(_data, _size);
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::push_back(const_reference value) {
-  if (_size >= _capacity) {
-    size_t new_capacity = _capacity * 2 + (_capacity == 0);
-    iterator new_data = _allocator.allocate(new_capacity);
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::erase(iterator pos) {
+  if (!_size) throw "Vector is already empty!";
 
-    for (size_t i = 0; i < _size; i++) new_data[i] = _data[i];
-    _allocator.deallocate(_data, _capacity);
-    _capacity = new_capacity;
-    _data = new_data;
-  }
-  _data[_size++] = value;
+  for (iterator it = pos; it < end() - 1; it++) *it = std::move(*(it + 1));
+  destroy_from(_size - 1);
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::push_back(T&& value) {
+template <class T, class Allocator, class Growth>
+template <typename... Args>
+T& vector<T, Allocator, Growth>::emplace_back(Args&&... args) {
   if (_size >= _capacity) {
-    size_t new_capacity = _capacity * 2 + (_capacity == 0);
-    iterator new_data = _allocator.allocate(new_capacity);
-
-    for (size_t i = 0; i < _size; i++) new_data[i] = _data[i];
-    _allocator.deallocate(_data, _capacity);
-    _capacity = new_capacity;
-    _data = new_data;
+    grow_append(std::forward<Args>(args)...);
+  } else {
+    alloc_traits::construct(_allocator, _data + _size,
+                            std::forward<Args>(args)...);
+    _size++;
   }
-  _data[_size++] = std::move(value);
+  return _data[_size - 1];
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::shrink_to_fit() noexcept {
-  _allocator.deallocate(_data + _size, _capacity - _size);
-  _capacity = _size;
+template <class T, class Allocator, class Growth>
+void vector<T, Allocator, Growth>::shrink_to_fit() {
+  if (_capacity > _size) reallocate(_size);
 }
 
-template <class T, class Allocator>
-T s21::vector<T, Allocator>::operator[](size_type i) const {
+template <class T, class Allocator, class Growth>
+T s21::vector<T, Allocator, Growth>::operator[](size_type i) const {
   if (i >= _size) throw "Invalid vector index";
   return _data[i];
 }
 
-template <class T, class Allocator>
-T& s21::vector<T, Allocator>::operator[](size_type i) {
+template <class T, class Allocator, class Growth>
+T& s21::vector<T, Allocator, Growth>::operator[](size_type i) {
   if (i >= _size) throw "Invalid vector index";
   return _data[i];
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>& vector<T, Allocator>::operator=(vector&& v) noexcept {
-  for (size_t i = 0; i < _size; i++) _allocator.destroy(_data + i);
-  _allocator.deallocate(_data, _capacity);
+template <class T, class Allocator, class Growth>
+vector<T, Allocator, Growth>& vector<T, Allocator, Growth>::operator=(
+    vector&& v) noexcept(alloc_traits::propagate_on_container_move_assignment::
+                             value ||
+                         alloc_traits::is_always_equal::value) {
+  if (this == &v) return *this;
+
+  if constexpr (!alloc_traits::propagate_on_container_move_assignment::value &&
+                !alloc_traits::is_always_equal::value) {
+    // memory of a foreign allocator can't be adopted, move the elements
+    if (_allocator != v._allocator) {
+      release();
+      construct_from(std::make_move_iterator(v._data), v._size);
+      return *this;
+    }
+  }
 
+  release();
+  if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+    _allocator = std::move(v._allocator);
   _data = v._data;
   _size = v._size;
   _capacity = v._capacity;
@@ -280,34 +830,35 @@ vector<T, Allocator>& vector<T, Allocator>::operator=(vector&& v) noexcept {
   return *this;
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>& vector<T, Allocator>::operator=(const vector& v) {
-  for (size_t i = 0; i < _size; i++) _allocator.destroy(_data + i);
-  _allocator.deallocate(_data, _capacity);
-  _size = v._size;
-  _capacity = v._capacity;
-
-  _data = _allocator.allocate(_capacity);
-  for (size_t i = 0; i < _size; i++) _data[i] = v._data[i];
+template <class T, class Allocator, class Growth>
+vector<T, Allocator, Growth>& vector<T, Allocator, Growth>::operator=(
+    const vector& v) {
+  if (this == &v) return *this;
 
+  release();
+  if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+    _allocator = v._allocator;
+  construct_from(v._data, v._size);
   return *this;
 }
 
-template <class T, class Allocator>
-vector<T, Allocator>& vector<T, Allocator>::operator=(
+template <class T, class Allocator, class Growth>
+vector<T, Allocator, Growth>& vector<T, Allocator, Growth>::operator=(
     std::initializer_list<value_type> ilist) {
-  for (size_t i = 0; i < _size; i++) _allocator.destroy(_data + i);
-  _allocator.deallocate(_data, _capacity);
-  _size = ilist.size();
-  _capacity = _size;
-  _data = _allocator.allocate(_capacity);
-  size_type idx = 0;
-  for (T item : ilist) {
-    _data[idx] = ilist;
-    idx++;
-  }
+  release();
+  construct_from(ilist.begin(), ilist.size());
   return *this;
 }
 
+// The buffer doesn't point back into the vector
+template <class T, class Allocator, class Growth>
+struct is_trivially_relocatable<vector<T, Allocator, Growth>>
+    : is_trivially_relocatable<Allocator> {};
+
+namespace pmr {
+template <typename T>
+using vector = s21::vector<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+
 }  // namespace s21
 #endif
@@ -4,12 +4,23 @@
 #include <iterator>
 
 #include "containers/proj_array.hpp"
+#include "containers/proj_frozen_map.hpp"
+#include "containers/proj_frozen_set.hpp"
+#include "containers/proj_interval_map.hpp"
+#include "containers/proj_interval_set.hpp"
 #include "containers/proj_list.hpp"
+#include "containers/proj_lru_cache.hpp"
 #include "containers/proj_map.hpp"
 #include "containers/proj_multiset.hpp"
 #include "containers/proj_queue.hpp"
+#include "containers/proj_radix_map.hpp"
+#include "containers/proj_radix_set.hpp"
 #include "containers/proj_set.hpp"
+#include "containers/proj_small_vector.hpp"
+#include "containers/proj_soa_vector.hpp"
 #include "containers/proj_stack.hpp"
 #include "containers/proj_vector.hpp"
+#include "utilities/aligned_allocator.hpp"
+#include "utilities/parallel.hpp"
 
 #endif
@@ -0,0 +1,47 @@
+#include <cstdint>
+
+#include "../proj_tests.hpp"
+
+namespace {
+
+bool AlignedTo(const void *p, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+}  // namespace
+
+TEST(AlignedAllocator, KeepsBlocksAligned) {
+  s21::vector<float, s21::aligned_allocator<float>> v;
+  for (int i = 0; i < 1000; i++) {
+    v.push_back(i * 0.5f);
+    ASSERT_TRUE(AlignedTo(v.data(), 64));
+  }
+  EXPECT_EQ(v[999], 499.5f);
+
+  // rebinds to the node type of other containers
+  s21::list<double, s21::aligned_allocator<double, 128>> l = {1.0, 2.0};
+  l.push_back(3.0);
+  EXPECT_EQ(l.back(), 3.0);
+  EXPECT_EQ(s21::aligned_allocator<char>(),
+            s21::aligned_allocator<char>(s21::aligned_allocator<int>()));
+
+  s21::array<float, 5, 64> a = {1, 2, 3, 4, 5};
+  EXPECT_EQ(alignof(decltype(a)), 64u);
+  EXPECT_TRUE(AlignedTo(a.data(), 64));
+  EXPECT_EQ(a[4], 5);
+}
+
+TEST(HugePageAllocator, MapsLargeBlocks) {
+  using allocator = s21::huge_page_allocator<std::uint64_t>;
+  s21::vector<std::uint64_t, allocator> small = {1, 2, 3};
+  EXPECT_FALSE(allocator::mapped(small.capacity() * sizeof(std::uint64_t)));
+
+  s21::vector<std::uint64_t, allocator> v;
+  for (std::uint64_t i = 0; i < 1000000; i++) v.push_back(i * 3);
+  EXPECT_TRUE(allocator::mapped(v.capacity() * sizeof(std::uint64_t)));
+  EXPECT_TRUE(AlignedTo(v.data(), allocator::huge_page_size));
+  for (std::uint64_t i = 0; i < 1000000; i += 997) ASSERT_EQ(v[i], i * 3);
+
+  v.shrink_to_fit();
+  EXPECT_EQ(v.back(), 2999997u);
+}
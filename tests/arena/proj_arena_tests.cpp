@@ -0,0 +1,90 @@
+#include <cstdint>
+#include <string>
+
+#include "../proj_tests.hpp"
+
+TEST(Arena, BumpsAligned) {
+  s21::arena a(256);
+  void *first = a.allocate(3, 1);
+  void *second = a.allocate(8, 8);
+  void *wide = a.allocate(64, 64);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) % 8, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(wide) % 64, 0u);
+  EXPECT_EQ(a.capacity(), 256u);
+
+  // larger than any block so far, gets a block of its own
+  void *big = a.allocate(10000);
+  EXPECT_NE(big, nullptr);
+  EXPECT_GE(a.capacity(), 256u + 10000u);
+}
+
+TEST(Arena, ResetReusesBlocks) {
+  s21::arena a(128);
+  for (int i = 0; i < 100; i++) a.allocate(48);
+  std::size_t reserved = a.capacity();
+  void *head = nullptr;
+
+  for (int round = 0; round < 3; round++) {
+    a.reset();
+    void *p = a.allocate(48);
+    if (!head) head = p;
+    EXPECT_EQ(p, head);
+    for (int i = 1; i < 100; i++) a.allocate(48);
+    EXPECT_EQ(a.capacity(), reserved);
+  }
+
+  a.release();
+  EXPECT_EQ(a.capacity(), 0u);
+}
+
+TEST(Arena, ContainersOnArena) {
+  s21::arena a;
+  {
+    s21::vector<int, s21::arena_allocator<int>> v(a);
+    s21::list<int, s21::arena_allocator<int>> l(a);
+    s21::set<int, std::less<int>, s21::arena_allocator<int>> s(a);
+    for (int i = 0; i < 1000; i++) {
+      v.push_back(i);
+      l.push_back(i);
+      s.insert(i % 100);
+    }
+    EXPECT_EQ(v[999], 999);
+    EXPECT_EQ(l.back(), 999);
+    EXPECT_EQ(s.size(), 100u);
+    EXPECT_EQ(s.get_allocator().resource(), &a);
+
+    // same arena, the move takes the nodes over
+    std::size_t reserved = a.capacity();
+    s21::list<int, s21::arena_allocator<int>> moved(a);
+    moved = std::move(l);
+    EXPECT_EQ(moved.size(), 1000u);
+    EXPECT_EQ(a.capacity(), reserved);
+  }
+  a.reset();
+
+  s21::map<int, std::string,
+           s21::arena_allocator<std::pair<const int, std::string>>>
+      m(a);
+  m.insert(1, std::string(100, 'x'));
+  EXPECT_EQ(m.at(1).size(), 100u);
+}
+
+TEST(Arena, SkipsTeardownWalk) {
+  using counted_set = s21::set<int, std::less<int>, s21::arena_allocator<int>,
+                               s21::stats_tree_traits>;
+  s21::arena a;
+  counted_set s(a);
+  for (int i = 0; i < 500; i++) s.insert(i);
+  s.clear();
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.stats().deallocations, 0u);
+  s.insert(7);
+  EXPECT_TRUE(s.contains(7));
+
+  s21::set<int, std::less<int>, std::allocator<int>, s21::stats_tree_traits>
+      heap;
+  for (int i = 0; i < 500; i++) heap.insert(i);
+  heap.clear();
+  EXPECT_EQ(heap.stats().deallocations, 500u);
+}
@@ -129,3 +129,24 @@ TEST(Specialization, Zero) {
   a.swap(a2);
   EXPECT_EQ(a2.size(), 0);
 }
+
+TEST(ArrayMethods, Search) {
+  s21::array<int, 9> a = {5, 3, 8, 1, 9, 2, 7, 3, 6};
+  EXPECT_EQ(a.find(9) - a.begin(), 4);
+  EXPECT_EQ(a.find(4), a.end());
+  EXPECT_EQ(a.count(3), 2u);
+  EXPECT_TRUE(a.contains(6));
+  EXPECT_EQ(a.min(), 1);
+  EXPECT_EQ(a.max(), 9);
+  EXPECT_EQ(a.sum(), 44);
+
+  s21::array<int, 9> b = a;
+  b[8] = 7;
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(a != b);
+  b.swap(a);
+  EXPECT_EQ(a[8], 7);
+  EXPECT_EQ(b[8], 6);
+  a.fill(-1);
+  EXPECT_EQ(a.count(-1), 9u);
+}
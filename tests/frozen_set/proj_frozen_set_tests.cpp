@@ -0,0 +1,159 @@
+#include <stdexcept>
+#include <vector>
+
+#include "../proj_tests.hpp"
+
+namespace {
+
+// Counts live instances; the copy after budget more copies throws
+struct fragile_key {
+  static inline int live = 0;
+  static inline int budget = -1;
+
+  explicit fragile_key(int v) : value(v) { ++live; }
+  fragile_key(const fragile_key &other) : value(other.value) {
+    if (budget == 0) throw std::runtime_error("copy");
+    if (budget > 0) --budget;
+    ++live;
+  }
+  ~fragile_key() { --live; }
+
+  bool operator<(const fragile_key &other) const {
+    return value < other.value;
+  }
+
+  int value;
+};
+
+}  // namespace
+
+TEST(FrozenSet, FromSet) {
+  s21::set<int> s;
+  for (int i = 0; i < 1000; i += 3) s.insert(i);
+  s21::frozen_set<int> fs(s);
+  EXPECT_EQ(fs.size(), s.size());
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(fs.contains(i), i % 3 == 0);
+  EXPECT_FALSE(fs.contains(-1));
+  EXPECT_FALSE(fs.contains(1000));
+}
+
+TEST(FrozenSet, SortedIteration) {
+  s21::frozen_set<int> fs = {9, 4, 7, 1, 4, 12, 3};
+  std::vector<int> expected = {1, 3, 4, 7, 9, 12};
+  std::vector<int> got(fs.begin(), fs.end());
+  EXPECT_EQ(got, expected);
+  EXPECT_EQ(fs.size(), 6);
+}
+
+TEST(FrozenSet, LowerBoundAndFind) {
+  s21::frozen_set<int> fs = {10, 20, 30, 40, 50};
+  EXPECT_EQ(*fs.lower_bound(25), 30);
+  EXPECT_EQ(*fs.lower_bound(10), 10);
+  EXPECT_TRUE(fs.lower_bound(51) == fs.end());
+  EXPECT_TRUE(fs.find(35) == fs.end());
+  EXPECT_EQ(*fs.find(40), 40);
+}
+
+TEST(FrozenSet, StringKeys) {
+  s21::frozen_set<std::string> fs = {"pear", "apple", "fig", "kiwi"};
+  EXPECT_TRUE(fs.contains("fig"));
+  EXPECT_FALSE(fs.contains("plum"));
+  EXPECT_EQ(*fs.begin(), "apple");
+  s21::frozen_set<std::string> copy(fs);
+  EXPECT_TRUE(copy == fs);
+}
+
+TEST(FrozenSet, Empty) {
+  s21::frozen_set<int> fs;
+  EXPECT_TRUE(fs.empty());
+  EXPECT_FALSE(fs.contains(0));
+  EXPECT_TRUE(fs.begin() == fs.end());
+}
+
+TEST(FrozenKarySet, Unsigned64) {
+  s21::set<uint64_t> s;
+  for (uint64_t i = 0; i < 5000; ++i) s.insert(i * 7 + 1);
+  s.insert(UINT64_MAX);
+  s21::frozen_kary_set<uint64_t> fs(s);
+  for (uint64_t i = 0; i < 40000; ++i)
+    ASSERT_EQ(fs.contains(i), i % 7 == 1 && i < 35000) << i;
+  EXPECT_TRUE(fs.contains(UINT64_MAX));
+}
+
+TEST(FrozenKarySet, Signed32) {
+  s21::frozen_kary_set<int> fs = {-50, -3, 0, 8, 1000, INT32_MAX - 1};
+  EXPECT_TRUE(fs.contains(-50));
+  EXPECT_TRUE(fs.contains(0));
+  EXPECT_TRUE(fs.contains(INT32_MAX - 1));
+  EXPECT_FALSE(fs.contains(INT32_MAX));
+  EXPECT_FALSE(fs.contains(-4));
+  EXPECT_EQ(fs.size(), 6);
+}
+
+TEST(FrozenMap, FromMap) {
+  s21::map<std::string, int> m{{"okay", 100}, {"let's", 200}, {"go", 300}};
+  s21::frozen_map<std::string, int> fm = s21::freeze(m);
+  EXPECT_EQ(fm.size(), 3);
+  EXPECT_EQ(fm.at("go"), 300);
+  EXPECT_EQ(fm.find("okay")->second, 100);
+  EXPECT_TRUE(fm.find("meme") == fm.end());
+  EXPECT_THROW(fm.at("meme"), std::out_of_range);
+  EXPECT_EQ((*fm.begin()).first, "go");
+}
+
+TEST(FrozenSet, FindMany) {
+  s21::frozen_set<int> fs = {2, 4, 6, 8, 10, 12, 14, 16, 18};
+  std::vector<int> keys;
+  for (int i = 0; i < 40; ++i) keys.push_back(i % 21);
+  std::vector<s21::frozen_set<int>::const_iterator> found;
+  fs.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+  ASSERT_EQ(found.size(), keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    if (fs.contains(keys[i]))
+      EXPECT_EQ(*found[i], keys[i]);
+    else
+      EXPECT_TRUE(found[i] == fs.end());
+  }
+}
+
+TEST(FrozenKarySet, ContainsMany) {
+  s21::set<uint32_t> s;
+  for (uint32_t i = 0; i < 3000; ++i) s.insert(i * 5);
+  s21::frozen_kary_set<uint32_t> fs(s);
+  std::vector<uint32_t> keys;
+  for (uint32_t i = 0; i < 16000; i += 3) keys.push_back(i);
+  std::vector<bool> result;
+  fs.contains_many(keys.begin(), keys.end(), std::back_inserter(result));
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    ASSERT_EQ(result[i], keys[i] % 5 == 0 && keys[i] < 15000) << keys[i];
+}
+
+TEST(FrozenMap, ContainsMany) {
+  s21::frozen_map<int, int> fm = {{1, 10}, {5, 50}, {9, 90}};
+  std::vector<int> keys = {9, 2, 1};
+  std::vector<s21::frozen_map<int, int>::const_iterator> found;
+  fm.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+  EXPECT_EQ((*found[0]).second, 90);
+  EXPECT_TRUE(found[1] == fm.end());
+  EXPECT_EQ(found[2]->second, 10);
+}
+
+TEST(FrozenSet, LayoutCopyCleansUpOnThrow) {
+  {
+    std::vector<fragile_key> keys;
+    for (int i = 0; i < 20; ++i) keys.emplace_back(i);
+    s21::eytzinger_layout<fragile_key> layout(keys.begin(), keys.size());
+    EXPECT_EQ(fragile_key::live, 40);
+
+    fragile_key::budget = 7;
+    EXPECT_THROW(s21::eytzinger_layout<fragile_key> copy(layout),
+                 std::runtime_error);
+    fragile_key::budget = -1;
+    EXPECT_EQ(fragile_key::live, 40);
+
+    s21::eytzinger_layout<fragile_key> copy(layout);
+    EXPECT_EQ(copy.size(), 20u);
+    EXPECT_EQ(copy[copy.find(fragile_key(13))].value, 13);
+  }
+  EXPECT_EQ(fragile_key::live, 0);
+}
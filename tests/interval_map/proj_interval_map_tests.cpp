@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "../proj_tests.hpp"
+
+namespace {
+
+using interval = std::tuple<int, int, int>;
+
+std::vector<interval> collect_overlap(s21::interval_map<int, int> &m, int lo,
+                                      int hi) {
+  std::vector<interval> out;
+  m.overlap(lo, hi, [&](int l, int h, int &v) { out.emplace_back(l, h, v); });
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+std::vector<interval> collect_enclosing(s21::interval_map<int, int> &m,
+                                        int lo, int hi) {
+  std::vector<interval> out;
+  m.enclosing(lo, hi,
+              [&](int l, int h, int &v) { out.emplace_back(l, h, v); });
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+std::vector<interval> brute(const std::vector<interval> &all, int lo, int hi,
+                            bool enclosing) {
+  std::vector<interval> out;
+  for (const auto &[l, h, v] : all) {
+    bool hit = enclosing ? l <= lo && hi <= h : l <= hi && lo <= h;
+    if (hit) out.emplace_back(l, h, v);
+  }
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+}  // namespace
+
+TEST(IntervalMap, Overlap) {
+  s21::interval_map<int, int> m;
+  m.insert(1, 5, 10);
+  m.insert(3, 8, 20);
+  m.insert(10, 12, 30);
+  m.insert(15, 15, 40);
+  EXPECT_EQ(m.size(), 4U);
+
+  std::vector<interval> expected = {{1, 5, 10}, {3, 8, 20}};
+  EXPECT_EQ(collect_overlap(m, 4, 6), expected);
+  expected = {{3, 8, 20}, {10, 12, 30}};
+  EXPECT_EQ(collect_overlap(m, 8, 10), expected);
+  EXPECT_TRUE(collect_overlap(m, 13, 14).empty());
+  expected = {{15, 15, 40}};
+  EXPECT_EQ(collect_overlap(m, 15, 100), expected);
+}
+
+TEST(IntervalMap, StabAndEnclosing) {
+  s21::interval_map<int, int> m;
+  m.insert(0, 100, 1);
+  m.insert(10, 20, 2);
+  m.insert(15, 30, 3);
+  m.insert(25, 26, 4);
+
+  int sum = 0;
+  m.stab(18, [&](int, int, int &v) { sum += v; });
+  EXPECT_EQ(sum, 1 + 2 + 3);
+
+  std::vector<interval> expected = {{0, 100, 1}, {15, 30, 3}};
+  EXPECT_EQ(collect_enclosing(m, 20, 28), expected);
+  expected = {{0, 100, 1}};
+  EXPECT_EQ(collect_enclosing(m, 5, 50), expected);
+  EXPECT_TRUE(collect_enclosing(m, -1, 5).empty());
+}
+
+TEST(IntervalMap, ValuesAreMutable) {
+  s21::interval_map<int, int> m;
+  m.insert(1, 3, 0);
+  m.insert(2, 4, 0);
+  m.stab(2, [](int, int, int &v) { v += 5; });
+  int sum = 0;
+  m.overlap(0, 10, [&](int, int, int &v) { sum += v; });
+  EXPECT_EQ(sum, 10);
+}
+
+TEST(IntervalMap, EraseAndDuplicates) {
+  s21::interval_map<int, int> m;
+  m.insert(5, 10, 1);
+  m.insert(5, 7, 2);
+  m.insert(5, 10, 3);
+  EXPECT_TRUE(m.erase(5, 10));
+  EXPECT_EQ(m.size(), 2U);
+  EXPECT_FALSE(m.erase(5, 9));
+  EXPECT_EQ(collect_overlap(m, 9, 9).size(), 1U);
+  EXPECT_TRUE(m.erase(5, 10));
+  EXPECT_TRUE(collect_overlap(m, 9, 9).empty());
+  EXPECT_FALSE(m.erase(5, 10));
+  EXPECT_TRUE(m.erase(5, 7));
+  EXPECT_TRUE(m.empty());
+}
+
+TEST(IntervalMap, RejectsReversedInterval) {
+  s21::interval_map<int, int> m;
+  EXPECT_THROW(m.insert(5, 4, 0), std::invalid_argument);
+  EXPECT_TRUE(m.empty());
+}
+
+// the subtree maxima must survive rotations on both fix-ups
+TEST(IntervalMap, RandomAgainstBruteForce) {
+  s21::interval_map<int, int> m;
+  std::vector<interval> all;
+  unsigned state = 12345;
+  auto next = [&] {
+    state = state * 1103515245U + 12345U;
+    return static_cast<int>((state >> 8) % 1000);
+  };
+
+  for (int round = 0; round < 4000; ++round) {
+    if (all.empty() || next() % 3) {
+      int lo = next(), len = next() % 60;
+      m.insert(lo, lo + len, 0);
+      all.emplace_back(lo, lo + len, 0);
+    } else {
+      std::size_t idx = next() % all.size();
+      ASSERT_TRUE(m.erase(std::get<0>(all[idx]), std::get<1>(all[idx])));
+      all.erase(all.begin() + idx);
+    }
+    ASSERT_EQ(m.size(), all.size());
+
+    if (round % 16 == 0) {
+      int lo = next(), hi = lo + next() % 40;
+      ASSERT_EQ(collect_overlap(m, lo, hi), brute(all, lo, hi, false));
+      ASSERT_EQ(collect_enclosing(m, lo, hi), brute(all, lo, hi, true));
+    }
+  }
+}
+
+TEST(IntervalMap, Pmr) {
+  counting_resource resource;
+  {
+    s21::pmr::interval_map<int, int> m(&resource);
+    for (int i = 0; i < 50; ++i) m.insert(i, i + 3, i);
+    EXPECT_GT(resource.allocations, 50U);
+    int hits = 0;
+    m.stab(10, [&](int, int, int &) { ++hits; });
+    EXPECT_EQ(hits, 4);
+  }
+  EXPECT_EQ(resource.outstanding, 0U);
+}
+
+TEST(IntervalSet, Queries) {
+  s21::interval_set<double> s;
+  s.insert(0.5, 1.5);
+  s.insert(1.0, 2.0);
+  s.insert(3.0, 4.0);
+
+  std::vector<std::pair<double, double>> got;
+  s.stab(1.25, [&](double lo, double hi) { got.emplace_back(lo, hi); });
+  std::sort(got.begin(), got.end());
+  std::vector<std::pair<double, double>> expected = {{0.5, 1.5}, {1.0, 2.0}};
+  EXPECT_EQ(got, expected);
+
+  got.clear();
+  s.enclosing(3.2, 3.8,
+              [&](double lo, double hi) { got.emplace_back(lo, hi); });
+  expected = {{3.0, 4.0}};
+  EXPECT_EQ(got, expected);
+
+  EXPECT_TRUE(s.erase(3.0, 4.0));
+  got.clear();
+  s.overlap(2.5, 10, [&](double lo, double hi) { got.emplace_back(lo, hi); });
+  EXPECT_TRUE(got.empty());
+  s.clear();
+  EXPECT_TRUE(s.empty());
+}
@@ -1,3 +1,5 @@
+#include <vector>
+
 #include "../proj_tests.hpp"
 
 TEST(ListConstructors, Default) {
@@ -341,3 +343,60 @@ TEST(ListMethods, Unique) {
   l.unique();
   EXPECT_TRUE(l == l2);
 }
+
+TEST(ListAllocator, PmrUsesResource) {
+  counting_resource counter;
+  {
+    s21::pmr::list<int> l({1, 2, 3}, &counter);
+    l.push_front(0);
+    l.pop_back();
+    EXPECT_EQ(l.get_allocator().resource(), &counter);
+    EXPECT_EQ(l.back(), 2);
+
+    s21::pmr::list<int> moved(std::move(l));
+    EXPECT_EQ(moved.get_allocator().resource(), &counter);
+    EXPECT_EQ(moved.size(), 3u);
+
+    counting_resource other;
+    s21::pmr::list<int> target(&other);
+    target = std::move(moved);
+    EXPECT_EQ(target.get_allocator().resource(), &other);
+    EXPECT_EQ(target.size(), 3u);
+    EXPECT_EQ(target.front(), 0);
+  }
+  EXPECT_EQ(counter.outstanding, 0u);
+}
+
+TEST(ListAllocator, AdaptersForwardResource) {
+  char buffer[2048];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  s21::pmr::stack<int> s(&arena);
+  s21::pmr::queue<int> q(&arena);
+  for (int i = 0; i < 10; i++) {
+    s.push(i);
+    q.push(i);
+  }
+  EXPECT_EQ(s.top(), 9);
+  EXPECT_EQ(q.front(), 0);
+  EXPECT_EQ(q.back(), 9);
+}
+
+TEST(ListEmplace, BuildsInPlace) {
+  s21::list<counted_value> l;
+  counted_value::reset();
+  l.emplace_back(1, 2);
+  l.emplace_front(3);
+  auto it = l.emplace(++l.begin(), 4);
+  EXPECT_EQ(it->id, 4);
+  EXPECT_EQ(l.emplace_back(5).id, 5);
+  counted_value keep(6);
+  l.insert_many_back(counted_value(7), keep);
+  l.insert_many_front(counted_value(8), counted_value(9));
+  l.insert_many(l.end(), counted_value(10));
+  EXPECT_EQ(counted_value::copies, 1);
+
+  std::vector<int> ids;
+  for (const auto &value : l) ids.push_back(value.id);
+  EXPECT_EQ(ids, (std::vector<int>{8, 9, 3, 4, 12, 5, 7, 6, 10}));
+}
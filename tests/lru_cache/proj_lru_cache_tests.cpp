@@ -0,0 +1,242 @@
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../proj_tests.hpp"
+
+namespace {
+
+std::uint64_t Step(std::uint64_t &state) {
+  state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return state >> 33;
+}
+
+template <typename Cache>
+std::vector<int> Keys(Cache &cache) {
+  std::vector<int> keys;
+  cache.for_each([&](const int &key, auto &) { keys.push_back(key); });
+  return keys;
+}
+
+}  // namespace
+
+TEST(LruCache, EvictsLeastRecentlyUsed) {
+  s21::lru_cache<int, std::string> cache(3);
+  std::vector<int> evicted;
+  cache.on_evict(
+      [&](const int &key, std::string &) { evicted.push_back(key); });
+  cache.put(1, "one");
+  cache.put(2, "two");
+  cache.put(3, "three");
+  ASSERT_NE(cache.get(1), nullptr);
+  EXPECT_EQ(*cache.get(1), "one");
+  cache.put(4, "four");
+  EXPECT_EQ(evicted, std::vector<int>{2});
+  EXPECT_FALSE(cache.contains(2));
+  EXPECT_EQ(Keys(cache), (std::vector<int>{3, 1, 4}));
+
+  // peek doesn't count as a use, put on a present key does
+  EXPECT_EQ(*cache.peek(3), "three");
+  cache.put(3, "drei");
+  cache.put(5, "five");
+  EXPECT_EQ(evicted, (std::vector<int>{2, 1}));
+  EXPECT_EQ(*cache.get(3), "drei");
+  EXPECT_EQ(cache.get(1), nullptr);
+
+  s21::cache_stats st = cache.stats();
+  EXPECT_EQ(st.hits, 3u);
+  EXPECT_EQ(st.misses, 1u);
+  EXPECT_EQ(st.evictions, 2u);
+}
+
+TEST(LruCache, RandomAgainstModel) {
+  s21::lru_cache<int, int> cache(50);
+  std::list<std::pair<int, int>> order;  // front is the next victim
+  std::unordered_map<int, std::list<std::pair<int, int>>::iterator> index;
+  std::uint64_t state = 41;
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(Step(state) % 120);
+    switch (Step(state) % 4) {
+      case 0:
+      case 1: {
+        int *got = cache.get(key);
+        auto it = index.find(key);
+        ASSERT_EQ(got != nullptr, it != index.end()) << i;
+        if (got) {
+          ASSERT_EQ(*got, it->second->second);
+          order.splice(order.end(), order, it->second);
+        }
+        break;
+      }
+      case 2: {
+        cache.put(key, i);
+        auto it = index.find(key);
+        if (it != index.end()) order.erase(it->second);
+        order.emplace_back(key, i);
+        index[key] = std::prev(order.end());
+        if (order.size() > 50) {
+          index.erase(order.front().first);
+          order.pop_front();
+        }
+        break;
+      }
+      default:
+        ASSERT_EQ(cache.erase(key), index.erase(key) == 1);
+        order.remove_if([key](const auto &item) { return item.first == key; });
+    }
+    ASSERT_EQ(cache.size(), order.size());
+  }
+  std::vector<int> expected;
+  for (const auto &item : order) expected.push_back(item.first);
+  EXPECT_EQ(Keys(cache), expected);
+}
+
+TEST(LfuCache, EvictsLeastFrequentlyUsed) {
+  s21::lfu_cache<int, int> cache(3);
+  cache.put(1, 1);
+  cache.put(2, 2);
+  cache.put(3, 3);
+  cache.get(1);
+  cache.get(1);
+  cache.get(2);
+  cache.put(4, 4);  // 3 has the fewest uses
+  EXPECT_FALSE(cache.contains(3));
+  cache.get(4);
+  cache.put(5, 5);  // 2 and 4 tie, 2 was used longer ago
+  EXPECT_FALSE(cache.contains(2));
+  EXPECT_EQ(Keys(cache), (std::vector<int>{5, 4, 1}));
+}
+
+TEST(LfuCache, RandomAgainstModel) {
+  struct entry {
+    int value;
+    std::size_t uses, last;
+  };
+  s21::lfu_cache<int, int> cache(40);
+  std::unordered_map<int, entry> model;
+  std::uint64_t state = 43;
+  std::size_t tick = 0;
+  for (int i = 0; i < 30000; ++i) {
+    int key = static_cast<int>(Step(state) % 90);
+    std::uint64_t op = Step(state) % 5;
+    if (op < 3) {
+      int *got = cache.get(key);
+      auto it = model.find(key);
+      ASSERT_EQ(got != nullptr, it != model.end()) << i;
+      if (got) {
+        ASSERT_EQ(*got, it->second.value);
+        ++it->second.uses;
+        it->second.last = ++tick;
+      }
+    } else if (op == 3) {
+      cache.put(key, i);
+      auto it = model.find(key);
+      if (it != model.end()) {
+        it->second = {i, it->second.uses + 1, ++tick};
+      } else {
+        if (model.size() == 40) {
+          auto victim = model.begin();
+          for (auto m = model.begin(); m != model.end(); ++m) {
+            if (m->second.uses < victim->second.uses ||
+                (m->second.uses == victim->second.uses &&
+                 m->second.last < victim->second.last))
+              victim = m;
+          }
+          model.erase(victim);
+        }
+        model[key] = {i, 1, ++tick};
+      }
+    } else {
+      ASSERT_EQ(cache.erase(key), model.erase(key) == 1);
+    }
+    ASSERT_EQ(cache.size(), model.size());
+  }
+  // entries come out by use count, then by last use
+  std::size_t uses = 0, last = 0;
+  cache.for_each([&](const int &key, int &) {
+    const entry &e = model.at(key);
+    EXPECT_TRUE(e.uses > uses || (e.uses == uses && e.last > last));
+    uses = e.uses;
+    last = e.last;
+  });
+}
+
+TEST(LruCache, CapacityInBytes) {
+  s21::lru_cache<int, std::string, s21::entry_bytes> cache(1000);
+  for (int i = 0; i < 100; ++i) {
+    cache.put(i, std::string(static_cast<std::size_t>(i * 7 % 300), 'x'));
+    EXPECT_LE(cache.weight(), 1000u);
+  }
+  EXPECT_GT(cache.size(), 2u);
+  std::size_t size = cache.size();
+  cache.put(1000, std::string(2000, 'y'));
+  EXPECT_FALSE(cache.contains(1000));
+  EXPECT_EQ(cache.size(), size);
+  cache.put(99, std::string(2000, 'y'));
+  EXPECT_FALSE(cache.contains(99));
+  EXPECT_EQ(cache.size(), size - 1);
+
+  s21::lru_cache<int, int> small(10);
+  for (int i = 0; i < 10; ++i) small.put(i, i);
+  small.set_capacity(4);
+  EXPECT_EQ(Keys(small), (std::vector<int>{6, 7, 8, 9}));
+}
+
+TEST(LruCache, ReusesNodes) {
+  counting_resource resource;
+  {
+    s21::pmr::lru_cache<int, int> cache(64, &resource);
+    for (int i = 0; i < 64; ++i) cache.put(i, i);
+    std::size_t warm = resource.allocations;
+    std::uint64_t state = 47;
+    for (int i = 0; i < 10000; ++i) {
+      int key = static_cast<int>(Step(state) % 200);
+      if (!cache.get(key)) cache.put(key, i);
+    }
+    cache.erase(5);
+    cache.clear();
+    for (int i = 0; i < 64; ++i) cache.put(i, i);
+    EXPECT_EQ(resource.allocations, warm);
+  }
+  EXPECT_EQ(resource.outstanding, 0u);
+
+  {
+    s21::lfu_cache<int, int, s21::entry_count, std::hash<int>,
+                   std::equal_to<int>,
+                   std::pmr::polymorphic_allocator<std::pair<const int, int>>>
+        cache(32, &resource);
+    std::uint64_t state = 53;
+    for (int i = 0; i < 10000; ++i) {
+      int key = static_cast<int>(Step(state) % 100);
+      if (!cache.get(key)) cache.put(key, i);
+    }
+    cache.shrink_to_fit();
+  }
+  EXPECT_EQ(resource.outstanding, 0u);
+}
+
+TEST(LruCache, MoveAndSwap) {
+  s21::lru_cache<int, int> a(4), b(2);
+  for (int i = 0; i < 4; ++i) a.put(i, i * 10);
+  b.put(100, 1);
+  a.swap(b);
+  EXPECT_EQ(Keys(a), std::vector<int>{100});
+  EXPECT_EQ(Keys(b), (std::vector<int>{0, 1, 2, 3}));
+  EXPECT_EQ(a.capacity(), 2u);
+
+  s21::lru_cache<int, int> moved(std::move(b));
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(*moved.get(0), 0);
+  moved.put(4, 40);
+  EXPECT_EQ(Keys(moved), (std::vector<int>{2, 3, 0, 4}));
+
+  s21::lru_cache<int, int> empty(1);
+  empty = std::move(moved);
+  EXPECT_EQ(Keys(empty), (std::vector<int>{2, 3, 0, 4}));
+  b = std::move(a);
+  EXPECT_EQ(Keys(b), std::vector<int>{100});
+  b.put(7, 7);
+  b.put(8, 8);
+  EXPECT_EQ(Keys(b), (std::vector<int>{7, 8}));
+}
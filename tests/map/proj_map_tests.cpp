@@ -1,3 +1,8 @@
+#include <cmath>
+#include <map>
+#include <memory>
+#include <thread>
+
 #include "../proj_tests.hpp"
 
 TEST(Constructors, Default) {
@@ -140,3 +145,819 @@ TEST(Methods, Contains) {
   EXPECT_EQ(m.contains("okay"), true);
   EXPECT_EQ(m.contains("meme"), false);
 }
+
+namespace {
+using StatsMap = s21::map<int, int, std::allocator<std::pair<const int, int>>,
+                          s21::stats_tree_traits>;
+}  // namespace
+
+TEST(MapStats, CountsHotPath) {
+  StatsMap m;
+  for (int i = 0; i < 1000; ++i) m.insert(i, i);
+  s21::tree_stats st = m.stats();
+  EXPECT_EQ(st.allocations, 1001);
+  EXPECT_GT(st.rotations, 0);
+  EXPECT_GT(st.fix_iterations, 0);
+  EXPECT_GT(st.comparisons, 1000);
+  EXPECT_LE(st.height, 20);
+  EXPECT_GE(st.max_height, st.height);
+
+  m.reset_stats();
+  EXPECT_TRUE(m.contains(500));
+  EXPECT_GT(m.stats().comparisons, 0);
+  EXPECT_EQ(m.stats().rotations, 0);
+}
+
+TEST(MapStats, ConcurrentLookupsCountEveryComparison) {
+  StatsMap m;
+  for (int i = 0; i < 1000; ++i) m.insert(i, i);
+  m.reset_stats();
+  for (int i = 0; i < 1000; ++i) EXPECT_TRUE(m.contains(i));
+  std::size_t one_pass = m.stats().comparisons;
+
+  m.reset_stats();
+  const StatsMap &shared = m;
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t)
+    readers.emplace_back([&] {
+      for (int i = 0; i < 1000; ++i) EXPECT_TRUE(shared.contains(i));
+    });
+  for (auto &reader : readers) reader.join();
+  EXPECT_EQ(m.stats().comparisons, 4 * one_pass);
+}
+
+TEST(MapStats, DisabledAddsNoFields) {
+  EXPECT_LT(sizeof(s21::map<int, int>),
+            sizeof(StatsMap));
+}
+
+TEST(MapBatch, FindMany) {
+  s21::map<int, int> m;
+  for (int i = 0; i < 500; i += 2) m.insert(i, i * 10);
+  std::vector<int> keys;
+  for (int i = 0; i < 100; ++i) keys.push_back((i * 37) % 520);
+  std::vector<s21::map<int, int>::iterator> found;
+  m.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+  ASSERT_EQ(found.size(), keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i] % 2 == 0 && keys[i] < 500) {
+      EXPECT_EQ(*found[i], keys[i] * 10);
+    } else {
+      EXPECT_TRUE(found[i] == m.end());
+    }
+  }
+}
+
+TEST(MapBatch, ContainsMany) {
+  s21::map<std::string, int> m{{"okay", 100}, {"let's", 200}, {"go", 300}};
+  std::vector<std::string> keys = {"go", "stop", "okay", "meme"};
+  bool result[4];
+  m.contains_many(keys.begin(), keys.end(), result);
+  EXPECT_TRUE(result[0]);
+  EXPECT_FALSE(result[1]);
+  EXPECT_TRUE(result[2]);
+  EXPECT_FALSE(result[3]);
+}
+
+namespace {
+// Applies ops to both maps and checks outcomes and the resulting contents
+void CheckBatch(StatsMap &m, std::map<int, int> &ref,
+                const std::vector<StatsMap::batch_op> &ops) {
+  std::vector<s21::batch_outcome> outcomes;
+  m.apply_batch(ops.begin(), ops.end(), std::back_inserter(outcomes));
+  ASSERT_EQ(outcomes.size(), ops.size());
+  for (std::size_t i = 0; i < ops.size(); ++i) {
+    auto it = ref.find(ops[i].key);
+    if (ops[i].kind == s21::batch_kind::erase) {
+      EXPECT_EQ(outcomes[i], it == ref.end() ? s21::batch_outcome::missing
+                                             : s21::batch_outcome::erased);
+      if (it != ref.end()) ref.erase(it);
+    } else {
+      EXPECT_EQ(outcomes[i], it == ref.end() ? s21::batch_outcome::inserted
+                                             : s21::batch_outcome::assigned);
+      ref[ops[i].key] = ops[i].value;
+    }
+  }
+  ASSERT_EQ(m.size(), ref.size());
+  auto it = m.begin();
+  for (const auto &item : ref) {
+    EXPECT_EQ(it->first, item.first);
+    EXPECT_EQ(it->second, item.second);
+    ++it;
+  }
+  unsigned bound = 2;
+  for (std::size_t n = ref.size() + 1; n > 1; n >>= 1) bound += 2;
+  EXPECT_LE(m.stats().height, bound);
+}
+}  // namespace
+
+TEST(MapBatch, SmallBatchFinger) {
+  StatsMap m;
+  std::map<int, int> ref;
+  for (int i = 0; i < 4000; i += 2) {
+    m.insert(i, i);
+    ref[i] = i;
+  }
+  std::vector<StatsMap::batch_op> ops;
+  for (int k = 100; k < 200; k += 5)
+    ops.push_back({k % 3 ? s21::batch_kind::upsert : s21::batch_kind::erase,
+                   k, -k});
+  ops.push_back({s21::batch_kind::upsert, 5000, 1});
+  ops.push_back({s21::batch_kind::erase, 5000, 0});
+  m.reset_stats();
+  CheckBatch(m, ref, ops);
+  EXPECT_LT(m.stats().comparisons, ops.size() * 24);
+}
+
+TEST(MapBatch, LargeBatchMerge) {
+  StatsMap m;
+  std::map<int, int> ref;
+  for (int i = 0; i < 3000; i += 3) {
+    m.insert(i, i);
+    ref[i] = i;
+  }
+  std::vector<StatsMap::batch_op> ops;
+  for (int k = -10; k < 3100; ++k) {
+    if (k % 4 == 0) ops.push_back({s21::batch_kind::erase, k, 0});
+    if (k % 2 == 1) ops.push_back({s21::batch_kind::upsert, k, k * 7});
+  }
+  ops.push_back({s21::batch_kind::upsert, 3200, 1});
+  ops.push_back({s21::batch_kind::upsert, 3200, 2});
+  m.reset_stats();
+  CheckBatch(m, ref, ops);
+  EXPECT_EQ(m.stats().rotations, 0);
+  EXPECT_LT(m.stats().comparisons, 4 * (ops.size() + 1000));
+}
+
+TEST(MapBatch, EraseEverything) {
+  StatsMap m;
+  std::map<int, int> ref;
+  std::vector<StatsMap::batch_op> ops;
+  for (int i = 0; i < 100; ++i) {
+    m.insert(i, i);
+    ref[i] = i;
+    ops.push_back({s21::batch_kind::erase, i, 0});
+  }
+  CheckBatch(m, ref, ops);
+  EXPECT_TRUE(m.empty());
+  ops.clear();
+  ops.push_back({s21::batch_kind::upsert, 1, 1});
+  CheckBatch(m, ref, ops);
+}
+
+TEST(MapBatch, Unsorted) {
+  s21::map<int, int> m;
+  std::vector<s21::map<int, int>::batch_op> ops = {
+      {s21::batch_kind::upsert, 2, 0}, {s21::batch_kind::upsert, 1, 0}};
+  EXPECT_THROW(m.apply_batch(ops), std::invalid_argument);
+}
+
+namespace {
+
+// Copies throw once armed, to fail a batch halfway
+struct fragile_value {
+  static inline bool armed = false;
+  int id = 0;
+
+  fragile_value() = default;
+  explicit fragile_value(int i) : id(i) {}
+  fragile_value(const fragile_value &other) : id(other.id) {
+    if (armed) throw std::runtime_error("copy");
+  }
+  fragile_value &operator=(const fragile_value &other) {
+    if (armed) throw std::runtime_error("copy");
+    id = other.id;
+    return *this;
+  }
+};
+
+}  // namespace
+
+TEST(MapBatch, ThrowingValueKeepsTree) {
+  s21::map<int, fragile_value> m;
+  for (int i = 0; i < 64; ++i) m.insert(i, fragile_value(i));
+  std::vector<s21::map<int, fragile_value>::batch_op> ops;
+  for (int i = 0; i < 60; ++i)
+    ops.push_back({s21::batch_kind::erase, i, fragile_value()});
+  ops.push_back({s21::batch_kind::upsert, 100, fragile_value(100)});
+
+  fragile_value::armed = true;
+  EXPECT_THROW(m.apply_batch(ops), std::runtime_error);
+  fragile_value::armed = false;
+
+  // nothing was erased, and every node is still live
+  EXPECT_EQ(m.size(), 64u);
+  int expected = 0;
+  for (auto it = m.begin(); it != m.end(); ++it) {
+    EXPECT_EQ(it->first, expected);
+    EXPECT_EQ(it->second.id, expected++);
+  }
+  EXPECT_EQ(expected, 64);
+  m.apply_batch(ops);
+  EXPECT_EQ(m.size(), 5u);
+  EXPECT_EQ(m.at(100).id, 100);
+}
+
+TEST(MapAllocator, PmrUsesResource) {
+  counting_resource counter;
+  {
+    s21::pmr::map<int, std::string> m(&counter);
+    for (int i = 0; i < 100; ++i) m.insert(i, std::to_string(i));
+    EXPECT_EQ(m.get_allocator().resource(), &counter);
+    EXPECT_GT(counter.allocations, 100u);
+
+    m.erase(m.find(10));
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    m.insert(1, "one");
+    EXPECT_EQ(m.at(1), "one");
+  }
+  EXPECT_EQ(counter.outstanding, 0u);
+}
+
+TEST(MapAllocator, PmrCopyMoveSwap) {
+  counting_resource first, second;
+  s21::pmr::map<int, int> a({{1, 10}, {2, 20}, {3, 30}}, &first);
+
+  s21::pmr::map<int, int> copy(a, &second);
+  EXPECT_EQ(copy.get_allocator().resource(), &second);
+  EXPECT_TRUE(copy == a);
+
+  std::size_t before = first.allocations;
+  s21::pmr::map<int, int> stolen(std::move(a));
+  EXPECT_EQ(first.allocations, before);
+  EXPECT_EQ(stolen.at(2), 20);
+
+  // the target keeps its resource and takes copies of the elements
+  copy = std::move(stolen);
+  EXPECT_EQ(copy.get_allocator().resource(), &second);
+  EXPECT_EQ(copy.at(3), 30);
+
+  s21::pmr::map<int, int> other({{7, 70}}, &second);
+  other.swap(copy);
+  EXPECT_EQ(other.size(), 3u);
+  EXPECT_EQ(copy.at(7), 70);
+}
+
+namespace {
+using SumMap =
+    s21::map<long, long, std::allocator<std::pair<const long, long>>,
+             s21::aggregate_tree_traits<s21::sum_monoid<long>>>;
+
+struct SumStatsTraits : s21::aggregate_tree_traits<s21::sum_monoid<long>> {
+  static constexpr bool collect_stats = true;
+};
+
+long BruteSum(const std::map<long, long> &ref, long lo, long hi) {
+  long sum = 0;
+  for (auto it = ref.lower_bound(lo); it != ref.end() && it->first < hi; ++it)
+    sum += it->second;
+  return sum;
+}
+}  // namespace
+
+TEST(MapAggregate, HalfOpenRange) {
+  SumMap m;
+  for (long k = 0; k < 10; ++k) m.insert(k, k * 10);
+  EXPECT_EQ(m.aggregate(2, 5), 20 + 30 + 40);
+  EXPECT_EQ(m.aggregate(0, 10), 450);
+  EXPECT_EQ(m.aggregate(-100, 100), 450);
+  EXPECT_EQ(m.aggregate(5, 5), 0);
+  EXPECT_EQ(m.aggregate(7, 3), 0);
+  EXPECT_EQ(SumMap().aggregate(0, 1), 0);
+
+  m.insert_or_assign(3, 1000);
+  EXPECT_EQ(m.aggregate(2, 5), 20 + 1000 + 40);
+  m.erase(m.find(4));
+  EXPECT_EQ(m.aggregate(2, 5), 20 + 1000);
+}
+
+TEST(MapAggregate, ValuesReadOnly) {
+  SumMap m = {{1, 10}, {2, 20}};
+  // a write past the folds would leave aggregate() stale
+  EXPECT_TRUE((std::is_same<decltype(m.at(1)), const long &>::value));
+  EXPECT_TRUE((std::is_same<decltype(m[1]), const long &>::value));
+  EXPECT_TRUE((std::is_same<decltype(*m.begin()), const long &>::value));
+  bool writable = true;
+  m.for_each([&](const long &, auto &value) {
+    writable = !std::is_const<std::remove_reference_t<decltype(value)>>::value;
+  });
+  EXPECT_FALSE(writable);
+  EXPECT_EQ(m[3], 0);
+  EXPECT_EQ(m.aggregate(0, 4), 30);
+
+  s21::map<long, long> plain;
+  EXPECT_TRUE((std::is_same<decltype(plain.at(1)), long &>::value));
+  EXPECT_TRUE((std::is_same<decltype(*plain.begin()), long &>::value));
+}
+
+TEST(MapAggregate, MinMaxCount) {
+  s21::map<int, int, std::allocator<std::pair<const int, int>>,
+           s21::aggregate_tree_traits<s21::min_monoid<int>>>
+      lows = {{1, 7}, {2, -3}, {5, 4}, {9, 0}};
+  EXPECT_EQ(lows.aggregate(0, 2), 7);
+  EXPECT_EQ(lows.aggregate(0, 10), -3);
+  EXPECT_EQ(lows.aggregate(3, 9), 4);
+
+  s21::map<int, int, std::allocator<std::pair<const int, int>>,
+           s21::aggregate_tree_traits<s21::max_monoid<int>>>
+      highs = {{1, 7}, {2, -3}, {5, 4}, {9, 0}};
+  EXPECT_EQ(highs.aggregate(2, 10), 4);
+
+  s21::map<int, std::string,
+           std::allocator<std::pair<const int, std::string>>,
+           s21::aggregate_tree_traits<s21::count_monoid>>
+      names = {{1, "a"}, {4, "b"}, {6, "c"}, {8, "d"}};
+  EXPECT_EQ(names.aggregate(2, 8), 2U);
+  EXPECT_EQ(names.aggregate(0, 100), 4U);
+}
+
+// every change path has to keep the subtree sums right
+TEST(MapAggregate, RandomAgainstStdMap) {
+  SumMap m;
+  std::map<long, long> ref;
+  std::uint64_t state = 7;
+  auto next = [&] {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<long>((state >> 33) % 2000);
+  };
+
+  for (int round = 0; round < 3000; ++round) {
+    long key = next();
+    switch (next() % 4) {
+      case 0:
+        m.insert(key, key * 3 - 7);
+        ref.insert({key, key * 3 - 7});
+        break;
+      case 1:
+        m.insert_or_assign(key, round);
+        ref[key] = round;
+        break;
+      case 2:
+        if (ref.erase(key)) m.erase(m.find(key));
+        break;
+      default:
+        // a wide batch now and then takes the merge path
+        long step = round % 300 ? 3 : 1, span = round % 300 ? 40 : 2000;
+        std::vector<SumMap::batch_op> ops;
+        for (long k = key; k < key + span; k += step) {
+          if (k % 2) {
+            ops.push_back({s21::batch_kind::upsert, k, k});
+            ref[k] = k;
+          } else {
+            ops.push_back({s21::batch_kind::erase, k, 0});
+            ref.erase(k);
+          }
+        }
+        m.apply_batch(ops);
+    }
+
+    long lo = next(), hi = lo + next() / 4;
+    ASSERT_EQ(m.aggregate(lo, hi), BruteSum(ref, lo, hi)) << round;
+  }
+  ASSERT_EQ(m.size(), ref.size());
+  EXPECT_EQ(m.aggregate(-1, 5000), BruteSum(ref, -1, 5000));
+  SumMap copy(m);
+  EXPECT_EQ(copy.aggregate(100, 1500), BruteSum(ref, 100, 1500));
+}
+
+TEST(MapAggregate, LogarithmicWork) {
+  s21::map<long, long, std::allocator<std::pair<const long, long>>,
+           SumStatsTraits>
+      m;
+  for (long k = 0; k < 100000; ++k) m.insert(k, 1);
+  m.reset_stats();
+  EXPECT_EQ(m.aggregate(123, 98765), 98765 - 123);
+  EXPECT_LE(m.stats().comparisons, 3 * m.stats().height);
+}
+
+TEST(MapScan, ForEachInRange) {
+  s21::map<int, int> m;
+  for (int k = 0; k < 1000; k += 2) m.insert(k, k * 2);
+
+  std::vector<int> keys;
+  m.for_each_in_range(101, 120, [&](const int &key, int &value) {
+    EXPECT_EQ(value, key * 2);
+    keys.push_back(key);
+  });
+  std::vector<int> expected = {102, 104, 106, 108, 110,
+                               112, 114, 116, 118};
+  EXPECT_EQ(keys, expected);
+
+  m.for_each_in_range(0, 10, [](const int &, int &value) { value = -1; });
+  EXPECT_EQ(m.at(8), -1);
+  EXPECT_EQ(m.at(10), 20);
+
+  int visited = 0;
+  m.for_each_in_range(-50, 5000, [&](const int &, int &) {
+    return ++visited < 7;
+  });
+  EXPECT_EQ(visited, 7);
+
+  visited = 0;
+  m.for_each_in_range(500, 500, [&](const int &, int &) { ++visited; });
+  m.for_each_in_range(2000, 3000, [&](const int &, int &) { ++visited; });
+  EXPECT_EQ(visited, 0);
+}
+
+TEST(MapScan, ForEachMatchesIterators) {
+  s21::map<int, int> m;
+  std::uint64_t state = 99;
+  for (int i = 0; i < 5000; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    m.insert(static_cast<int>(state >> 40), i);
+  }
+  std::vector<std::pair<int, int>> by_iterator, by_callback;
+  for (auto it = m.begin(); it != m.end(); ++it)
+    by_iterator.emplace_back(it->first, it->second);
+  const s21::map<int, int> &view = m;
+  view.for_each([&](const int &key, const int &value) {
+    by_callback.emplace_back(key, value);
+  });
+  EXPECT_EQ(by_callback, by_iterator);
+  s21::map<int, int>().for_each([](const int &, int &) { ADD_FAILURE(); });
+}
+
+namespace {
+template <typename Map, typename Fn, typename = void>
+struct visits_with : std::false_type {};
+
+template <typename Map, typename Fn>
+struct visits_with<Map, Fn,
+                   std::void_t<decltype(std::declval<Map &>().for_each(
+                       std::declval<Fn>()))>> : std::true_type {};
+
+template <typename Map, typename Fn, typename = void>
+struct visits_range_with : std::false_type {};
+
+template <typename Map, typename Fn>
+struct visits_range_with<
+    Map, Fn,
+    std::void_t<decltype(std::declval<Map &>().for_each_in_range(
+        0, 1, std::declval<Fn>()))>> : std::true_type {};
+
+using MutableKey = void (*)(int &, int &);
+using ConstKey = void (*)(const int &, int &);
+}  // namespace
+
+TEST(MapScan, KeysStayConst) {
+  using plain = s21::map<int, int>;
+  EXPECT_FALSE((visits_with<plain, MutableKey>::value));
+  EXPECT_FALSE((visits_range_with<plain, MutableKey>::value));
+  EXPECT_TRUE((visits_with<plain, ConstKey>::value));
+  EXPECT_TRUE((visits_range_with<plain, ConstKey>::value));
+  EXPECT_FALSE((visits_with<const plain, ConstKey>::value));
+
+  plain m = {{1, 10}, {2, 20}};
+  bool mutable_key = false;
+  m.for_each([&](auto &key, int &value) {
+    using key_type = std::remove_reference_t<decltype(key)>;
+    mutable_key |= !std::is_const<key_type>::value;
+    value += key;
+  });
+  EXPECT_FALSE(mutable_key);
+  EXPECT_EQ(m.at(2), 22);
+}
+
+namespace {
+using PrefixMap = s21::map<std::string, int,
+                           std::allocator<std::pair<const std::string, int>>,
+                           s21::prefix_tree_traits>;
+}  // namespace
+
+TEST(MapPrefix, PrefixOrderMatchesStrings) {
+  std::vector<std::string> keys = {
+      "",         "a",        "ab",   std::string("ab\0", 3), "abcdefgh",
+      "abcdefgh0", "abcdefgi", "\xff", "\x7fz",               "zzzzzzzzzzzz"};
+  for (const auto &lhs : keys)
+    for (const auto &rhs : keys) {
+      auto l = s21::key_prefix<std::string>::of(lhs);
+      auto r = s21::key_prefix<std::string>::of(rhs);
+      if (l < r) {
+        EXPECT_LT(lhs, rhs);
+      } else if (r < l) {
+        EXPECT_LT(rhs, lhs);
+      }
+    }
+}
+
+TEST(MapPrefix, AgreesWithStdMap) {
+  PrefixMap m;
+  std::map<std::string, int> ref;
+  std::uint64_t state = 3;
+  const char *hosts[] = {"https://www.example.com/", "https://api.",
+                         "cdn.", "", "https://www.example.org/"};
+  for (int i = 0; i < 3000; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    std::string key = hosts[(state >> 20) % 5] +
+                      std::to_string((state >> 33) % 700);
+    m.insert_or_assign(key, i);
+    ref[key] = i;
+  }
+  ASSERT_EQ(m.size(), ref.size());
+  auto it = m.begin();
+  for (const auto &item : ref) {
+    EXPECT_EQ(it->first, item.first);
+    EXPECT_EQ(m.at(item.first), item.second);
+    ++it;
+  }
+  EXPECT_FALSE(m.contains("https://www.example.com/9999"));
+  EXPECT_FALSE(m.contains("cdn"));
+}
+
+namespace {
+struct AvlStatsTraits : s21::avl_tree_traits {
+  static constexpr bool collect_stats = true;
+};
+struct WavlStatsTraits : s21::wavl_tree_traits {
+  static constexpr bool collect_stats = true;
+};
+template <typename Traits>
+using BalancedMap =
+    s21::map<int, int, std::allocator<std::pair<const int, int>>, Traits>;
+
+double AvlHeightBound(std::size_t n) { return 1.4405 * std::log2(n + 2.0); }
+
+// Random inserts and erases mirrored into std::map, the height is checked
+// against bound(size) along the way
+template <typename Map, typename Bound>
+void RandomUpdates(Map &m, Bound bound, int rounds, int range) {
+  std::map<int, int> ref;
+  for (auto it = m.begin(); it != m.end(); ++it) ref[it->first] = it->second;
+  std::uint64_t state = 17;
+  for (int i = 0; i < rounds; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    int key = static_cast<int>((state >> 33) % range);
+    if ((state >> 20) % 3) {
+      m.insert_or_assign(key, i);
+      ref[key] = i;
+    } else {
+      auto it = m.find(key);
+      if (it != m.end()) m.erase(it);
+      ref.erase(key);
+    }
+    if (i % 512 == 0) {
+      ASSERT_LE(m.stats().height, bound(ref.size())) << i;
+    }
+  }
+  ASSERT_EQ(m.size(), ref.size());
+  auto it = m.begin();
+  for (const auto &item : ref) {
+    ASSERT_EQ(it->first, item.first);
+    ASSERT_EQ(it->second, item.second);
+    ++it;
+  }
+}
+}  // namespace
+
+TEST(MapBalance, AvlHeight) {
+  BalancedMap<AvlStatsTraits> m;
+  for (int i = 0; i < 4096; ++i) m.insert(i, i);
+  EXPECT_LE(m.stats().height, AvlHeightBound(m.size()));
+  // an insert never needs more than a double rotation
+  EXPECT_LE(m.stats().rotations, 2u * 4096);
+  RandomUpdates(m, AvlHeightBound, 30000, 5000);
+}
+
+TEST(MapBalance, WavlHeight) {
+  BalancedMap<WavlStatsTraits> m;
+  for (int i = 0; i < 4096; ++i) m.insert(i, i);
+  // without erases a WAVL tree is an AVL tree
+  EXPECT_LE(m.stats().height, AvlHeightBound(m.size()));
+  m.reset_stats();
+  RandomUpdates(
+      m, [](std::size_t n) { return 2 * std::log2(n + 1.0) + 1; }, 30000,
+      5000);
+  EXPECT_LE(m.stats().rotations, 2u * 30000);
+}
+
+TEST(MapBalance, DrainAndRefill) {
+  BalancedMap<WavlStatsTraits> wavl;
+  BalancedMap<AvlStatsTraits> avl;
+  for (int i = 0; i < 2000; ++i) {
+    wavl.insert(i, i);
+    avl.insert(i, i);
+  }
+  for (int i = 0; i < 2000; i += 2) {
+    wavl.erase(wavl.find(i));
+    avl.erase(avl.find(i));
+  }
+  for (int i = 1; i < 2000; i += 2) {
+    wavl.erase(wavl.find(i));
+    avl.erase(avl.find(i));
+  }
+  EXPECT_TRUE(wavl.empty());
+  EXPECT_TRUE(avl.empty());
+  for (int i = 0; i < 100; ++i) {
+    wavl.insert(i, i);
+    avl.insert(i, i);
+  }
+  EXPECT_LE(wavl.stats().height, AvlHeightBound(100));
+  EXPECT_LE(avl.stats().height, AvlHeightBound(100));
+}
+
+TEST(MapBalance, BatchRebuildKeepsRanks) {
+  BalancedMap<AvlStatsTraits> m;
+  std::vector<BalancedMap<AvlStatsTraits>::batch_op> ops;
+  for (int k = 0; k < 3000; ++k)
+    ops.push_back({s21::batch_kind::upsert, k, k});
+  std::vector<s21::batch_outcome> outcomes;
+  m.apply_batch(ops.begin(), ops.end(), std::back_inserter(outcomes));
+  EXPECT_EQ(m.stats().rotations, 0u);
+  RandomUpdates(m, AvlHeightBound, 20000, 6000);
+}
+
+namespace {
+using BloomMap = s21::map<int, int, std::allocator<std::pair<const int, int>>,
+                          s21::bloom_tree_traits<10, true>>;
+using QuietBloomMap =
+    s21::map<int, int, std::allocator<std::pair<const int, int>>,
+             s21::bloom_tree_traits<>>;
+}  // namespace
+
+TEST(MapBloom, RejectsMostMisses) {
+  BloomMap m;
+  for (int i = 0; i < 20000; i += 2) m.insert(i, i);
+  m.reset_bloom_stats();
+  for (int i = 1; i < 20000; i += 2) EXPECT_FALSE(m.contains(i));
+  s21::bloom_filter_stats st = m.bloom_stats();
+  EXPECT_EQ(st.rejected + st.passed, 10000u);
+  EXPECT_EQ(st.false_positives, st.passed);
+  EXPECT_LT(st.passed, 200u);
+  EXPECT_GT(st.bytes, 0u);
+
+  m.reset_bloom_stats();
+  for (int i = 0; i < 20000; i += 2) EXPECT_EQ(m.at(i), i);
+  EXPECT_EQ(m.bloom_stats().rejected, 0u);
+  EXPECT_EQ(m.bloom_stats().false_positives, 0u);
+}
+
+TEST(MapBloom, CountsBatchedAndConcurrentLookups) {
+  BloomMap m;
+  for (int i = 0; i < 20000; i += 2) m.insert(i, i);
+  std::vector<int> misses;
+  for (int i = 1; i < 20000; i += 2) misses.push_back(i);
+
+  m.reset_bloom_stats();
+  std::unique_ptr<bool[]> result(new bool[misses.size()]);
+  m.contains_many(misses.begin(), misses.end(), result.get());
+  s21::bloom_filter_stats st = m.bloom_stats();
+  EXPECT_EQ(st.rejected + st.passed, misses.size());
+  EXPECT_EQ(st.false_positives, st.passed);
+
+  // const lookups from several threads count every probe
+  m.reset_bloom_stats();
+  const BloomMap &shared = m;
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t)
+    readers.emplace_back([&] {
+      for (int key : misses) EXPECT_FALSE(shared.contains(key));
+    });
+  for (auto &reader : readers) reader.join();
+  st = m.bloom_stats();
+  EXPECT_EQ(st.rejected + st.passed, 4 * misses.size());
+  EXPECT_EQ(st.false_positives, st.passed);
+}
+
+TEST(MapBloom, NeverMissesAfterUpdates) {
+  BloomMap m;
+  std::map<int, int> ref;
+  std::uint64_t state = 29;
+  for (int i = 0; i < 40000; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    int key = static_cast<int>((state >> 33) % 8000);
+    if ((state >> 20) % 3) {
+      m.insert_or_assign(key, i);
+      ref[key] = i;
+    } else {
+      auto it = m.find(key);
+      if (it != m.end()) m.erase(it);
+      ref.erase(key);
+    }
+  }
+  // a large batch relinks the whole tree
+  std::vector<BloomMap::batch_op> ops;
+  for (int k = 8000; k < 12000; ++k) {
+    ops.push_back({s21::batch_kind::upsert, k, k});
+    ref[k] = k;
+  }
+  m.apply_batch(ops);
+
+  BloomMap copy(m);
+  BloomMap moved(std::move(copy));
+  BloomMap swapped;
+  swapped.swap(moved);
+  for (BloomMap *map : {&m, &swapped}) {
+    ASSERT_EQ(map->size(), ref.size());
+    for (int key = 0; key < 12000; ++key)
+      ASSERT_EQ(map->contains(key), ref.count(key) == 1) << key;
+  }
+  EXPECT_GT(m.bloom_stats().rebuilds, 1u);
+
+  m.clear();
+  EXPECT_FALSE(m.contains(100));
+  m.insert(100, 1);
+  EXPECT_TRUE(m.contains(100));
+}
+
+TEST(MapBloom, ShrinksAfterErases) {
+  BloomMap m;
+  for (int i = 0; i < 50000; ++i) m.insert(i, i);
+  std::size_t full = m.bloom_stats().bytes;
+  for (int i = 0; i < 50000; ++i)
+    if (i % 10) m.erase(m.find(i));
+  EXPECT_LT(m.bloom_stats().bytes, full / 4);
+  m.reset_bloom_stats();
+  for (int i = 0; i < 50000; ++i) EXPECT_EQ(m.contains(i), i % 10 == 0);
+  EXPECT_LT(m.bloom_stats().false_positives, 1000u);
+}
+
+TEST(MapBloom, PmrReturnsFilterMemory) {
+  counting_resource resource;
+  {
+    s21::map<int, int,
+             std::pmr::polymorphic_allocator<std::pair<const int, int>>,
+             s21::bloom_tree_traits<16>>
+        m(&resource);
+    for (int i = 0; i < 5000; ++i) m.insert(i * 3, i);
+    EXPECT_FALSE(m.contains(1));
+    EXPECT_TRUE(m.contains(2997));
+  }
+  EXPECT_EQ(resource.outstanding, 0u);
+}
+
+TEST(MapBloom, DisabledAddsNoFields) {
+  EXPECT_LT(sizeof(s21::map<int, int>), sizeof(QuietBloomMap));
+}
+
+TEST(MapBloom, LookupCountsAreOptIn) {
+  // without the counters a lookup writes nothing in the tree object
+  EXPECT_LT(sizeof(QuietBloomMap), sizeof(BloomMap));
+  QuietBloomMap m;
+  for (int i = 0; i < 2000; i += 2) m.insert(i, i);
+  for (int i = 0; i < 2000; ++i) EXPECT_EQ(m.contains(i), i % 2 == 0);
+  s21::bloom_filter_stats st = m.bloom_stats();
+  EXPECT_EQ(st.rejected + st.passed + st.false_positives, 0u);
+  EXPECT_GT(st.rebuilds, 0u);
+  EXPECT_GT(st.bytes, 0u);
+}
+
+TEST(MapEmplace, Forms) {
+  s21::map<int, counted_value> m;
+  counted_value::reset();
+  EXPECT_TRUE(m.emplace(1, counted_value(10)).second);
+  EXPECT_TRUE(m.emplace(std::make_pair(2, counted_value(20))).second);
+  auto placed = m.emplace(std::piecewise_construct, std::forward_as_tuple(3),
+                          std::forward_as_tuple(3, 0));
+  EXPECT_TRUE(placed.second);
+  EXPECT_EQ(*placed.first, counted_value(30));
+  EXPECT_EQ(counted_value::copies, 0);
+
+  // a taken key leaves the arguments alone
+  counted_value spare(99);
+  EXPECT_FALSE(m.try_emplace(1, std::move(spare)).second);
+  EXPECT_FALSE(m.emplace(2, counted_value(0)).second);
+  EXPECT_EQ(spare.id, 99);
+  EXPECT_EQ(m[1].id, 10);
+  EXPECT_EQ(m[2].id, 20);
+
+  EXPECT_TRUE(m.try_emplace(4, 4, 0).second);
+  EXPECT_EQ(m[5].id, 0);
+  EXPECT_EQ(m.size(), 5u);
+  EXPECT_EQ(counted_value::copies, 0);
+
+  auto inserted = m.insert(6, counted_value(60));
+  EXPECT_EQ(*inserted.first, counted_value(60));
+  auto assigned = m.insert_or_assign(6, counted_value(61));
+  EXPECT_FALSE(assigned.second);
+  EXPECT_EQ(*assigned.first, counted_value(61));
+
+  auto many = m.insert_many(std::make_pair(7, counted_value(70)),
+                            std::make_pair(1, counted_value(11)));
+  EXPECT_TRUE(many[0].second);
+  EXPECT_FALSE(many[1].second);
+}
+
+TEST(MapEmplace, Hint) {
+  using stat_map =
+      s21::map<int, int, std::allocator<std::pair<const int, int>>,
+               s21::stats_tree_traits>;
+  stat_map m;
+  for (int i = 0; i < 1000; ++i) m.emplace_hint(m.end(), i, i * 2);
+  EXPECT_LE(m.stats().comparisons, 1000u);
+  EXPECT_EQ(m.size(), 1000u);
+
+  // in the middle, before an existing key and with a useless hint
+  stat_map gaps;
+  for (int i = 0; i < 100; i += 2) gaps.emplace_hint(gaps.end(), i, i);
+  auto before = gaps.find(50);
+  EXPECT_EQ(*gaps.emplace_hint(before, 49, -49), -49);
+  EXPECT_EQ(*gaps.emplace_hint(gaps.begin(), 77, -77), -77);
+  EXPECT_EQ(*gaps.emplace_hint(gaps.end(), 50, 0), 50);
+  EXPECT_EQ(gaps.size(), 52u);
+  int prev = -1;
+  for (auto it = gaps.begin(); it != gaps.end(); ++it) {
+    EXPECT_LT(prev, it->first);
+    prev = it->first;
+  }
+}
@@ -177,3 +177,218 @@ TEST(InitialMultiset2, InsertMany) {
   ss.insert_many(1, 2, 3, 4);
   ASSERT_EQ(ss.size(), 4);
 }
+
+TEST(MultisetStats, Subtest_1) {
+  s21::multiset<int, std::less<int>, std::allocator<int>,
+                s21::stats_tree_traits>
+      ss;
+  for (int i = 0; i < 64; ++i) ss.insert(i % 4);
+  s21::tree_stats st = ss.stats();
+  EXPECT_EQ(st.allocations, 65);
+  EXPECT_GT(st.rotations, 0);
+  EXPECT_LE(st.height, 12);
+}
+
+TEST(MultisetBatch, Subtest_1) {
+  s21::multiset<int> ss = {1, 3, 3, 5};
+  std::vector<s21::multiset<int>::batch_op> ops = {
+      {s21::batch_kind::upsert, 3},
+      {s21::batch_kind::erase, 3},
+      {s21::batch_kind::erase, 4},
+      {s21::batch_kind::upsert, 6}};
+  s21::vector<s21::batch_outcome> outcomes = ss.apply_batch(ops);
+  EXPECT_EQ(outcomes[0], s21::batch_outcome::inserted);
+  EXPECT_EQ(outcomes[1], s21::batch_outcome::erased);
+  EXPECT_EQ(outcomes[2], s21::batch_outcome::missing);
+  EXPECT_EQ(outcomes[3], s21::batch_outcome::inserted);
+  EXPECT_EQ(ss.size(), 5);
+  EXPECT_EQ(ss.count(3), 2);
+}
+
+TEST(MultisetAllocator, PmrUsesResource) {
+  counting_resource counter;
+  {
+    s21::pmr::multiset<int> ms({1, 1, 2, 2, 2}, &counter);
+    s21::pmr::multiset<int> target(&counter);
+    target = ms;
+    EXPECT_EQ(target.size(), 5u);
+    EXPECT_EQ(target.count(2), 3u);
+    EXPECT_EQ(target.get_allocator().resource(), &counter);
+  }
+  EXPECT_EQ(counter.outstanding, 0u);
+}
+
+TEST(MultisetScan, ForEachVisitsDuplicates) {
+  s21::multiset<int> ms = {5, 1, 3, 3, 7, 3, 9, 5};
+  std::vector<int> all, range;
+  ms.for_each([&](const int &key) { all.push_back(key); });
+  std::vector<int> expected = {1, 3, 3, 3, 5, 5, 7, 9};
+  EXPECT_EQ(all, expected);
+
+  ms.for_each_in_range(3, 7, [&](const int &key) { range.push_back(key); });
+  expected = {3, 3, 3, 5, 5};
+  EXPECT_EQ(range, expected);
+}
+
+namespace {
+using CountedMultiset = s21::multiset<int, std::less<int>, std::allocator<int>,
+                                      s21::counted_tree_traits>;
+
+struct CountedStatsTraits : s21::counted_tree_traits {
+  static constexpr bool collect_stats = true;
+};
+}  // namespace
+
+TEST(CountedMultiset, IterationYieldsEachCopy) {
+  CountedMultiset ms = {5, 1, 3, 3, 7, 3, 9, 5};
+  EXPECT_EQ(ms.size(), 8u);
+  std::vector<int> forward;
+  for (auto it = ms.begin(); it != ms.end(); ++it) forward.push_back(*it);
+  std::vector<int> expected = {1, 3, 3, 3, 5, 5, 7, 9};
+  EXPECT_EQ(forward, expected);
+
+  std::vector<int> backward;
+  auto it = ms.end();
+  do {
+    --it;
+    backward.push_back(*it);
+  } while (it != ms.begin());
+  std::reverse(backward.begin(), backward.end());
+  EXPECT_EQ(backward, expected);
+
+  std::vector<int> scanned;
+  ms.for_each_in_range(3, 6, [&](const int &key) { scanned.push_back(key); });
+  expected = {3, 3, 3, 5, 5};
+  EXPECT_EQ(scanned, expected);
+}
+
+TEST(CountedMultiset, CopyIndexOnlyWhenCounted) {
+  using plain = s21::multiset<int>;
+  EXPECT_EQ(sizeof(plain::iterator), sizeof(plain::tree_type::iterator));
+  EXPECT_EQ(sizeof(plain::const_iterator),
+            sizeof(plain::tree_type::const_iterator));
+  EXPECT_GT(sizeof(CountedMultiset::iterator),
+            sizeof(CountedMultiset::tree_type::iterator));
+}
+
+TEST(CountedMultiset, InsertEraseCount) {
+  CountedMultiset ms;
+  for (int i = 0; i < 1000; ++i) ms.insert(i % 7);
+  EXPECT_EQ(ms.size(), 1000u);
+  EXPECT_EQ(ms.count(3), 143u);
+  EXPECT_EQ(ms.count(6), 142u);
+  EXPECT_EQ(ms.count(42), 0u);
+  EXPECT_TRUE(ms.contains(0));
+
+  auto it = ms.insert(3);
+  EXPECT_EQ(*it, 3);
+  EXPECT_EQ(ms.count(3), 144u);
+
+  ms.erase(ms.find(3));
+  EXPECT_EQ(ms.count(3), 143u);
+  EXPECT_EQ(ms.size(), 1000u);
+
+  CountedMultiset single = {8};
+  single.erase(single.find(8));
+  EXPECT_TRUE(single.empty());
+  EXPECT_FALSE(single.contains(8));
+}
+
+TEST(CountedMultiset, Bounds) {
+  CountedMultiset ms = {1, 2, 2, 2, 4};
+  auto range = ms.equal_range(2);
+  int copies = 0;
+  for (auto it = range.first; it != range.second; ++it) ++copies;
+  EXPECT_EQ(copies, 3);
+  EXPECT_EQ(*ms.lower_bound(2), 2);
+  EXPECT_EQ(*ms.upper_bound(2), 4);
+  EXPECT_TRUE(ms.lower_bound(2) == ms.find(2));
+}
+
+TEST(CountedMultiset, CopyMoveSwapBatch) {
+  CountedMultiset ms = {1, 1, 2};
+  CountedMultiset copy(ms);
+  EXPECT_TRUE(copy == ms);
+  CountedMultiset moved(std::move(copy));
+  EXPECT_EQ(moved.size(), 3u);
+  EXPECT_EQ(copy.size(), 0u);
+
+  CountedMultiset other = {9};
+  other.swap(moved);
+  EXPECT_EQ(other.size(), 3u);
+  EXPECT_EQ(moved.size(), 1u);
+
+  std::vector<CountedMultiset::batch_op> ops = {{s21::batch_kind::upsert, 1},
+                                                {s21::batch_kind::erase, 2},
+                                                {s21::batch_kind::erase, 3}};
+  s21::vector<s21::batch_outcome> outcomes = other.apply_batch(ops);
+  EXPECT_EQ(outcomes[0], s21::batch_outcome::inserted);
+  EXPECT_EQ(outcomes[1], s21::batch_outcome::erased);
+  EXPECT_EQ(outcomes[2], s21::batch_outcome::missing);
+  EXPECT_EQ(other.count(1), 3u);
+  EXPECT_EQ(other.size(), 3u);
+  other.clear();
+  EXPECT_EQ(other.size(), 0u);
+}
+
+TEST(CountedMultiset, OneNodePerDistinctKey) {
+  s21::multiset<int, std::less<int>, std::allocator<int>, CountedStatsTraits>
+      ms;
+  for (int i = 0; i < 100000; ++i) ms.insert(i % 100);
+  EXPECT_EQ(ms.size(), 100000u);
+  EXPECT_EQ(ms.stats().allocations, 101);
+  ms.reset_stats();
+  EXPECT_EQ(ms.count(50), 1000u);
+  EXPECT_LT(ms.stats().comparisons, 40);
+}
+
+TEST(MultisetBalance, WavlDuplicates) {
+  s21::multiset<int, std::less<int>, std::allocator<int>,
+                s21::wavl_tree_traits>
+      ms;
+  std::multiset<int> ref;
+  std::uint64_t state = 23;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    int key = 1 + static_cast<int>((state >> 33) % 300);
+    if ((state >> 20) % 3) {
+      ms.insert(key);
+      ref.insert(key);
+    } else {
+      auto it = ms.find(key);
+      if (it != ms.end()) ms.erase(it);
+      auto rit = ref.find(key);
+      if (rit != ref.end()) ref.erase(rit);
+    }
+  }
+  ASSERT_EQ(ms.size(), ref.size());
+  auto it = ms.begin();
+  for (int key : ref) {
+    EXPECT_EQ(*it, key);
+    ++it;
+  }
+  for (int key = 1; key <= 300; ++key) EXPECT_EQ(ms.count(key), ref.count(key));
+}
+
+TEST(MultisetEmplace, EqualKeys) {
+  s21::multiset<std::string> ms;
+  ms.emplace(2, 'b');
+  ms.emplace_hint(ms.end(), "cc");
+  ms.emplace_hint(ms.find("bb"), "bb");
+  ms.emplace_hint(ms.begin(), "cc");
+  auto many = ms.insert_many(std::string("aa"), std::string("bb"));
+  EXPECT_TRUE(many[0].second && many[1].second);
+  EXPECT_EQ(ms.size(), 6u);
+  EXPECT_EQ(ms.count("bb"), 3u);
+  EXPECT_EQ(ms.count("cc"), 2u);
+
+  s21::multiset<int, std::less<int>, std::allocator<int>,
+                s21::counted_tree_traits>
+      counted;
+  counted.emplace(5);
+  auto it = counted.emplace_hint(counted.end(), 5);
+  EXPECT_EQ(*it, 5);
+  counted.insert_many(5, 6);
+  EXPECT_EQ(counted.count(5), 3u);
+  EXPECT_EQ(counted.size(), 4u);
+}
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "../proj_tests.hpp"
+
+namespace {
+
+s21::vector<int> RandomInts(std::size_t n, int range) {
+  s21::vector<int> v;
+  std::uint64_t state = n;
+  for (std::size_t i = 0; i < n; i++) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    v.push_back(static_cast<int>(state >> 33) % range);
+  }
+  return v;
+}
+
+}  // namespace
+
+TEST(Parallel, Sort) {
+  s21::parallel::thread_pool pool(3), alone(0);
+  for (auto *p : {&pool, &alone}) {
+    for (std::size_t n : {0, 1, 63, 64, 1000, 4099}) {
+      s21::parallel::policy small{p, 64};
+      s21::vector<int> v = RandomInts(n, 100), expected = v;
+      std::sort(expected.begin(), expected.end());
+      s21::parallel::sort(small, v.begin(), v.end());
+      EXPECT_TRUE(v == expected);
+
+      s21::parallel::sort(small, v.begin(), v.end(), std::greater<>());
+      std::reverse(expected.begin(), expected.end());
+      EXPECT_TRUE(v == expected);
+    }
+  }
+
+  // ties keep their order, also for types without a default constructor
+  s21::vector<std::pair<int, std::string>> pairs;
+  s21::vector<int> keys = RandomInts(3000, 10);
+  for (std::size_t i = 0; i < keys.size(); i++)
+    pairs.push_back({keys[i], std::to_string(i)});
+  auto expected = pairs;
+  auto by_key = [](const auto &a, const auto &b) { return a.first < b.first; };
+  std::stable_sort(expected.begin(), expected.end(), by_key);
+  s21::parallel::stable_sort({&pool, 100}, pairs.begin(), pairs.end(),
+                             by_key);
+  EXPECT_TRUE(pairs == expected);
+
+  // a grain of 1 merges single elements that are already in order
+  for (auto *p : {&pool, &alone}) {
+    s21::vector<int> v = {1, 2, 3, 4}, w = RandomInts(500, 100);
+    s21::parallel::sort({p, 1}, v.begin(), v.end());
+    EXPECT_TRUE((v == s21::vector<int>{1, 2, 3, 4}));
+    auto expected = w;
+    std::stable_sort(expected.begin(), expected.end());
+    s21::parallel::stable_sort({p, 1}, w.begin(), w.end());
+    EXPECT_TRUE(w == expected);
+  }
+
+  s21::array<int, 6> a = {5, 3, 6, 1, 4, 2};
+  s21::parallel::sort(a.begin(), a.end());
+  EXPECT_TRUE((a == s21::array<int, 6>{1, 2, 3, 4, 5, 6}));
+}
+
+TEST(Parallel, ElementWise) {
+  s21::parallel::thread_pool pool(3);
+  s21::parallel::policy small{&pool, 50};
+  s21::vector<int> v = RandomInts(5000, 1000);
+
+  s21::vector<long long> squares(v.size());
+  auto end = s21::parallel::transform(small, v.begin(), v.end(),
+                                      squares.begin(),
+                                      [](int x) { return 1LL * x * x; });
+  EXPECT_EQ(end, squares.end());
+  for (std::size_t i = 0; i < v.size(); i++)
+    ASSERT_EQ(squares[i], 1LL * v[i] * v[i]);
+
+  s21::parallel::for_each(small, v.begin(), v.end(), [](int &x) { x += 1; });
+  for (std::size_t i = 0; i < v.size(); i++)
+    ASSERT_EQ(squares[i], 1LL * (v[i] - 1) * (v[i] - 1));
+
+  // nested loops wait by running tasks rather than blocking the workers
+  std::atomic<int> calls{0};
+  s21::parallel::for_each(small, v.begin(), v.begin() + 200, [&](int) {
+    s21::parallel::for_each(small, v.begin(), v.begin() + 200,
+                            [&](int) { calls++; });
+  });
+  EXPECT_EQ(calls.load(), 200 * 200);
+
+  // the first exception a task throws reaches the caller
+  int top = *std::max_element(v.begin(), v.end());
+  auto throw_at_top = [top](int x) {
+    if (x == top) throw std::runtime_error("top");
+  };
+  EXPECT_THROW(
+      s21::parallel::for_each(small, v.begin(), v.end(), throw_at_top),
+      std::runtime_error);
+}
+
+TEST(Parallel, ReduceScanFilter) {
+  s21::parallel::thread_pool pool(3);
+  s21::parallel::policy small{&pool, 70};
+  s21::vector<int> v = RandomInts(5003, 1000);
+
+  EXPECT_EQ(s21::parallel::reduce(small, v.begin(), v.end(), 0LL),
+            std::accumulate(v.begin(), v.end(), 0LL));
+  // an associative but not commutative op folds left to right
+  s21::vector<std::string> words;
+  for (int i = 0; i < 500; i++) words.push_back(std::to_string(i % 10));
+  EXPECT_EQ(s21::parallel::reduce({&pool, 7}, words.begin(), words.end(),
+                                  std::string(">")),
+            std::accumulate(words.begin(), words.end(), std::string(">")));
+
+  s21::vector<long long> wide(v.size()), expected(v.size());
+  std::copy(v.begin(), v.end(), wide.begin());
+  std::partial_sum(wide.begin(), wide.end(), expected.begin());
+  s21::vector<long long> sums(v.size());
+  EXPECT_EQ(s21::parallel::inclusive_scan(small, wide.begin(), wide.end(),
+                                          sums.begin()),
+            sums.end());
+  EXPECT_TRUE(sums == expected);
+  s21::parallel::inclusive_scan(small, wide.begin(), wide.end(),
+                                wide.begin());
+  EXPECT_TRUE(wide == expected);
+
+  auto odd = [](int x) { return x % 2 == 1; };
+  s21::vector<int> kept(v.size()), expected_kept;
+  std::copy_if(v.begin(), v.end(), std::back_inserter(expected_kept), odd);
+  auto end = s21::parallel::copy_if(small, v.begin(), v.end(), kept.begin(),
+                                    odd);
+  kept.resize(end - kept.begin());
+  EXPECT_TRUE(kept == expected_kept);
+}
@@ -3,8 +3,77 @@
 
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+
 #include "../proj_containers.hpp"
 
 int main(int argc, char **argv);
 
+// Memory resource that counts what passes through it to the upstream one
+class counting_resource : public std::pmr::memory_resource {
+ public:
+  explicit counting_resource(
+      std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+      : upstream_(upstream) {}
+
+  std::size_t allocations = 0;
+  std::size_t outstanding = 0;
+
+ private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void *p = upstream_->allocate(bytes, alignment);
+    ++allocations;
+    outstanding += bytes;
+    return p;
+  }
+
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    outstanding -= bytes;
+    upstream_->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  std::pmr::memory_resource *upstream_;
+};
+
+// Value that counts the copies and moves made of any instance
+struct counted_value {
+  static inline int copies = 0;
+  static inline int moves = 0;
+  static void reset() { copies = moves = 0; }
+
+  int id = 0;
+
+  counted_value() = default;
+  explicit counted_value(int i) : id(i) {}
+  counted_value(int tens, int ones) : id(tens * 10 + ones) {}
+  counted_value(const counted_value &other) : id(other.id) { ++copies; }
+  counted_value(counted_value &&other) noexcept : id(other.id) { ++moves; }
+  counted_value &operator=(const counted_value &other) {
+    id = other.id;
+    ++copies;
+    return *this;
+  }
+  counted_value &operator=(counted_value &&other) noexcept {
+    id = other.id;
+    ++moves;
+    return *this;
+  }
+
+  friend bool operator<(const counted_value &lhs, const counted_value &rhs) {
+    return lhs.id < rhs.id;
+  }
+  friend bool operator==(const counted_value &lhs, const counted_value &rhs) {
+    return lhs.id == rhs.id;
+  }
+  friend bool operator!=(const counted_value &lhs, const counted_value &rhs) {
+    return lhs.id != rhs.id;
+  }
+};
+
 #endif
@@ -99,3 +99,14 @@ TEST(QueueMethods, InsertManyBack) {
   EXPECT_EQ(q.size(), 7);
   EXPECT_TRUE(q == q2);
 }
+
+TEST(QueueMethods, Emplace) {
+  s21::queue<counted_value> q;
+  counted_value::reset();
+  EXPECT_EQ(q.emplace(1, 2).id, 12);
+  q.push(counted_value(3));
+  q.insert_many_back(counted_value(4), counted_value(5));
+  EXPECT_EQ(counted_value::copies, 0);
+  EXPECT_EQ(q.front().id, 12);
+  EXPECT_EQ(q.back().id, 5);
+}
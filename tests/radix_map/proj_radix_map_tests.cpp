@@ -0,0 +1,220 @@
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../proj_tests.hpp"
+
+namespace {
+
+std::uint64_t Step(std::uint64_t &state) {
+  state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return state >> 17;
+}
+
+// keys sharing long runs, prefixes of each other and the empty key
+std::string RandomKey(std::uint64_t &state) {
+  static const char *const stems[] = {
+      "",  "a", "ab", "abc", "https://www.example.com/", "https://api.", "\xff",
+      "x"};
+  std::string key = stems[Step(state) % 8];
+  std::size_t tail = Step(state) % 4;
+  for (std::size_t i = 0; i < tail; ++i)
+    key += static_cast<char>("ab\0z\x80"[Step(state) % 5]);
+  return key;
+}
+
+using Entries = std::vector<std::pair<std::string, int>>;
+
+template <typename Map>
+Entries Contents(const Map &m) {
+  Entries out;
+  for (auto it = m.begin(); it != m.end(); ++it)
+    out.emplace_back(it->first, it->second);
+  return out;
+}
+
+}  // namespace
+
+TEST(RadixMap, InsertFindErase) {
+  s21::radix_map<std::string, int> m = {{"romane", 1}, {"romanus", 2},
+                                         {"romulus", 3}, {"rubens", 4},
+                                         {"ruber", 5},   {"rubicon", 6}};
+  EXPECT_EQ(m.size(), 6u);
+  EXPECT_EQ(m.at("romulus"), 3);
+  EXPECT_TRUE(m.contains("ruber"));
+  EXPECT_FALSE(m.contains("rub"));
+  EXPECT_FALSE(m.contains("rubiconn"));
+  EXPECT_THROW(m.at("roman"), std::out_of_range);
+
+  EXPECT_FALSE(m.insert("ruber", 50).second);
+  EXPECT_EQ(m["ruber"], 5);
+  m["rub"] = 7;
+  EXPECT_EQ(m.size(), 7u);
+  m.insert_or_assign("rub", 8);
+  EXPECT_EQ(m.at("rub"), 8);
+
+  EXPECT_EQ(m.erase("romanus"), 1u);
+  EXPECT_EQ(m.erase("romanus"), 0u);
+  EXPECT_FALSE(m.contains("romanus"));
+  EXPECT_TRUE(m.contains("romane"));
+  EXPECT_EQ(m.size(), 6u);
+}
+
+TEST(RadixMap, OrderedIterationAndBounds) {
+  s21::radix_map<std::string, int> m;
+  std::vector<std::string> keys = {"b", "", "ba", "a", "abc", "ab", "bab"};
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    m.insert(keys[i], static_cast<int>(i));
+  std::vector<std::string> order;
+  for (const auto &item : m) order.push_back(item.first);
+  std::vector<std::string> expected = {"", "a", "ab", "abc", "b", "ba", "bab"};
+  EXPECT_EQ(order, expected);
+
+  EXPECT_EQ(m.lower_bound("ab")->first, "ab");
+  EXPECT_EQ(m.lower_bound("abb")->first, "abc");
+  EXPECT_EQ(m.upper_bound("ab")->first, "abc");
+  EXPECT_EQ(m.upper_bound("abc")->first, "b");
+  EXPECT_TRUE(m.lower_bound("bb") == m.end());
+  EXPECT_EQ(m.lower_bound("")->first, "");
+  EXPECT_EQ(m.upper_bound("")->first, "a");
+
+  auto next = m.erase(m.find("abc"));
+  EXPECT_EQ(next->first, "b");
+}
+
+TEST(RadixMap, PrefixScan) {
+  s21::radix_map<std::string, int> m;
+  const char *urls[] = {"https://a.example/x",   "https://a.example/y",
+                        "https://a.example",     "https://b.example/x",
+                        "http://a.example/x",    "https://a.examples/"};
+  for (int i = 0; i < 6; ++i) m.insert(urls[i], i);
+
+  std::vector<std::string> got;
+  m.for_each_prefix("https://a.example",
+                    [&](const std::string &key, int &) { got.push_back(key); });
+  std::vector<std::string> expected = {"https://a.example",
+                                       "https://a.example/x",
+                                       "https://a.example/y",
+                                       "https://a.examples/"};
+  EXPECT_EQ(got, expected);
+
+  got.clear();
+  m.for_each_prefix("https://a.example/",
+                    [&](const std::string &key, int &) {
+                      got.push_back(key);
+                      return false;
+                    });
+  EXPECT_EQ(got.size(), 1u);
+
+  int all = 0;
+  m.for_each_prefix("", [&](const std::string &, int &) { ++all; });
+  EXPECT_EQ(all, 6);
+  m.for_each_prefix("ftp", [&](const std::string &, int &) { ++all; });
+  EXPECT_EQ(all, 6);
+}
+
+TEST(RadixMap, RandomAgainstStdMap) {
+  s21::radix_map<std::string, int> m;
+  std::map<std::string, int> ref;
+  std::uint64_t state = 11;
+  for (int round = 0; round < 20000; ++round) {
+    std::string key = RandomKey(state);
+    if (Step(state) % 3) {
+      m.insert_or_assign(key, round);
+      ref[key] = round;
+    } else {
+      ASSERT_EQ(m.erase(key), ref.erase(key)) << round;
+    }
+    ASSERT_EQ(m.size(), ref.size());
+
+    if (round % 97 == 0) {
+      std::string probe = RandomKey(state);
+      auto it = m.lower_bound(probe);
+      auto rit = ref.lower_bound(probe);
+      ASSERT_EQ(it == m.end(), rit == ref.end());
+      if (rit != ref.end()) {
+        ASSERT_EQ(it->first, rit->first);
+      }
+      it = m.upper_bound(probe);
+      rit = ref.upper_bound(probe);
+      ASSERT_EQ(it == m.end(), rit == ref.end());
+      if (rit != ref.end()) {
+        ASSERT_EQ(it->first, rit->first);
+      }
+    }
+  }
+  EXPECT_EQ(Contents(m),
+            Entries(ref.begin(), ref.end()));
+}
+
+TEST(RadixMap, GrowsAndShrinksNodes) {
+  s21::radix_map<std::string, int> m;
+  std::map<std::string, int> ref;
+  // 256 children under one node, then thinned out again
+  for (int c = 0; c < 256; ++c) {
+    std::string key = "k" + std::string(1, static_cast<char>(c)) + "tail";
+    m.insert(key, c);
+    ref[key] = c;
+  }
+  EXPECT_EQ(Contents(m),
+            Entries(ref.begin(), ref.end()));
+  for (int c = 0; c < 256; ++c) {
+    if (c % 17 == 0) continue;
+    std::string key = "k" + std::string(1, static_cast<char>(c)) + "tail";
+    m.erase(key);
+    ref.erase(key);
+    ASSERT_EQ(m.size(), ref.size());
+  }
+  EXPECT_EQ(Contents(m),
+            Entries(ref.begin(), ref.end()));
+  for (const auto &item : ref) EXPECT_EQ(m.at(item.first), item.second);
+}
+
+TEST(RadixMap, CopyMoveAndPmr) {
+  counting_resource resource;
+  {
+    s21::pmr::radix_map<std::string, int> m(&resource);
+    for (int i = 0; i < 300; ++i)
+      m.insert("key/" + std::to_string(i * 7919), i);
+    s21::pmr::radix_map<std::string, int> copy(m, &resource);
+    EXPECT_TRUE(copy == m);
+    s21::pmr::radix_map<std::string, int> moved(std::move(copy));
+    EXPECT_TRUE(moved == m);
+    EXPECT_TRUE(copy.empty());
+    moved.erase("key/0");
+    EXPECT_TRUE(moved != m);
+    m.clear();
+    EXPECT_TRUE(m.empty());
+  }
+  EXPECT_EQ(resource.outstanding, 0u);
+}
+
+TEST(RadixSet, IntegerKeysInOrder) {
+  s21::radix_set<std::uint64_t> s;
+  std::set<std::uint64_t> ref;
+  std::uint64_t state = 5;
+  for (int i = 0; i < 20000; ++i) {
+    std::uint64_t key = Step(state) % 3 ? Step(state) : Step(state) % 512;
+    EXPECT_EQ(s.insert(key).second, ref.insert(key).second);
+  }
+  for (int i = 0; i < 5000; ++i) {
+    std::uint64_t key = Step(state) % 512;
+    EXPECT_EQ(s.erase(key), ref.erase(key));
+  }
+  ASSERT_EQ(s.size(), ref.size());
+  std::vector<std::uint64_t> got(s.begin(), s.end());
+  EXPECT_EQ(got, std::vector<std::uint64_t>(ref.begin(), ref.end()));
+  EXPECT_EQ(*s.lower_bound(100), *ref.lower_bound(100));
+  EXPECT_FALSE(s.contains(UINT64_MAX));
+}
+
+TEST(RadixSet, SignedKeysAndForEach) {
+  s21::radix_set<int> s = {5, -3, 0, -1000, 42, INT32_MIN, INT32_MAX};
+  std::vector<int> got;
+  s.for_each([&](const int &key) { got.push_back(key); });
+  std::vector<int> expected = {INT32_MIN, -1000, -3, 0, 5, 42, INT32_MAX};
+  EXPECT_EQ(got, expected);
+  EXPECT_EQ(*s.upper_bound(0), 5);
+  EXPECT_EQ(*s.lower_bound(-4), -3);
+}
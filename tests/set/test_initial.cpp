@@ -99,3 +99,121 @@ TEST(InitialSet2, Subtest_10) {
   s21::set<int> sss = {1, 2, 3};
   ASSERT_EQ(ss == sss, 1);
 }
+
+TEST(SetStats, Subtest_1) {
+  s21::set<int, std::less<int>, std::allocator<int>, s21::stats_tree_traits>
+      ss = {5, 3, 8, 1, 4};
+  s21::tree_stats st = ss.stats();
+  EXPECT_EQ(st.allocations, 6);
+  EXPECT_EQ(st.height, 3);
+  ss.erase(ss.begin());
+  EXPECT_EQ(ss.stats().deallocations, 1);
+}
+
+TEST(SetBatch, ContainsMany) {
+  s21::set<int> ss;
+  for (int i = 0; i < 300; i += 3) ss.insert(i);
+  std::vector<int> keys;
+  for (int i = 0; i < 300; ++i) keys.push_back(i);
+  std::vector<bool> result;
+  ss.contains_many(keys.begin(), keys.end(), std::back_inserter(result));
+  ASSERT_EQ(result.size(), keys.size());
+  for (int i = 0; i < 300; ++i) EXPECT_EQ(result[i], i % 3 == 0);
+}
+
+TEST(SetBatch, EmptySet) {
+  s21::set<int> ss;
+  std::vector<int> keys = {1, 2};
+  std::vector<s21::set<int>::iterator> found;
+  ss.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+  ASSERT_EQ(found.size(), 2);
+  EXPECT_TRUE(found[0] == ss.end());
+}
+
+TEST(SetBatch, ApplyBatch) {
+  s21::set<int> ss = {1, 2, 3};
+  std::vector<s21::set<int>::batch_op> ops = {{s21::batch_kind::erase, 2},
+                                              {s21::batch_kind::upsert, 3},
+                                              {s21::batch_kind::upsert, 4}};
+  s21::vector<s21::batch_outcome> outcomes = ss.apply_batch(ops);
+  EXPECT_EQ(outcomes[0], s21::batch_outcome::erased);
+  EXPECT_EQ(outcomes[1], s21::batch_outcome::assigned);
+  EXPECT_EQ(outcomes[2], s21::batch_outcome::inserted);
+  EXPECT_EQ(ss.size(), 3);
+  EXPECT_FALSE(ss.contains(2));
+  EXPECT_TRUE(ss.contains(4));
+}
+
+TEST(SetAllocator, MonotonicBuffer) {
+  char buffer[4096];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  s21::pmr::set<int> s({5, 1, 3}, &arena);
+  for (int i = 0; i < 20; ++i) s.insert(i);
+  EXPECT_EQ(s.size(), 20u);
+  EXPECT_TRUE(s.contains(19));
+
+  s21::pmr::set<int> copy(s, &arena);
+  EXPECT_EQ(copy.size(), 20u);
+  EXPECT_EQ(copy.get_allocator().resource(), &arena);
+}
+
+TEST(SetScan, ForEach) {
+  s21::set<std::string> s = {"pear", "apple", "fig", "kiwi", "banana"};
+  std::vector<std::string> all, some;
+  s.for_each([&](const std::string &key) { all.push_back(key); });
+  std::vector<std::string> expected = {"apple", "banana", "fig", "kiwi",
+                                       "pear"};
+  EXPECT_EQ(all, expected);
+
+  s.for_each_in_range("b", "kiwi",
+                      [&](const std::string &key) { some.push_back(key); });
+  expected = {"banana", "fig"};
+  EXPECT_EQ(some, expected);
+
+  some.clear();
+  s.for_each([&](const std::string &key) {
+    some.push_back(key);
+    return key != "banana";
+  });
+  EXPECT_EQ(some.size(), 2u);
+}
+
+TEST(SetBloom, StringMisses) {
+  s21::set<std::string, std::less<std::string>, std::allocator<std::string>,
+           s21::bloom_tree_traits<12, true>>
+      s;
+  for (int i = 0; i < 3000; ++i) {
+    std::string key = "seen/" + std::to_string(i);
+    s.insert(key);
+  }
+  int found = 0;
+  for (int i = 0; i < 6000; ++i)
+    found += s.contains("seen/" + std::to_string(i));
+  EXPECT_EQ(found, 3000);
+  EXPECT_LT(s.bloom_stats().false_positives, 60u);
+  EXPECT_GT(s.bloom_stats().rejected, 2900u);
+}
+
+TEST(SetEmplace, MovesKeys) {
+  s21::set<std::string> s;
+  std::string key(40, 'k');
+  EXPECT_TRUE(s.insert(std::move(key)).second);
+  EXPECT_TRUE(s.contains(std::string(40, 'k')));
+  EXPECT_EQ(*s.find(std::string(40, 'k')), std::string(40, 'k'));
+
+  // a duplicate rvalue is left as it was
+  std::string again(40, 'k');
+  EXPECT_FALSE(s.insert(std::move(again)).second);
+  EXPECT_EQ(again, std::string(40, 'k'));
+
+  auto placed = s.emplace(3, 'x');
+  EXPECT_TRUE(placed.second);
+  EXPECT_EQ(*placed.first, "xxx");
+  EXPECT_EQ(*s.emplace_hint(s.end(), "zzz"), "zzz");
+  EXPECT_EQ(*s.emplace_hint(s.begin(), "yyy"), "yyy");
+  auto many = s.insert_many(std::string("aaa"), std::string("xxx"));
+  EXPECT_TRUE(many[0].second);
+  EXPECT_FALSE(many[1].second);
+  EXPECT_EQ(s.size(), 5u);
+}
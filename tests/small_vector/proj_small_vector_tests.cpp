@@ -0,0 +1,178 @@
+#include <string>
+#include <vector>
+
+#include "../proj_tests.hpp"
+
+namespace {
+
+// Stateful allocator that follows its elements on swap
+template <typename T>
+struct swapped_allocator {
+  using value_type = T;
+  using propagate_on_container_swap = std::true_type;
+
+  int tag;
+
+  explicit swapped_allocator(int t = 0) : tag(t) {}
+  template <typename U>
+  swapped_allocator(const swapped_allocator<U> &other) : tag(other.tag) {}
+
+  T *allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+  void deallocate(T *p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+  friend bool operator==(const swapped_allocator &lhs,
+                         const swapped_allocator &rhs) {
+    return lhs.tag == rhs.tag;
+  }
+  friend bool operator!=(const swapped_allocator &lhs,
+                         const swapped_allocator &rhs) {
+    return lhs.tag != rhs.tag;
+  }
+};
+
+}  // namespace
+
+TEST(SmallVector, StaysInlineUpToN) {
+  counting_resource counter;
+  s21::pmr::small_vector<int, 4> v(&counter);
+  for (int i = 0; i < 4; i++) v.push_back(i);
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v.capacity(), 4u);
+  EXPECT_EQ(counter.allocations, 0u);
+
+  v.push_back(4);
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_EQ(v.capacity(), 8u);
+  EXPECT_EQ(counter.allocations, 1u);
+  for (int i = 0; i < 5; i++) EXPECT_EQ(v[i], i);
+
+  v.pop_back();
+  v.shrink_to_fit();
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(counter.outstanding, 0u);
+  EXPECT_EQ(v, (s21::pmr::small_vector<int, 4>({0, 1, 2, 3}, &counter)));
+}
+
+TEST(SmallVector, MatchesStdVector) {
+  s21::small_vector<std::string, 3> v;
+  std::vector<std::string> expected;
+  auto same = [&] {
+    ASSERT_EQ(v.size(), expected.size());
+    for (std::size_t i = 0; i < v.size(); i++) EXPECT_EQ(v[i], expected[i]);
+  };
+  std::string words[] = {"one", "two", std::string(30, 't'), "four"};
+
+  v.insert(v.begin(), std::begin(words), std::end(words));
+  expected.insert(expected.begin(), std::begin(words), std::end(words));
+  same();
+  v.insert(v.begin() + 1, 2, "x");
+  expected.insert(expected.begin() + 1, 2, "x");
+  same();
+  v.emplace(v.begin(), 3, 'e');
+  expected.emplace(expected.begin(), 3, 'e');
+  same();
+  v.insert_many(v.end(), std::string("y"), "z");
+  expected.insert(expected.end(), {"y", "z"});
+  same();
+  v.erase(v.begin() + 2);
+  expected.erase(expected.begin() + 2);
+  same();
+  v.insert(v.begin(), v[3]);
+  expected.insert(expected.begin(), std::string(expected[3]));
+  same();
+  EXPECT_EQ(v.front(), "two");
+  EXPECT_EQ(v.back(), "z");
+
+  v.reserve(100);
+  EXPECT_EQ(v.capacity(), 100u);
+  same();
+  v.clear();
+  EXPECT_TRUE(v.empty());
+  EXPECT_THROW(v.back(), const char *);
+}
+
+TEST(SmallVector, MovesInlineElements) {
+  counted_value::reset();
+  s21::small_vector<counted_value, 4> a;
+  a.emplace_back(1);
+  a.emplace_back(2);
+  s21::small_vector<counted_value, 4> b(std::move(a));
+  EXPECT_TRUE(b.is_inline());
+  EXPECT_EQ(counted_value::moves, 2);
+  EXPECT_EQ(counted_value::copies, 0);
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(b[1].id, 2);
+
+  // a spilled vector hands over its block
+  for (int i = 3; i < 7; i++) b.emplace_back(i);
+  counted_value::reset();
+  const counted_value *block = b.data();
+  a = std::move(b);
+  EXPECT_EQ(a.data(), block);
+  EXPECT_EQ(counted_value::moves + counted_value::copies, 0);
+  EXPECT_TRUE(b.is_inline());
+
+  b = {counted_value(9)};
+  a.swap(b);
+  EXPECT_EQ(a.size(), 1u);
+  EXPECT_EQ(b.size(), 6u);
+  EXPECT_EQ(b.data(), block);
+  EXPECT_EQ(a[0].id, 9);
+
+  s21::small_vector<counted_value, 4> c(b);
+  EXPECT_EQ(c, b);
+  EXPECT_EQ((s21::small_vector<int, 2>(3).size()), 3u);
+}
+
+TEST(SmallVector, SwapAcrossAllocators) {
+  static_assert(noexcept(std::declval<s21::small_vector<int, 4> &>().swap(
+      std::declval<s21::small_vector<int, 4> &>())));
+  // pmr allocators neither propagate nor always compare equal
+  static_assert(!noexcept(std::declval<s21::pmr::small_vector<int, 4> &>()
+                              .swap(std::declval<
+                                    s21::pmr::small_vector<int, 4> &>())));
+
+  counting_resource left_resource, right_resource;
+  s21::pmr::small_vector<int, 4> left(&left_resource), right(&right_resource);
+  left = {1, 2};
+  right = {1, 2, 3, 4, 5, 6, 7, 8};
+  left.swap(right);
+  EXPECT_EQ(left.size(), 8u);
+  EXPECT_EQ(right.size(), 2u);
+  EXPECT_EQ(left[7], 8);
+  EXPECT_EQ(right[1], 2);
+  // each side keeps its resource, the spilled elements are copied over
+  EXPECT_EQ(left.get_allocator().resource(), &left_resource);
+  EXPECT_GT(left_resource.outstanding, 0u);
+  EXPECT_TRUE(right.is_inline());
+
+  // propagating allocators go with the elements, the heap block too
+  using tagged = s21::small_vector<int, 2, swapped_allocator<int>>;
+  static_assert(noexcept(std::declval<tagged &>().swap(
+      std::declval<tagged &>())));
+  tagged inline_side{swapped_allocator<int>(1)},
+      heap_side{swapped_allocator<int>(2)};
+  inline_side.push_back(1);
+  for (int i = 0; i < 5; i++) heap_side.push_back(i);
+  const int *block = heap_side.data();
+  inline_side.swap(heap_side);
+  EXPECT_EQ(inline_side.get_allocator().tag, 2);
+  EXPECT_EQ(heap_side.get_allocator().tag, 1);
+  EXPECT_EQ(inline_side.data(), block);
+  EXPECT_EQ(heap_side.size(), 1u);
+  EXPECT_TRUE(heap_side.is_inline());
+}
+
+TEST(SmallVector, Resize) {
+  s21::small_vector<int, 4> v = {1, 2};
+  v.resize(4, 9);
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v, (s21::small_vector<int, 4>{1, 2, 9, 9}));
+  int *slot = v.append_uninitialized(3);
+  for (int i = 0; i < 3; i++) slot[i] = i;
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_EQ(v.size(), 7u);
+  EXPECT_EQ(v.back(), 2);
+  v.resize(1);
+  EXPECT_EQ(v.sum(), 1);
+}
@@ -0,0 +1,192 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include "../proj_tests.hpp"
+
+namespace {
+
+using event_table = s21::soa_vector<int, double, std::string>;
+
+bool AlignedTo(const void *p, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+// Counts live instances; the copy after budget more copies throws
+struct limited_copy {
+  static inline int live = 0;
+  static inline int budget = -1;
+
+  limited_copy() { ++live; }
+  limited_copy(const limited_copy &) {
+    if (budget == 0) throw std::runtime_error("copy");
+    if (budget > 0) --budget;
+    ++live;
+  }
+  ~limited_copy() { --live; }
+};
+
+// Move-only, and the move after budget more moves throws
+struct limited_move {
+  static inline int live = 0;
+  static inline int budget = -1;
+
+  explicit limited_move(int v) : value(v) { ++live; }
+  limited_move(limited_move &&other) : value(other.value) {
+    if (budget == 0) throw std::runtime_error("move");
+    if (budget > 0) --budget;
+    ++live;
+  }
+  limited_move(const limited_move &) = delete;
+  ~limited_move() { --live; }
+
+  int value;
+};
+
+}  // namespace
+
+TEST(SoaVector, PushAndColumns) {
+  event_table events;
+  EXPECT_TRUE(events.empty());
+  EXPECT_THROW(events.back(), const char *);
+  for (int i = 0; i < 100; i++) {
+    if (i % 2)
+      events.push_back({i, i * 0.5, std::to_string(i)});
+    else
+      events.emplace_back(i, i * 0.5, std::to_string(i));
+    ASSERT_TRUE(AlignedTo(events.data<0>(), 64));
+    ASSERT_TRUE(AlignedTo(events.data<1>(), 64));
+    ASSERT_TRUE(AlignedTo(events.data<2>(), 64));
+  }
+  EXPECT_EQ(events.size(), 100u);
+  EXPECT_GE(events.capacity(), 100u);
+
+  s21::column_span<int> ids = events.column<0>();
+  EXPECT_EQ(ids.size(), 100u);
+  EXPECT_EQ(ids[42], 42);
+  EXPECT_EQ(s21::simd::sum(ids), 4950);
+  EXPECT_EQ(s21::simd::count(events.column<1>(), 10.0), 1u);
+  EXPECT_EQ(s21::simd::max(events.column<1>()), 49.5);
+  EXPECT_EQ(events.column<2>()[7], "7");
+  for (double &price : events.column<1>()) price *= 2;
+  EXPECT_EQ(events.back().get<1>(), 99.0);
+
+  const event_table &view = events;
+  s21::column_span<const std::string> names = view.column<2>();
+  EXPECT_EQ(names.end() - names.begin(), 100);
+
+  // arguments that refer into the table survive the reallocation
+  events.shrink_to_fit();
+  EXPECT_EQ(events.capacity(), 100u);
+  events.emplace_back(events.front().get<0>(), 1.0, events.back().get<2>());
+  EXPECT_EQ(events[100].get<0>(), 0);
+  EXPECT_EQ(events[100].get<2>(), "99");
+  EXPECT_THROW(events[101], const char *);
+
+  events.pop_back();
+  events.resize(3);
+  EXPECT_EQ(events.size(), 3u);
+  events.resize(5);
+  EXPECT_EQ(event_table::value_type(events[4]),
+            std::make_tuple(0, 0.0, std::string()));
+}
+
+TEST(SoaVector, Rows) {
+  event_table events = {{3, 1.5, "c"}, {1, 2.5, "a"}, {2, 3.5, "b"}};
+
+  // structured bindings name the fields in the columns
+  auto [id, price, name] = events[1];
+  EXPECT_EQ(id, 1);
+  price = 9.0;
+  name += "!";
+  EXPECT_EQ(events.data<1>()[1], 9.0);
+  EXPECT_EQ(events.column<2>()[1], "a!");
+
+  events[0] = std::make_tuple(7, 0.5, std::string("g"));
+  events[2] = events[0];
+  EXPECT_EQ(events[2].get<0>(), 7);
+  EXPECT_EQ(s21::get<2>(events[2]), "g");
+
+  int total = 0;
+  for (auto row : events) total += row.get<0>();
+  EXPECT_EQ(total, 15);
+
+  auto it = events.begin();
+  it += 2;
+  EXPECT_EQ(it - events.begin(), 2);
+  EXPECT_EQ((*--it).get<0>(), 1);
+  EXPECT_EQ(it[1].get<2>(), "g");
+  event_table::const_iterator first = events.begin();
+  EXPECT_TRUE(first < it);
+  EXPECT_EQ(std::distance(events.cbegin(), events.cend()), 3);
+  event_table::value_type copy = *first;
+  EXPECT_EQ(std::get<2>(copy), "g");
+}
+
+TEST(SoaVector, CopyMoveAndGrowth) {
+  s21::soa_vector<counted_value, int> table;
+  for (int i = 0; i < 50; i++) table.emplace_back(i, i);
+  counted_value::reset();
+  table.reserve(1000);
+  // nothrow-movable columns move when the block grows
+  EXPECT_EQ(counted_value::copies, 0);
+  EXPECT_EQ(counted_value::moves, 50);
+
+  auto copy = table;
+  EXPECT_EQ(copy.size(), 50u);
+  EXPECT_EQ(copy[49].get<0>().id, 49);
+  copy.emplace_back(counted_value(50), 50);
+
+  auto moved = std::move(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.size(), 51u);
+  EXPECT_EQ(moved.back().get<1>(), 50);
+
+  table = moved;
+  EXPECT_EQ(table.size(), 51u);
+  table.clear();
+  EXPECT_TRUE(table.empty());
+  EXPECT_EQ(moved[10].get<0>().id, 10);
+}
+
+TEST(SoaVector, ConstructorsCleanUpOnThrow) {
+  using table_type = s21::soa_vector<limited_copy, limited_copy>;
+  {
+    table_type table(10);
+    EXPECT_EQ(limited_copy::live, 20);
+
+    // the first column copies, the second throws partway
+    limited_copy::budget = 14;
+    EXPECT_THROW(table_type copy(table), std::runtime_error);
+    EXPECT_EQ(limited_copy::live, 20);
+
+    using row = std::tuple<limited_copy, limited_copy>;
+    std::initializer_list<row> rows = {row(), row()};
+    limited_copy::budget = 3;
+    EXPECT_THROW(table_type built(rows), std::runtime_error);
+    EXPECT_EQ(limited_copy::live, 24);
+    limited_copy::budget = -1;
+  }
+  EXPECT_EQ(limited_copy::live, 0);
+}
+
+TEST(SoaVector, GrowthPropagatesThrowingMoves) {
+  {
+    s21::soa_vector<int, limited_move> table;
+    for (int i = 0; i < 8; ++i) table.emplace_back(i, i);
+    table.shrink_to_fit();
+    limited_move::budget = 5;
+    EXPECT_THROW(table.emplace_back(8, 8), std::runtime_error);
+    limited_move::budget = -1;
+    EXPECT_EQ(table.size(), 8u);
+    EXPECT_EQ(limited_move::live, 8);
+    EXPECT_EQ(table[7].get<0>(), 7);
+
+    table.emplace_back(8, 8);
+    EXPECT_EQ(table.size(), 9u);
+    EXPECT_EQ(table[8].get<1>().value, 8);
+    EXPECT_EQ(table[3].get<1>().value, 3);
+  }
+  EXPECT_EQ(limited_move::live, 0);
+}
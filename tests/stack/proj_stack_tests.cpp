@@ -92,3 +92,19 @@ TEST(StackMethods, InsertManyFront) {
   EXPECT_EQ(s.size(), 7);
   EXPECT_TRUE(s == s2);
 }
+
+TEST(StackMethods, Emplace) {
+  s21::stack<counted_value> s;
+  counted_value::reset();
+  EXPECT_EQ(s.emplace(1, 2).id, 12);
+  s.push(counted_value(3));
+  s.insert_many_front(counted_value(4), counted_value(5));
+  EXPECT_EQ(counted_value::copies, 0);
+  EXPECT_EQ(s.top().id, 5);
+  EXPECT_EQ(s.size(), 4u);
+
+  s21::stack<int, s21::vector<int>> on_vector;
+  on_vector.emplace(7);
+  on_vector.insert_many_front(8, 9);
+  EXPECT_EQ(on_vector.top(), 9);
+}
@@ -0,0 +1,96 @@
+#include <string>
+#include <vector>
+
+#include "../proj_tests.hpp"
+
+namespace {
+// Stateful allocator that follows its container on move and swap
+template <typename T>
+struct tagged_allocator {
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  int tag;
+
+  explicit tagged_allocator(int t = 0) : tag(t) {}
+  template <typename U>
+  tagged_allocator(const tagged_allocator<U> &other) : tag(other.tag) {}
+
+  T *allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+  void deallocate(T *p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+  friend bool operator==(const tagged_allocator &lhs,
+                         const tagged_allocator &rhs) {
+    return lhs.tag == rhs.tag;
+  }
+  friend bool operator!=(const tagged_allocator &lhs,
+                         const tagged_allocator &rhs) {
+    return lhs.tag != rhs.tag;
+  }
+};
+}  // namespace
+
+TEST(AllocatorVector, PmrUsesResource) {
+  counting_resource counter;
+  {
+    s21::pmr::vector<std::string> v(&counter);
+    for (int i = 0; i < 100; i++) v.push_back(std::to_string(i));
+    EXPECT_EQ(v.get_allocator().resource(), &counter);
+    EXPECT_EQ(v[42], "42");
+    EXPECT_GT(counter.allocations, 0u);
+  }
+  EXPECT_EQ(counter.outstanding, 0u);
+}
+
+TEST(AllocatorVector, MonotonicBuffer) {
+  char buffer[1024];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  s21::pmr::vector<int> v(&arena);
+  for (int i = 0; i < 64; i++) v.push_back(i);
+  EXPECT_EQ(v.size(), 64u);
+  EXPECT_EQ(v.back(), 63);
+}
+
+TEST(AllocatorVector, PmrCopyAndMove) {
+  counting_resource first, second;
+  s21::pmr::vector<int> v({1, 2, 3}, &first);
+
+  // pmr allocators don't propagate, copies start on the default resource
+  s21::pmr::vector<int> copy(v);
+  EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+  s21::pmr::vector<int> placed(v, &second);
+  EXPECT_EQ(placed.get_allocator().resource(), &second);
+  EXPECT_TRUE(placed == v);
+
+  std::size_t before = first.allocations;
+  s21::pmr::vector<int> stolen(std::move(v));
+  EXPECT_EQ(first.allocations, before);
+  EXPECT_EQ(stolen.get_allocator().resource(), &first);
+
+  // moving across resources copies into the target's own memory
+  placed = std::move(stolen);
+  EXPECT_EQ(placed.get_allocator().resource(), &second);
+  EXPECT_EQ(placed.size(), 3u);
+  EXPECT_EQ(placed[2], 3);
+}
+
+TEST(AllocatorVector, PropagatesOnMoveAndSwap) {
+  using tagged_vector = s21::vector<int, tagged_allocator<int>>;
+  tagged_vector a({1, 2, 3}, tagged_allocator<int>(1));
+  tagged_vector b({4, 5}, tagged_allocator<int>(2));
+
+  a.swap(b);
+  EXPECT_EQ(a.get_allocator().tag, 2);
+  EXPECT_EQ(b.get_allocator().tag, 1);
+  EXPECT_EQ(a[0], 4);
+
+  tagged_vector c(tagged_allocator<int>(3));
+  c = std::move(b);
+  EXPECT_EQ(c.get_allocator().tag, 1);
+  EXPECT_EQ(c.size(), 3u);
+
+  tagged_vector d(c);
+  EXPECT_EQ(d.get_allocator().tag, 1);
+}
@@ -0,0 +1,47 @@
+#include <string>
+
+#include "../proj_tests.hpp"
+
+TEST(EmplaceVector, BuildsInPlace) {
+  s21::vector<counted_value> v;
+  counted_value::reset();
+  for (int i = 0; i < 20; i++) v.emplace_back(i / 10, i % 10);
+  EXPECT_EQ(counted_value::copies, 0);
+  EXPECT_EQ(v.emplace_back(7).id, 7);
+  EXPECT_EQ(v[19].id, 19);
+
+  // the middle takes one move per shifted element, never a copy
+  v.emplace(v.begin() + 1, 100);
+  EXPECT_EQ(v[1].id, 100);
+  EXPECT_EQ(v[2].id, 1);
+  EXPECT_EQ(v.size(), 22u);
+  EXPECT_EQ(counted_value::copies, 0);
+}
+
+TEST(EmplaceVector, ArgumentFromItself) {
+  s21::vector<std::string> v({"a", "b", std::string(30, 'c')});
+  v.emplace(v.begin(), v[2]);
+  v.emplace(v.begin() + 2, v[0]);
+  ASSERT_EQ(v.size(), 5u);
+  EXPECT_EQ(v[0], std::string(30, 'c'));
+  EXPECT_EQ(v[1], "a");
+  EXPECT_EQ(v[2], std::string(30, 'c'));
+  EXPECT_EQ(v[4], std::string(30, 'c'));
+  v.emplace(v.end(), std::move(v[1]));
+  EXPECT_EQ(v.back(), "a");
+}
+
+TEST(EmplaceVector, InsertManyForwards) {
+  s21::vector<counted_value> v;
+  v.emplace_back(1);
+  v.emplace_back(5);
+  counted_value keep(4);
+  counted_value::reset();
+  auto it = v.insert_many(v.begin() + 1, counted_value(2), counted_value(3),
+                          keep);
+  EXPECT_EQ(it->id, 2);
+  EXPECT_EQ(counted_value::copies, 1);
+  v.insert_many_back(counted_value(6), counted_value(7));
+  EXPECT_EQ(counted_value::copies, 1);
+  for (int i = 0; i < 7; i++) EXPECT_EQ(v[i].id, i + 1);
+}
@@ -1,7 +1,32 @@
+#include <iterator>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "../proj_tests.hpp"
 
+namespace {
+// Copies of a poisoned value throw
+struct fragile {
+  static inline int poison = -1;
+  int id;
+
+  explicit fragile(int i) : id(i) {}
+  fragile(const fragile &other) : id(other.id) {
+    if (id == poison) throw std::runtime_error("poisoned");
+  }
+  fragile(fragile &&other) noexcept : id(other.id) {}
+  fragile &operator=(const fragile &) = default;
+  fragile &operator=(fragile &&) noexcept = default;
+};
+
+template <typename T>
+void ExpectSame(const s21::vector<T> &own, const std::vector<T> &ref) {
+  ASSERT_EQ(own.size(), ref.size());
+  for (std::size_t i = 0; i < ref.size(); i++) ASSERT_EQ(own.data()[i], ref[i]);
+}
+}  // namespace
+
 TEST(InsertVector, Subtest_1) {
   s21::vector<int> own_vector = {1};
   std::vector<int> default_vector = {1};
@@ -42,3 +67,96 @@ TEST(InsertVector, Subtest_3) {
   ASSERT_EQ(default_vector.capacity(), own_vector.capacity());
   ASSERT_EQ(default_vector.size(), own_vector.size());
 }
+
+TEST(InsertVector, RangesMatchStd) {
+  s21::vector<std::string> own;
+  std::vector<std::string> ref;
+  std::uint64_t state = 7;
+  for (int round = 0; round < 300; round++) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    std::size_t at = (state >> 33) % (ref.size() + 1);
+    std::size_t count = (state >> 20) % 9;
+    std::vector<std::string> items;
+    for (std::size_t i = 0; i < count; i++)
+      items.push_back(std::to_string(round) + std::string(20, 'x'));
+    switch (round % 3) {
+      case 0:
+        own.insert(own.begin() + at, items.begin(), items.end());
+        break;
+      case 1:
+        own.insert(own.begin() + at, count, items.empty() ? "" : items[0]);
+        items.assign(count, items.empty() ? "" : items[0]);
+        break;
+      default:
+        own.insert_many(own.begin() + at, std::string("a"), std::string("b"));
+        items = {"a", "b"};
+    }
+    ref.insert(ref.begin() + at, items.begin(), items.end());
+    ExpectSame(own, ref);
+  }
+}
+
+TEST(InsertVector, GrowsOnce) {
+  counting_resource counter;
+  s21::pmr::vector<int> v(&counter);
+  for (int i = 0; i < 10; i++) v.push_back(i);
+  std::vector<int> block(10000, 7);
+  std::size_t before = counter.allocations;
+  auto it = v.insert(v.begin() + 5, block.begin(), block.end());
+  EXPECT_EQ(counter.allocations, before + 1);
+  EXPECT_EQ(*it, 7);
+  EXPECT_EQ(v.size(), 10010u);
+  EXPECT_EQ(v[4], 4);
+  EXPECT_EQ(v[10005], 5);
+
+  // room already there, nothing allocated
+  s21::pmr::vector<int> w(&counter);
+  for (int i = 0; i < 16; i++) w.push_back(i);
+  for (int i = 0; i < 6; i++) w.pop_back();
+  before = counter.allocations;
+  w.insert(w.begin(), {-3, -2, -1});
+  w.insert_many_back(10, 11, 12);
+  EXPECT_EQ(counter.allocations, before);
+  EXPECT_EQ(w[0], -3);
+  EXPECT_EQ(w[3], 0);
+  EXPECT_EQ(w.back(), 12);
+}
+
+TEST(InsertVector, SinglePassRange) {
+  s21::vector<int> v({1, 2, 9});
+  std::istringstream in("3 4 5 6 7 8");
+  auto it = v.insert(v.begin() + 2, std::istream_iterator<int>(in),
+                     std::istream_iterator<int>());
+  EXPECT_EQ(*it, 3);
+  for (int i = 0; i < 9; i++) EXPECT_EQ(v[i], i + 1);
+}
+
+TEST(InsertVector, ValuesFromItself) {
+  s21::vector<std::string> v({"a", "b", "c", std::string(30, 'd')});
+  v.insert(v.begin(), 2, v[3]);
+  ASSERT_EQ(v.capacity(), 8u);
+  v.insert_many(v.begin() + 1, v[2], std::move(v[5]));
+  ASSERT_EQ(v.size(), 8u);
+  EXPECT_EQ(v[0], std::string(30, 'd'));
+  EXPECT_EQ(v[1], "a");
+  EXPECT_EQ(v[2], std::string(30, 'd'));
+  EXPECT_EQ(v[4], "a");
+}
+
+TEST(InsertVector, ThrowLeavesVectorAlone) {
+  s21::vector<fragile> v;
+  for (int i = 0; i < 6; i++) v.emplace_back(i);
+  std::vector<fragile> block;
+  for (int i = 12; i < 14; i++) block.emplace_back(i);
+  fragile::poison = 13;
+  // first within the capacity, then with a block to grow into
+  for (int grow = 0; grow < 2; grow++) {
+    ASSERT_EQ(v.capacity(), grow ? 6u : 8u);
+    EXPECT_THROW(v.insert(v.begin() + 2, block.begin(), block.end()),
+                 std::runtime_error);
+    ASSERT_EQ(v.size(), 6u);
+    for (int i = 0; i < 6; i++) EXPECT_EQ(v[i].id, i);
+    v.shrink_to_fit();
+  }
+  fragile::poison = -1;
+}
@@ -1,3 +1,4 @@
+#include <string>
 #include <vector>
 
 #include "../proj_tests.hpp"
@@ -42,3 +43,95 @@ TEST(PushBackVector, Subtest_3) {
   ASSERT_EQ(default_vector.capacity(), own_vector.capacity());
   ASSERT_EQ(default_vector.size(), own_vector.size());
 }
+
+namespace {
+// Counts how its copies are made, moves may throw when ThrowingMove is set
+template <bool ThrowingMove>
+struct tracked {
+  static inline int copies = 0;
+  static inline int moves = 0;
+  std::string text;
+
+  explicit tracked(std::string t) : text(std::move(t)) {}
+  tracked(const tracked &other) : text(other.text) { ++copies; }
+  tracked(tracked &&other) noexcept(!ThrowingMove)
+      : text(std::move(other.text)) {
+    ++moves;
+  }
+};
+}  // namespace
+
+TEST(PushBackVector, GrowthMovesNothrowTypes) {
+  s21::vector<tracked<false>> v;
+  for (int i = 0; i < 100; i++) v.push_back(tracked<false>(std::to_string(i)));
+  EXPECT_EQ(tracked<false>::copies, 0);
+  EXPECT_EQ(v[99].text, "99");
+
+  // a throwing move would lose elements halfway, so growth copies instead
+  s21::vector<tracked<true>> w;
+  for (int i = 0; i < 9; i++) w.push_back(tracked<true>(std::to_string(i)));
+  EXPECT_EQ(tracked<true>::copies, 1 + 2 + 4 + 8);
+  EXPECT_EQ(w[8].text, "8");
+}
+
+TEST(PushBackVector, RelocatesBuffersAsIs) {
+  static_assert(s21::is_trivially_relocatable<s21::vector<int>>::value);
+  static_assert(!s21::is_trivially_relocatable<std::string>::value);
+
+  s21::vector<s21::vector<int>> nested;
+  nested.push_back({1, 2, 3});
+  const int *inner = nested[0].data();
+  for (int i = 0; i < 40; i++) nested.push_back({i});
+  EXPECT_EQ(nested[0].data(), inner);
+  EXPECT_EQ(nested[0][2], 3);
+  EXPECT_EQ(nested[40][0], 39);
+}
+
+TEST(PushBackVector, ElementOfItself) {
+  s21::vector<std::string> v({std::string(40, 'a'), "b"});
+  v.push_back(v[0]);
+  v.push_back(std::move(v[1]));
+  ASSERT_EQ(v.size(), 4u);
+  EXPECT_EQ(v[2], std::string(40, 'a'));
+  EXPECT_EQ(v[3], "b");
+}
+
+TEST(PushBackVector, GrowthPolicies) {
+  auto capacities = [](auto v) {
+    std::vector<std::size_t> seen;
+    for (int i = 0; i < 10; i++) {
+      v.push_back(i);
+      if (seen.empty() || seen.back() != v.capacity())
+        seen.push_back(v.capacity());
+    }
+    return seen;
+  };
+  EXPECT_EQ(capacities(s21::vector<int>()),
+            (std::vector<std::size_t>{1, 2, 4, 8, 16}));
+  EXPECT_EQ(
+      capacities(s21::vector<int, std::allocator<int>, s21::golden_growth>()),
+      (std::vector<std::size_t>{1, 2, 3, 4, 6, 9, 13}));
+  // 4 ints fill the smallest 16-byte class, 7 would ask for 28 bytes of 32
+  EXPECT_EQ(capacities(s21::vector<int, std::allocator<int>,
+                                   s21::size_class_growth>()),
+            (std::vector<std::size_t>{4, 8, 12}));
+  EXPECT_EQ(s21::size_class_growth::size_class(33), 48u);
+  EXPECT_EQ(s21::size_class_growth::size_class(4097), 5120u);
+
+  s21::vector<std::string, std::allocator<std::string>, s21::golden_growth> s;
+  for (int i = 0; i < 100; i++) s.push_back(std::to_string(i));
+  EXPECT_EQ(s[99], "99");
+}
+
+TEST(PushBackVector, ReallocKeepsValues) {
+  s21::vector<long> v;
+  v.push_back(7);
+  for (int i = 1; i < 100000; i++) v.push_back(v[i - 1] + 1);
+  EXPECT_EQ(v.size(), 100000u);
+  EXPECT_EQ(v[99999], 100006);
+  v.insert(v.begin(), v.begin() + 99990, v.end());
+  EXPECT_EQ(v[0], 99997);
+  v.shrink_to_fit();
+  EXPECT_EQ(v.capacity(), 100010u);
+  EXPECT_EQ(v.back(), 100006);
+}
@@ -0,0 +1,88 @@
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../proj_tests.hpp"
+
+namespace {
+
+// Default construction throws once the countdown runs out
+struct limited {
+  static inline int left = 0;
+  int id = 7;
+  limited() {
+    if (left-- == 0) throw "out of limited";
+  }
+};
+
+}  // namespace
+
+TEST(ResizeVector, MatchesStd) {
+  s21::vector<std::string> v = {"a", "b", "c"};
+  std::vector<std::string> expected = {"a", "b", "c"};
+  for (std::size_t size : {5, 2, 2, 0, 40, 3}) {
+    v.resize(size);
+    expected.resize(size);
+    ASSERT_EQ(v.size(), expected.size());
+    for (std::size_t i = 0; i < size; i++) EXPECT_EQ(v[i], expected[i]);
+  }
+  v.resize(10, "x");
+  EXPECT_EQ(v[2], "");
+  EXPECT_EQ(v[9], "x");
+  // the value may be one of the elements that move on growth
+  v.resize(1000, v[9]);
+  EXPECT_EQ(v[999], "x");
+
+  s21::vector<int> zeros(5);
+  EXPECT_EQ(zeros.size(), 5u);
+  EXPECT_EQ(zeros.count(0), 5u);
+}
+
+TEST(ResizeVector, ReserveKeepsSize) {
+  s21::vector<int> v = {1, 2};
+  v.reserve(100);
+  EXPECT_EQ(v.size(), 2u);
+  EXPECT_GE(v.capacity(), 100u);
+  v.reserve(1);
+  EXPECT_GE(v.capacity(), 100u);
+  v.push_back(3);
+  EXPECT_EQ(v, s21::vector<int>({1, 2, 3}));
+}
+
+TEST(ResizeVector, AppendUninitialized) {
+  counting_resource counter;
+  s21::pmr::vector<char> buffer(&counter);
+  buffer.reserve(64);
+  std::size_t allocations = counter.allocations;
+
+  const char packet[] = "hello";
+  for (int i = 0; i < 4; i++) {
+    char *slot = buffer.append_uninitialized(sizeof(packet) - 1);
+    std::memcpy(slot, packet, sizeof(packet) - 1);
+  }
+  EXPECT_EQ(buffer.size(), 20u);
+  EXPECT_EQ(std::string(buffer.data(), 5), "hello");
+  EXPECT_EQ(counter.allocations, allocations);
+
+  buffer.resize_for_overwrite(3);
+  EXPECT_EQ(std::string(buffer.data(), buffer.size()), "hel");
+
+  // other types are still constructed
+  s21::vector<std::string> names;
+  names.append_uninitialized(2)[1] = "b";
+  EXPECT_EQ(names[0], "");
+  EXPECT_EQ(names[1], "b");
+}
+
+TEST(ResizeVector, ThrowKeepsElements) {
+  limited::left = 10;
+  s21::vector<limited> v(4);
+  EXPECT_THROW(v.resize(20), const char *);
+  EXPECT_EQ(v.size(), 4u);
+  limited::left = 100;
+  v.resize(20);
+  EXPECT_EQ(v.size(), 20u);
+  EXPECT_EQ(v[19].id, 7);
+  limited::left = 0;
+  EXPECT_THROW(s21::vector<limited>(3), const char *);
+}
@@ -0,0 +1,87 @@
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../proj_tests.hpp"
+
+namespace {
+
+// Runs the kernels over every length and offset around the vector width
+template <typename T>
+void CheckKernels() {
+  for (std::size_t n = 0; n < 100; n++) {
+    s21::vector<T> v;
+    for (std::size_t i = 0; i < n; i++)
+      v.push_back(static_cast<T>((i * 37 + 11) % 101));
+    std::vector<T> std_v(v.begin(), v.end());
+
+    for (int x : {0, 11, 48, 100, 200}) {
+      T value = static_cast<T>(x);
+      EXPECT_EQ(v.find(value) - v.begin(),
+                std::find(std_v.begin(), std_v.end(), value) - std_v.begin());
+      EXPECT_EQ(static_cast<std::ptrdiff_t>(v.count(value)),
+                std::count(std_v.begin(), std_v.end(), value));
+    }
+    if (n) {
+      EXPECT_EQ(v.min(), *std::min_element(std_v.begin(), std_v.end()));
+      EXPECT_EQ(v.max(), *std::max_element(std_v.begin(), std_v.end()));
+    }
+    s21::simd::sum_type<T> sum = 0;
+    for (T x : std_v) sum += x;
+    EXPECT_EQ(v.sum(), sum);
+
+    s21::vector<T> w(v);
+    EXPECT_TRUE(v == w);
+    if (n) {
+      w[n - 1] = static_cast<T>(w[n - 1] + 1);
+      EXPECT_TRUE(v != w);
+      EXPECT_TRUE(v < w);
+      EXPECT_EQ(s21::simd::compare(w, v), 1);
+    }
+    w.fill(static_cast<T>(3));
+    EXPECT_EQ(w.count(static_cast<T>(3)), n);
+  }
+}
+
+}  // namespace
+
+TEST(SearchVector, ArithmeticKernels) {
+  CheckKernels<std::int8_t>();
+  CheckKernels<std::uint8_t>();
+  CheckKernels<std::int16_t>();
+  CheckKernels<int>();
+  CheckKernels<unsigned>();
+  CheckKernels<std::int64_t>();
+  CheckKernels<float>();
+  CheckKernels<double>();
+}
+
+TEST(SearchVector, FloatingPointOrder) {
+  s21::vector<double> v = {1.0, -0.0, 3.0};
+  s21::vector<double> w = {1.0, 0.0, 3.0};
+  EXPECT_TRUE(v == w);  // -0.0 == 0.0 though their bytes differ
+  EXPECT_TRUE(v.contains(0.0));
+  w.push_back(NAN);
+  EXPECT_FALSE(w == w);
+  EXPECT_TRUE(v < w);
+  EXPECT_EQ(s21::vector<double>({2.5, -1.0, 4.0}).sum(), 5.5);
+}
+
+TEST(SearchVector, OtherTypes) {
+  s21::vector<std::string> v = {"b", "a", "c", "a"};
+  EXPECT_EQ(v.count("a"), 2u);
+  EXPECT_EQ(v.find("c") - v.begin(), 2);
+  EXPECT_EQ(v.min(), "a");
+  EXPECT_EQ(v.max(), "c");
+  EXPECT_TRUE(v < s21::vector<std::string>({"b", "b"}));
+  EXPECT_THROW(s21::vector<int>().min(), const char *);
+
+  // free functions over any contiguous container
+  std::vector<unsigned char> bytes = {1, 2, 200};
+  EXPECT_EQ(s21::simd::compare(bytes, std::vector<unsigned char>{1, 2}), 1);
+  EXPECT_TRUE(s21::simd::contains(bytes, 200));
+  s21::simd::fill(bytes, 7);
+  EXPECT_EQ(s21::simd::sum(bytes), 21u);
+  EXPECT_EQ(*s21::simd::find(bytes, 7), 7);
+}
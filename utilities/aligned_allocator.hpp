@@ -0,0 +1,157 @@
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+#include "relocate.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+namespace s21 {
+
+// Stateless allocator whose blocks start on an Alignment boundary, 64 by
+// default so that SIMD loads over s21::vector<float> never straddle a cache
+// line
+template <typename T, std::size_t Alignment = 64>
+class aligned_allocator {
+  static_assert((Alignment & (Alignment - 1)) == 0,
+                "alignment must be a power of two");
+
+ public:
+  using value_type = T;
+  static constexpr std::size_t alignment =
+      Alignment < alignof(T) ? alignof(T) : Alignment;
+
+  // the alignment isn't a type, so allocator_traits can't rebind on its own
+  template <typename U>
+  struct rebind {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  aligned_allocator() noexcept = default;
+  template <typename U>
+  aligned_allocator(const aligned_allocator<U, Alignment> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+      throw std::bad_array_new_length();
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(alignment)));
+  }
+
+  void deallocate(T *p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t(alignment));
+  }
+
+  template <typename U>
+  friend bool operator==(const aligned_allocator &,
+                         const aligned_allocator<U, Alignment> &) noexcept {
+    return true;
+  }
+
+  template <typename U>
+  friend bool operator!=(const aligned_allocator &,
+                         const aligned_allocator<U, Alignment> &) noexcept {
+    return false;
+  }
+};
+
+// Stateless allocator for big tables: blocks of at least huge_page_size
+// bytes are mapped straight from the kernel, aligned to a huge page and
+// marked with madvise(MADV_HUGEPAGE), so transparent huge pages can back
+// them and a random access costs far fewer TLB misses. Smaller blocks, and
+// systems without mmap, get plain operator new; where the kernel declines
+// the advice the mapping stays on normal pages.
+template <typename T>
+class huge_page_allocator {
+ public:
+  using value_type = T;
+  static constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+  huge_page_allocator() noexcept = default;
+  template <typename U>
+  huge_page_allocator(const huge_page_allocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    if (n > (std::numeric_limits<std::size_t>::max() - huge_page_size) /
+                sizeof(T))
+      throw std::bad_array_new_length();
+    std::size_t bytes = n * sizeof(T);
+    if (!mapped(bytes)) return static_cast<T *>(::operator new(bytes));
+    return static_cast<T *>(map(round_up(bytes)));
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    std::size_t bytes = n * sizeof(T);
+    if (!mapped(bytes)) {
+      ::operator delete(p);
+      return;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    munmap(p, round_up(bytes));
+#endif
+  }
+
+  // Whether a block of this many bytes gets a mapping of its own
+  static constexpr bool mapped(std::size_t bytes) noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+    return bytes >= huge_page_size;
+#else
+    return static_cast<void>(bytes), false;
+#endif
+  }
+
+  template <typename U>
+  friend bool operator==(const huge_page_allocator &,
+                         const huge_page_allocator<U> &) noexcept {
+    return true;
+  }
+
+  template <typename U>
+  friend bool operator!=(const huge_page_allocator &,
+                         const huge_page_allocator<U> &) noexcept {
+    return false;
+  }
+
+ private:
+  static constexpr std::size_t round_up(std::size_t bytes) noexcept {
+    return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+  }
+
+#if defined(__unix__) || defined(__APPLE__)
+  // Maps one huge page more than asked and trims the ends to an aligned
+  // window, the kernel only backs aligned 2 MiB ranges with huge pages
+  static void *map(std::size_t bytes) {
+    std::size_t span = bytes + huge_page_size;
+    void *raw = mmap(nullptr, span, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) throw std::bad_alloc();
+    std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw);
+    std::uintptr_t aligned = round_up(start);
+    std::size_t head = aligned - start, tail = huge_page_size - head;
+    if (head) munmap(raw, head);
+    if (tail) munmap(reinterpret_cast<void *>(aligned + bytes), tail);
+#ifdef MADV_HUGEPAGE
+    madvise(reinterpret_cast<void *>(aligned), bytes, MADV_HUGEPAGE);
+#endif
+    return reinterpret_cast<void *>(aligned);
+  }
+#else
+  static void *map(std::size_t bytes) { return ::operator new(bytes); }
+#endif
+};
+
+template <typename T, std::size_t Alignment>
+struct is_trivially_relocatable<aligned_allocator<T, Alignment>>
+    : std::true_type {};
+template <typename T>
+struct is_trivially_relocatable<huge_page_allocator<T>> : std::true_type {};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace s21 {
+
+// Monotonic bump allocator over a chain of blocks. Memory is only given back
+// in bulk: reset() rewinds to the first block in O(1) and keeps the chain
+// for reuse, release() returns every block.
+class arena {
+ public:
+  static constexpr std::size_t default_block_size = 4096;
+  static constexpr std::size_t max_block_size = std::size_t(1) << 20;
+
+  explicit arena(std::size_t block_size = default_block_size) noexcept
+      : head_(nullptr),
+        current_(nullptr),
+        cur_(0),
+        end_(0),
+        next_block_size_(block_size ? block_size : default_block_size),
+        capacity_(0) {}
+
+  arena(const arena &) = delete;
+  arena &operator=(const arena &) = delete;
+
+  ~arena() { release(); }
+
+  void *allocate(std::size_t bytes,
+                 std::size_t alignment = alignof(std::max_align_t)) {
+    void *p = bump(bytes, alignment);
+    return p ? p : grow(bytes, alignment);
+  }
+
+  void deallocate(void *, std::size_t, std::size_t = 0) noexcept {}
+
+  void reset() noexcept {
+    current_ = head_;
+    if (head_) enter(head_);
+  }
+
+  void release() noexcept {
+    while (head_) {
+      block *next = head_->next;
+      ::operator delete(head_);
+      head_ = next;
+    }
+    current_ = nullptr;
+    cur_ = end_ = 0;
+    capacity_ = 0;
+  }
+
+  // Bytes reserved from the system by all blocks of the chain
+  std::size_t capacity() const noexcept { return capacity_; }
+
+ private:
+  struct block {
+    block *next;
+    std::size_t size;
+
+    std::uintptr_t data() noexcept {
+      return reinterpret_cast<std::uintptr_t>(this + 1);
+    }
+  };
+
+  void enter(block *b) noexcept {
+    cur_ = b->data();
+    end_ = cur_ + b->size;
+  }
+
+  void *bump(std::size_t bytes, std::size_t alignment) noexcept {
+    std::uintptr_t p = (cur_ + alignment - 1) & ~(alignment - 1);
+    if (!current_ || p > end_ || bytes > end_ - p) return nullptr;
+    cur_ = p + bytes;
+    return reinterpret_cast<void *>(p);
+  }
+
+  void *grow(std::size_t bytes, std::size_t alignment) {
+    // blocks kept by reset() come first
+    while (current_ && current_->next) {
+      current_ = current_->next;
+      enter(current_);
+      if (void *p = bump(bytes, alignment)) return p;
+    }
+
+    std::size_t size = next_block_size_;
+    if (size < bytes + alignment) size = bytes + alignment;
+    if (next_block_size_ < max_block_size) next_block_size_ *= 2;
+
+    block *b = static_cast<block *>(::operator new(sizeof(block) + size));
+    b->next = nullptr;
+    b->size = size;
+    capacity_ += size;
+    if (current_) {
+      current_->next = b;
+    } else {
+      head_ = b;
+    }
+    current_ = b;
+    enter(b);
+    return bump(bytes, alignment);
+  }
+
+  block *head_;
+  block *current_;
+  std::uintptr_t cur_, end_;
+  std::size_t next_block_size_;
+  std::size_t capacity_;
+};
+
+// Allocator adapter over an arena, deallocate() does nothing. Containers
+// compare equal when they share an arena and keep their own arena on
+// assignment and swap.
+template <typename T>
+class arena_allocator {
+ public:
+  using value_type = T;
+
+  arena_allocator(arena &a) noexcept : arena_(&a) {}
+
+  template <typename U>
+  arena_allocator(const arena_allocator<U> &other) noexcept
+      : arena_(other.arena_) {}
+
+  T *allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+      throw std::bad_array_new_length();
+    return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *, std::size_t) noexcept {}
+
+  arena *resource() const noexcept { return arena_; }
+
+  template <typename U>
+  friend bool operator==(const arena_allocator &lhs,
+                         const arena_allocator<U> &rhs) noexcept {
+    return lhs.arena_ == rhs.resource();
+  }
+
+  template <typename U>
+  friend bool operator!=(const arena_allocator &lhs,
+                         const arena_allocator<U> &rhs) noexcept {
+    return lhs.arena_ != rhs.resource();
+  }
+
+ private:
+  template <typename U>
+  friend class arena_allocator;
+
+  arena *arena_;
+};
+
+// Containers whose allocator is an arena leave trivially destructible
+// elements in place instead of walking them on teardown
+template <typename Allocator>
+struct is_arena_allocator : std::false_type {};
+
+template <typename T>
+struct is_arena_allocator<arena_allocator<T>> : std::true_type {};
+
+}  // namespace s21
+
+#endif
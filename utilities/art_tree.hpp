@@ -0,0 +1,1092 @@
+#ifndef ART_TREE_H
+#define ART_TREE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+// Binary-comparable image of a key: comparing two images byte by byte as
+// unsigned chars, the shorter one first on a tie, orders the keys the way
+// operator< does. encode() returns something with data() and size().
+template <typename Key, typename = void>
+struct radix_key;
+
+template <>
+struct radix_key<std::string_view> {
+  static std::string_view encode(std::string_view key) noexcept {
+    return key;
+  }
+};
+
+template <>
+struct radix_key<std::string> {
+  static std::string_view encode(const std::string &key) noexcept {
+    return key;
+  }
+};
+
+// Integers are laid out big-endian, signed ones with the sign bit flipped
+template <typename Key>
+struct radix_key<Key, std::enable_if_t<std::is_integral<Key>::value &&
+                                       !std::is_same<Key, bool>::value>> {
+  static std::array<unsigned char, sizeof(Key)> encode(Key key) noexcept {
+    using bits_type = std::make_unsigned_t<Key>;
+    bits_type bits = static_cast<bits_type>(key);
+    if (std::is_signed<Key>::value)
+      bits ^= bits_type(bits_type(1) << (sizeof(Key) * 8 - 1));
+    std::array<unsigned char, sizeof(Key)> bytes;
+    for (std::size_t i = sizeof(Key); i--;) {
+      bytes[i] = static_cast<unsigned char>(bits);
+      bits = static_cast<bits_type>(bits >> 7 >> 1);
+    }
+    return bytes;
+  }
+};
+
+// Adaptive radix tree (Leis et al., ICDE 2013) over the radix_key image of
+// Key. Inner nodes grow and shrink between 4, 16, 48 and 256 children, runs
+// of single-child nodes are folded into a prefix of the node below them and
+// a key gets inner nodes only once another key shares its path. The prefix
+// keeps its first max_prefix bytes inline, longer ones are checked against
+// a leaf of the subtree. A key that ends where an inner node begins hangs
+// off that node as its terminal leaf, so string keys may be prefixes of one
+// another. Mapped type void gives a set.
+template <typename Key, typename T, typename Allocator>
+class art_tree {
+  struct node;
+  struct leaf;
+
+ public:
+  using key_type = Key;
+  using value_type = std::conditional_t<std::is_void<T>::value, Key,
+                                        std::pair<const Key, T>>;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  template <bool Const>
+  class basic_iterator;
+
+  using iterator =
+      basic_iterator<std::is_void<T>::value>;  // set elements stay const
+  using const_iterator = basic_iterator<true>;
+
+  art_tree() : art_tree(Allocator()) {}
+  explicit art_tree(const Allocator &alloc) noexcept
+      : alloc_(alloc), root_(nullptr), size_(0) {}
+
+  art_tree(const art_tree &other)
+      : art_tree(other, alloc_traits::select_on_container_copy_construction(
+                            other.alloc_)) {}
+  art_tree(const art_tree &other, const Allocator &alloc) : art_tree(alloc) {
+    root_ = clone(other.root_);
+    size_ = other.size_;
+  }
+  art_tree(art_tree &&other) noexcept
+      : alloc_(std::move(other.alloc_)),
+        root_(std::exchange(other.root_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+  art_tree(art_tree &&other, const Allocator &alloc) : art_tree(alloc) {
+    if (alloc_ == other.alloc_) {
+      std::swap(root_, other.root_);
+      std::swap(size_, other.size_);
+    } else {
+      root_ = clone(other.root_);
+      size_ = other.size_;
+    }
+  }
+
+  ~art_tree() { destroy(root_); }
+
+  art_tree &operator=(const art_tree &other) {
+    if (this == &other) return *this;
+    clear();
+    if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+      alloc_ = other.alloc_;
+    root_ = clone(other.root_);
+    size_ = other.size_;
+    return *this;
+  }
+
+  art_tree &operator=(art_tree &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
+    if (this == &other) return *this;
+    clear();
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+      alloc_ = std::move(other.alloc_);
+    } else if (!(alloc_ == other.alloc_)) {
+      // memory of a foreign allocator can't be adopted, copy the elements
+      root_ = clone(other.root_);
+      size_ = other.size_;
+      return *this;
+    }
+    root_ = std::exchange(other.root_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  allocator_type get_allocator() const noexcept { return alloc_; }
+
+  void clear() noexcept {
+    destroy(root_);
+    root_ = nullptr;
+    size_ = 0;
+  }
+
+  void swap(art_tree &other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+    }
+  }
+
+  iterator begin() noexcept { return iterator(this, minimum(root_)); }
+  iterator end() noexcept { return iterator(this, nullptr); }
+  const_iterator begin() const noexcept {
+    return const_iterator(this, minimum(root_));
+  }
+  const_iterator end() const noexcept { return const_iterator(this, nullptr); }
+
+  iterator find(const Key &key) { return iterator(this, search(key)); }
+  const_iterator find(const Key &key) const {
+    return const_iterator(this, search(key));
+  }
+  bool contains(const Key &key) const { return search(key) != nullptr; }
+
+  // First element not less than key
+  iterator lower_bound(const Key &key) {
+    return iterator(this, seek(key, false));
+  }
+  const_iterator lower_bound(const Key &key) const {
+    return const_iterator(this, seek(key, false));
+  }
+
+  // First element greater than key
+  iterator upper_bound(const Key &key) {
+    return iterator(this, seek(key, true));
+  }
+  const_iterator upper_bound(const Key &key) const {
+    return const_iterator(this, seek(key, true));
+  }
+
+  size_type erase(const Key &key) {
+    auto encoded = radix_key<Key>::encode(key);
+    return erase_at(&root_, view(encoded), 0);
+  }
+
+  // Returns the element after pos
+  iterator erase(const_iterator pos) {
+    iterator next(this, successor(pos.leaf_));
+    // the successor leaf survives, only the erased one is freed
+    erase(key_of(pos.leaf_));
+    return next;
+  }
+
+  // Visits elements in key order, fn(key, value) for maps and fn(key) for
+  // sets; a false return from fn ends the walk
+  template <typename Fn>
+  void for_each(Fn fn) const {
+    walk(root_, fn);
+  }
+
+  // Same for the elements whose key starts with prefix, string keys only
+  template <typename Fn>
+  void for_each_prefix(std::string_view prefix, Fn fn) const {
+    static_assert(std::is_convertible<const Key &, std::string_view>::value,
+                  "for_each_prefix() requires string keys");
+    scan_prefix(bytes{reinterpret_cast<const unsigned char *>(prefix.data()),
+                      prefix.size()},
+                fn);
+  }
+
+  friend bool operator==(const art_tree &lhs, const art_tree &rhs) {
+    if (lhs.size_ != rhs.size_) return false;
+    for (auto l = lhs.begin(), r = rhs.begin(); l != lhs.end(); ++l, ++r)
+      if (!(*l == *r)) return false;
+    return true;
+  }
+
+  friend bool operator!=(const art_tree &lhs, const art_tree &rhs) {
+    return !(lhs == rhs);
+  }
+
+ protected:
+  // Finds the element with key or creates it from make(), which is only
+  // called when the key is new
+  template <typename Make>
+  std::pair<iterator, bool> emplace_with(const Key &key, Make make) {
+    auto encoded = radix_key<Key>::encode(key);
+    auto placed = insert_leaf(view(encoded), make);
+    return {iterator(this, placed.first), placed.second};
+  }
+
+  template <typename... Args>
+  leaf *make_leaf(Args &&...args) {
+    leaf_allocator alloc(alloc_);
+    leaf *l = leaf_traits::allocate(alloc, 1);
+    try {
+      leaf_traits::construct(alloc, l, std::forward<Args>(args)...);
+    } catch (...) {
+      leaf_traits::deallocate(alloc, l, 1);
+      throw;
+    }
+    return l;
+  }
+
+ private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  static constexpr std::uint8_t leaf_kind = 0;
+  static constexpr std::uint8_t node4_kind = 1;
+  static constexpr std::uint8_t node16_kind = 2;
+  static constexpr std::uint8_t node48_kind = 3;
+  static constexpr std::uint8_t node256_kind = 4;
+  static constexpr std::uint32_t max_prefix = 10;
+
+  struct node {
+    std::uint8_t kind;
+  };
+
+  struct leaf : node {
+    template <typename... Args>
+    explicit leaf(Args &&...args)
+        : node{leaf_kind}, value(std::forward<Args>(args)...) {}
+
+    value_type value;
+  };
+
+  struct inner : node {
+    std::uint16_t count;  // children, the terminal leaf is not counted
+    unsigned char prefix[max_prefix];
+    std::uint32_t prefix_len;
+    leaf *terminal;  // key that ends right after the prefix
+  };
+
+  // keys of node4 and node16 are kept sorted for ordered walks
+  struct node4 : inner {
+    unsigned char keys[4];
+    node *children[4];
+  };
+
+  struct node16 : inner {
+    unsigned char keys[16];
+    node *children[16];
+  };
+
+  // index[byte] is the child slot plus one, 0 for none
+  struct node48 : inner {
+    unsigned char index[256];
+    node *children[48];
+  };
+
+  struct node256 : inner {
+    node *children[256];
+  };
+
+  using leaf_allocator = typename alloc_traits::template rebind_alloc<leaf>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+
+  using encoded_type =
+      decltype(radix_key<Key>::encode(std::declval<const Key &>()));
+
+  struct bytes {
+    const unsigned char *data;
+    std::size_t size;
+
+    unsigned char operator[](std::size_t i) const noexcept { return data[i]; }
+  };
+
+  template <typename Encoded>
+  static bytes view(const Encoded &encoded) noexcept {
+    return bytes{reinterpret_cast<const unsigned char *>(encoded.data()),
+                 encoded.size()};
+  }
+
+  static const Key &key_of(const leaf *l) noexcept {
+    if constexpr (std::is_void<T>::value) {
+      return l->value;
+    } else {
+      return l->value.first;
+    }
+  }
+
+  static int compare(bytes lhs, bytes rhs) noexcept {
+    std::size_t common = lhs.size < rhs.size ? lhs.size : rhs.size;
+    int c = common ? std::memcmp(lhs.data, rhs.data, common) : 0;
+    if (c) return c;
+    return lhs.size < rhs.size ? -1 : lhs.size > rhs.size;
+  }
+
+  static bool leaf_matches(const leaf *l, bytes key) {
+    auto encoded = radix_key<Key>::encode(key_of(l));
+    return compare(view(encoded), key) == 0;
+  }
+
+  // node allocation, inner nodes come out zero-filled
+  template <typename N>
+  N *make_inner(std::uint8_t kind) {
+    using node_allocator = typename alloc_traits::template rebind_alloc<N>;
+    node_allocator alloc(alloc_);
+    N *n = std::allocator_traits<node_allocator>::allocate(alloc, 1);
+    std::allocator_traits<node_allocator>::construct(alloc, n);
+    n->kind = kind;
+    return n;
+  }
+
+  template <typename N>
+  void drop(N *n) noexcept {
+    using node_allocator = typename alloc_traits::template rebind_alloc<N>;
+    node_allocator alloc(alloc_);
+    std::allocator_traits<node_allocator>::destroy(alloc, n);
+    std::allocator_traits<node_allocator>::deallocate(alloc, n, 1);
+  }
+
+  void drop_inner(inner *n) noexcept {
+    switch (n->kind) {
+      case node4_kind:
+        drop(static_cast<node4 *>(n));
+        break;
+      case node16_kind:
+        drop(static_cast<node16 *>(n));
+        break;
+      case node48_kind:
+        drop(static_cast<node48 *>(n));
+        break;
+      default:
+        drop(static_cast<node256 *>(n));
+    }
+  }
+
+  void destroy(node *n) noexcept {
+    if (!n) return;
+    if (n->kind == leaf_kind) {
+      drop(static_cast<leaf *>(n));
+      return;
+    }
+    inner *in = static_cast<inner *>(n);
+    destroy(in->terminal);
+    each_child(in, [this](unsigned char, node *child) {
+      destroy(child);
+      return true;
+    });
+    drop_inner(in);
+  }
+
+  node *clone(const node *n) {
+    if (!n) return nullptr;
+    if (n->kind == leaf_kind)
+      return make_leaf(static_cast<const leaf *>(n)->value);
+    const inner *src = static_cast<const inner *>(n);
+    inner *copy = nullptr;
+    switch (src->kind) {
+      case node4_kind:
+        copy = make_inner<node4>(node4_kind);
+        break;
+      case node16_kind:
+        copy = make_inner<node16>(node16_kind);
+        break;
+      case node48_kind:
+        copy = make_inner<node48>(node48_kind);
+        break;
+      default:
+        copy = make_inner<node256>(node256_kind);
+    }
+    copy->prefix_len = src->prefix_len;
+    std::memcpy(copy->prefix, src->prefix, max_prefix);
+    try {
+      copy->terminal = static_cast<leaf *>(clone(src->terminal));
+      each_child(src, [&](unsigned char c, const node *child) {
+        append_child(copy, c, clone(child));
+        return true;
+      });
+    } catch (...) {
+      destroy(copy);
+      throw;
+    }
+    return copy;
+  }
+
+  // children lookups
+
+  static node **find_child(inner *n, unsigned char c) noexcept {
+    switch (n->kind) {
+      case node4_kind: {
+        node4 *n4 = static_cast<node4 *>(n);
+        for (unsigned i = 0; i < n4->count; ++i)
+          if (n4->keys[i] == c) return &n4->children[i];
+        return nullptr;
+      }
+      case node16_kind: {
+        node16 *n16 = static_cast<node16 *>(n);
+#if defined(__SSE2__)
+        __m128i hits = _mm_cmpeq_epi8(
+            _mm_set1_epi8(static_cast<char>(c)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(n16->keys)));
+        unsigned mask =
+            static_cast<unsigned>(_mm_movemask_epi8(hits)) &
+            ((1u << n16->count) - 1);
+        return mask ? &n16->children[__builtin_ctz(mask)] : nullptr;
+#else
+        for (unsigned i = 0; i < n16->count; ++i)
+          if (n16->keys[i] == c) return &n16->children[i];
+        return nullptr;
+#endif
+      }
+      case node48_kind: {
+        node48 *n48 = static_cast<node48 *>(n);
+        unsigned slot = n48->index[c];
+        return slot ? &n48->children[slot - 1] : nullptr;
+      }
+      default: {
+        node256 *n256 = static_cast<node256 *>(n);
+        return n256->children[c] ? &n256->children[c] : nullptr;
+      }
+    }
+  }
+
+  // First child whose byte is greater than after, -1 gives the first one
+  static node *next_child(const inner *n, int after) noexcept {
+    switch (n->kind) {
+      case node4_kind: {
+        const node4 *n4 = static_cast<const node4 *>(n);
+        for (unsigned i = 0; i < n4->count; ++i)
+          if (n4->keys[i] > after) return n4->children[i];
+        return nullptr;
+      }
+      case node16_kind: {
+        const node16 *n16 = static_cast<const node16 *>(n);
+        for (unsigned i = 0; i < n16->count; ++i)
+          if (n16->keys[i] > after) return n16->children[i];
+        return nullptr;
+      }
+      case node48_kind: {
+        const node48 *n48 = static_cast<const node48 *>(n);
+        for (int c = after + 1; c < 256; ++c)
+          if (n48->index[c]) return n48->children[n48->index[c] - 1];
+        return nullptr;
+      }
+      default: {
+        const node256 *n256 = static_cast<const node256 *>(n);
+        for (int c = after + 1; c < 256; ++c)
+          if (n256->children[c]) return n256->children[c];
+        return nullptr;
+      }
+    }
+  }
+
+  // Calls fn(byte, child) for the children of n in byte order until fn
+  // returns false
+  template <typename Fn>
+  static bool each_child(const inner *n, Fn &&fn) {
+    switch (n->kind) {
+      case node4_kind: {
+        const node4 *n4 = static_cast<const node4 *>(n);
+        for (unsigned i = 0; i < n4->count; ++i)
+          if (!fn(n4->keys[i], n4->children[i])) return false;
+        return true;
+      }
+      case node16_kind: {
+        const node16 *n16 = static_cast<const node16 *>(n);
+        for (unsigned i = 0; i < n16->count; ++i)
+          if (!fn(n16->keys[i], n16->children[i])) return false;
+        return true;
+      }
+      case node48_kind: {
+        const node48 *n48 = static_cast<const node48 *>(n);
+        for (unsigned c = 0; c < 256; ++c)
+          if (n48->index[c] &&
+              !fn(static_cast<unsigned char>(c),
+                  n48->children[n48->index[c] - 1]))
+            return false;
+        return true;
+      }
+      default: {
+        const node256 *n256 = static_cast<const node256 *>(n);
+        for (unsigned c = 0; c < 256; ++c)
+          if (n256->children[c] &&
+              !fn(static_cast<unsigned char>(c), n256->children[c]))
+            return false;
+        return true;
+      }
+    }
+  }
+
+  static leaf *minimum(const node *n) noexcept {
+    while (n && n->kind != leaf_kind) {
+      const inner *in = static_cast<const inner *>(n);
+      if (in->terminal) return in->terminal;
+      n = next_child(in, -1);
+    }
+    return const_cast<leaf *>(static_cast<const leaf *>(n));
+  }
+
+  // growing and shrinking
+
+  static void copy_header(inner *dst, const inner *src) noexcept {
+    dst->count = 0;
+    dst->prefix_len = src->prefix_len;
+    std::memcpy(dst->prefix, src->prefix, max_prefix);
+    dst->terminal = src->terminal;
+  }
+
+  static void put48(node48 *n, unsigned slot, unsigned char c,
+                    node *child) noexcept {
+    n->children[slot] = child;
+    n->index[c] = static_cast<unsigned char>(slot + 1);
+    ++n->count;
+  }
+
+  static void put256(node256 *n, unsigned char c, node *child) noexcept {
+    n->children[c] = child;
+    ++n->count;
+  }
+
+  // Adds a child with a byte above all present ones, n has room for it
+  static void append_child(inner *n, unsigned char c, node *child) noexcept {
+    switch (n->kind) {
+      case node4_kind: {
+        node4 *n4 = static_cast<node4 *>(n);
+        n4->keys[n4->count] = c;
+        n4->children[n4->count++] = child;
+        break;
+      }
+      case node16_kind: {
+        node16 *n16 = static_cast<node16 *>(n);
+        n16->keys[n16->count] = c;
+        n16->children[n16->count++] = child;
+        break;
+      }
+      case node48_kind:
+        put48(static_cast<node48 *>(n), n->count, c, child);
+        break;
+      default:
+        put256(static_cast<node256 *>(n), c, child);
+    }
+  }
+
+  template <typename N>
+  static void insert_sorted(N *n, unsigned char c, node *child) noexcept {
+    unsigned i = n->count;
+    for (; i && n->keys[i - 1] > c; --i) {
+      n->keys[i] = n->keys[i - 1];
+      n->children[i] = n->children[i - 1];
+    }
+    n->keys[i] = c;
+    n->children[i] = child;
+    ++n->count;
+  }
+
+  // Moves every child of from into the empty node to, in byte order
+  static void move_children(const inner *from, inner *to) noexcept {
+    each_child(from, [to](unsigned char c, node *child) {
+      append_child(to, c, child);
+      return true;
+    });
+  }
+
+  template <typename N>
+  N *regrow(inner *n, std::uint8_t kind) {
+    N *bigger = make_inner<N>(kind);
+    copy_header(bigger, n);
+    move_children(n, bigger);
+    drop_inner(n);
+    return bigger;
+  }
+
+  // Adds child under byte c, *ref is replaced when n has to grow
+  void add_child(node **ref, inner *n, unsigned char c, node *child) {
+    switch (n->kind) {
+      case node4_kind:
+        if (n->count < 4) {
+          insert_sorted(static_cast<node4 *>(n), c, child);
+          return;
+        }
+        n = regrow<node16>(n, node16_kind);
+        *ref = n;
+        insert_sorted(static_cast<node16 *>(n), c, child);
+        return;
+      case node16_kind: {
+        if (n->count < 16) {
+          insert_sorted(static_cast<node16 *>(n), c, child);
+          return;
+        }
+        node48 *n48 = regrow<node48>(n, node48_kind);
+        *ref = n48;
+        put48(n48, n48->count, c, child);
+        return;
+      }
+      case node48_kind: {
+        if (n->count == 48) {
+          node256 *n256 = regrow<node256>(n, node256_kind);
+          *ref = n256;
+          put256(n256, c, child);
+          return;
+        }
+        // erased children leave holes, take the first free slot
+        node48 *n48 = static_cast<node48 *>(n);
+        unsigned slot = 0;
+        while (n48->children[slot]) ++slot;
+        put48(n48, slot, c, child);
+        return;
+      }
+      default:
+        put256(static_cast<node256 *>(n), c, child);
+    }
+  }
+
+  // Removes the child under byte c and shrinks n once it gets sparse
+  void remove_child(node **ref, inner *n, unsigned char c) {
+    switch (n->kind) {
+      case node4_kind:
+        remove_sorted(static_cast<node4 *>(n), c);
+        return;
+      case node16_kind:
+        remove_sorted(static_cast<node16 *>(n), c);
+        if (n->count == 3) *ref = regrow<node4>(n, node4_kind);
+        return;
+      case node48_kind: {
+        node48 *n48 = static_cast<node48 *>(n);
+        n48->children[n48->index[c] - 1] = nullptr;
+        n48->index[c] = 0;
+        if (--n48->count == 12) *ref = regrow<node16>(n, node16_kind);
+        return;
+      }
+      default:
+        static_cast<node256 *>(n)->children[c] = nullptr;
+        if (--n->count == 37) *ref = regrow<node48>(n, node48_kind);
+    }
+  }
+
+  template <typename N>
+  static void remove_sorted(N *n, unsigned char c) noexcept {
+    unsigned i = 0;
+    while (n->keys[i] != c) ++i;
+    for (--n->count; i < n->count; ++i) {
+      n->keys[i] = n->keys[i + 1];
+      n->children[i] = n->children[i + 1];
+    }
+  }
+
+  // A node4 left with a single entry is replaced by it. An inner child
+  // takes over the path: its prefix becomes prefix + byte + own prefix.
+  void collapse(node **ref, std::size_t depth) {
+    inner *n = static_cast<inner *>(*ref);
+    if (n->kind != node4_kind) return;
+    if (n->count == 0) {
+      *ref = n->terminal;
+      drop(static_cast<node4 *>(n));
+      return;
+    }
+    if (n->count > 1 || n->terminal) return;
+
+    node *child = static_cast<node4 *>(n)->children[0];
+    if (child->kind != leaf_kind) {
+      inner *below = static_cast<inner *>(child);
+      std::uint32_t len = n->prefix_len + 1 + below->prefix_len;
+      auto encoded = radix_key<Key>::encode(key_of(minimum(below)));
+      bytes path = view(encoded);
+      std::uint32_t stored = len < max_prefix ? len : max_prefix;
+      std::memcpy(below->prefix, path.data + depth, stored);
+      below->prefix_len = len;
+    }
+    *ref = child;
+    drop(static_cast<node4 *>(n));
+  }
+
+  // prefix checks
+
+  // Whole prefix of n starting at depth, from the inline bytes or from a
+  // leaf below n whose encoded key is kept in scratch
+  static const unsigned char *prefix_bytes(const inner *n, std::size_t depth,
+                                           encoded_type &scratch) {
+    if (n->prefix_len <= max_prefix) return n->prefix;
+    scratch = radix_key<Key>::encode(key_of(minimum(n)));
+    return view(scratch).data + depth;
+  }
+
+  // Index of the first byte where key leaves the prefix of n, prefix_len
+  // when the whole prefix matches
+  static std::uint32_t prefix_mismatch(const inner *n, bytes key,
+                                       std::size_t depth) {
+    encoded_type scratch{};
+    const unsigned char *path = prefix_bytes(n, depth, scratch);
+    for (std::uint32_t i = 0; i < n->prefix_len; ++i)
+      if (depth + i >= key.size || key[depth + i] != path[i]) return i;
+    return n->prefix_len;
+  }
+
+  static void set_prefix(inner *n, const unsigned char *from,
+                         std::uint32_t len) noexcept {
+    n->prefix_len = len;
+    std::memcpy(n->prefix, from, len < max_prefix ? len : max_prefix);
+  }
+
+  // Puts l at depth of the fresh node4 n, as terminal when its key ends
+  static void place(node4 *n, bytes key, std::size_t depth, leaf *l) {
+    if (key.size == depth) {
+      n->terminal = l;
+    } else {
+      insert_sorted(n, key[depth], l);
+    }
+  }
+
+  // core operations
+
+  leaf *search(const Key &k) const {
+    auto encoded = radix_key<Key>::encode(k);
+    bytes key = view(encoded);
+    const node *n = root_;
+    std::size_t depth = 0;
+    while (n) {
+      if (n->kind == leaf_kind) {
+        const leaf *l = static_cast<const leaf *>(n);
+        return leaf_matches(l, key) ? const_cast<leaf *>(l) : nullptr;
+      }
+      inner *in = const_cast<inner *>(static_cast<const inner *>(n));
+      // optimistic: bytes past the inline ones are checked at the leaf
+      std::uint32_t stored =
+          in->prefix_len < max_prefix ? in->prefix_len : max_prefix;
+      for (std::uint32_t i = 0; i < stored; ++i)
+        if (depth + i >= key.size || key[depth + i] != in->prefix[i])
+          return nullptr;
+      depth += in->prefix_len;
+      if (depth >= key.size) {
+        if (depth > key.size || !in->terminal) return nullptr;
+        return leaf_matches(in->terminal, key) ? in->terminal : nullptr;
+      }
+      node **child = find_child(in, key[depth++]);
+      n = child ? *child : nullptr;
+    }
+    return nullptr;
+  }
+
+  template <typename Make>
+  std::pair<leaf *, bool> insert_leaf(bytes key, Make &make) {
+    node **ref = &root_;
+    std::size_t depth = 0;
+    while (true) {
+      node *n = *ref;
+      if (!n) {
+        leaf *l = make();
+        *ref = l;
+        ++size_;
+        return {l, true};
+      }
+
+      if (n->kind == leaf_kind) {
+        // lazy expansion ends: a node4 takes both keys past their common run
+        leaf *old = static_cast<leaf *>(n);
+        auto encoded = radix_key<Key>::encode(key_of(old));
+        bytes path = view(encoded);
+        if (compare(path, key) == 0) return {old, false};
+        std::size_t common = 0;
+        while (depth + common < path.size && depth + common < key.size &&
+               path[depth + common] == key[depth + common])
+          ++common;
+
+        leaf *l = make();
+        node4 *split;
+        try {
+          split = make_inner<node4>(node4_kind);
+        } catch (...) {
+          drop(l);
+          throw;
+        }
+        set_prefix(split, path.data + depth,
+                   static_cast<std::uint32_t>(common));
+        place(split, path, depth + common, old);
+        place(split, key, depth + common, l);
+        *ref = split;
+        ++size_;
+        return {l, true};
+      }
+
+      inner *in = static_cast<inner *>(n);
+      std::uint32_t mismatch = prefix_mismatch(in, key, depth);
+      if (mismatch < in->prefix_len) {
+        // key leaves the compressed path: split it at the mismatch
+        encoded_type scratch{};
+        const unsigned char *path = prefix_bytes(in, depth, scratch);
+
+        leaf *l = make();
+        node4 *split;
+        try {
+          split = make_inner<node4>(node4_kind);
+        } catch (...) {
+          drop(l);
+          throw;
+        }
+        set_prefix(split, path, mismatch);
+        unsigned char below = path[mismatch];
+        // path may be in->prefix itself, hence memmove
+        std::uint32_t rest = in->prefix_len - mismatch - 1;
+        std::memmove(in->prefix, path + mismatch + 1,
+                     rest < max_prefix ? rest : max_prefix);
+        in->prefix_len = rest;
+        insert_sorted(split, below, in);
+        place(split, key, depth + mismatch, l);
+        *ref = split;
+        ++size_;
+        return {l, true};
+      }
+
+      depth += in->prefix_len;
+      if (depth == key.size) {
+        if (in->terminal) return {in->terminal, false};
+        in->terminal = make();
+        ++size_;
+        return {in->terminal, true};
+      }
+
+      node **child = find_child(in, key[depth]);
+      if (!child) {
+        leaf *l = make();
+        try {
+          add_child(ref, in, key[depth], l);
+        } catch (...) {
+          drop(l);
+          throw;
+        }
+        ++size_;
+        return {l, true};
+      }
+      ref = child;
+      ++depth;
+    }
+  }
+
+  size_type erase_at(node **ref, bytes key, std::size_t depth) {
+    node *n = *ref;
+    if (!n) return 0;
+    if (n->kind == leaf_kind) {
+      if (!leaf_matches(static_cast<leaf *>(n), key)) return 0;
+      drop(static_cast<leaf *>(n));
+      *ref = nullptr;
+      --size_;
+      return 1;
+    }
+
+    inner *in = static_cast<inner *>(n);
+    if (prefix_mismatch(in, key, depth) < in->prefix_len) return 0;
+    std::size_t start = depth;
+    depth += in->prefix_len;
+
+    if (depth == key.size) {
+      if (!in->terminal) return 0;
+      drop(in->terminal);
+      in->terminal = nullptr;
+      --size_;
+      collapse(ref, start);
+      return 1;
+    }
+
+    unsigned char c = key[depth];
+    node **child = find_child(in, c);
+    if (!child) return 0;
+    if ((*child)->kind != leaf_kind) return erase_at(child, key, depth + 1);
+
+    leaf *l = static_cast<leaf *>(*child);
+    if (!leaf_matches(l, key)) return 0;
+    drop(l);
+    --size_;
+    remove_child(ref, in, c);
+    collapse(ref, start);
+    return 1;
+  }
+
+  leaf *seek(const Key &k, bool strict) const {
+    auto encoded = radix_key<Key>::encode(k);
+    return seek_at(root_, view(encoded), 0, strict);
+  }
+
+  // First leaf of n with a key above key (strict) or not below it
+  static leaf *seek_at(const node *n, bytes key, std::size_t depth,
+                       bool strict) {
+    if (!n) return nullptr;
+    if (n->kind == leaf_kind) {
+      const leaf *l = static_cast<const leaf *>(n);
+      auto encoded = radix_key<Key>::encode(key_of(l));
+      int c = compare(view(encoded), key);
+      return c > 0 || (c == 0 && !strict) ? const_cast<leaf *>(l) : nullptr;
+    }
+
+    inner *in = const_cast<inner *>(static_cast<const inner *>(n));
+    if (in->prefix_len) {
+      encoded_type scratch{};
+      const unsigned char *path = prefix_bytes(in, depth, scratch);
+      for (std::uint32_t i = 0; i < in->prefix_len; ++i) {
+        // a key that ends inside the prefix precedes the whole subtree
+        if (depth + i == key.size) return minimum(in);
+        if (key[depth + i] != path[i])
+          return key[depth + i] < path[i] ? minimum(in) : nullptr;
+      }
+      depth += in->prefix_len;
+    }
+
+    if (depth == key.size) {
+      if (!strict) return minimum(in);
+      node *first = next_child(in, -1);
+      return first ? minimum(first) : nullptr;
+    }
+
+    unsigned char c = key[depth];
+    if (node **child = find_child(in, c))
+      if (leaf *l = seek_at(*child, key, depth + 1, strict)) return l;
+    node *next = next_child(in, c);
+    return next ? minimum(next) : nullptr;
+  }
+
+  leaf *successor(const leaf *l) const {
+    return l ? seek(key_of(l), true) : nullptr;
+  }
+
+  template <typename Fn>
+  static bool visit(Fn &fn, leaf *l) {
+    if constexpr (std::is_void<T>::value) {
+      if constexpr (std::is_void<decltype(fn(l->value))>::value) {
+        fn(static_cast<const Key &>(l->value));
+        return true;
+      } else {
+        return static_cast<bool>(fn(static_cast<const Key &>(l->value)));
+      }
+    } else {
+      if constexpr (std::is_void<decltype(fn(l->value.first,
+                                             l->value.second))>::value) {
+        fn(l->value.first, l->value.second);
+        return true;
+      } else {
+        return static_cast<bool>(fn(l->value.first, l->value.second));
+      }
+    }
+  }
+
+  template <typename Fn>
+  static bool walk(const node *n, Fn &fn) {
+    if (!n) return true;
+    if (n->kind == leaf_kind)
+      return visit(fn, const_cast<leaf *>(static_cast<const leaf *>(n)));
+    const inner *in = static_cast<const inner *>(n);
+    if (in->terminal && !visit(fn, in->terminal)) return false;
+    return each_child(in,
+                      [&fn](unsigned char, const node *child) {
+                        return walk(child, fn);
+                      });
+  }
+
+  template <typename Fn>
+  void scan_prefix(bytes prefix, Fn &fn) const {
+    const node *n = root_;
+    std::size_t depth = 0;
+    while (n) {
+      if (n->kind == leaf_kind) {
+        const leaf *l = static_cast<const leaf *>(n);
+        auto encoded = radix_key<Key>::encode(key_of(l));
+        bytes key = view(encoded);
+        if (key.size >= prefix.size &&
+            std::memcmp(key.data, prefix.data, prefix.size) == 0)
+          visit(fn, const_cast<leaf *>(l));
+        return;
+      }
+      inner *in = const_cast<inner *>(static_cast<const inner *>(n));
+      if (in->prefix_len) {
+        encoded_type scratch{};
+        const unsigned char *path = prefix_bytes(in, depth, scratch);
+        for (std::uint32_t i = 0; i < in->prefix_len; ++i) {
+          if (depth + i == prefix.size) {
+            walk(in, fn);
+            return;
+          }
+          if (prefix[depth + i] != path[i]) return;
+        }
+        depth += in->prefix_len;
+      }
+      if (depth == prefix.size) {
+        walk(in, fn);
+        return;
+      }
+      node **child = find_child(in, prefix[depth++]);
+      n = child ? *child : nullptr;
+    }
+  }
+
+  Allocator alloc_;
+  node *root_;
+  size_type size_;
+};
+
+template <typename Key, typename T, typename Allocator>
+template <bool Const>
+class art_tree<Key, T, Allocator>::basic_iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename art_tree::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+  using reference =
+      std::conditional_t<Const, const value_type &, value_type &>;
+
+  basic_iterator() noexcept : tree_(nullptr), leaf_(nullptr) {}
+
+  // iterator converts to const_iterator
+  template <bool OtherConst,
+            typename = std::enable_if_t<Const && !OtherConst>>
+  basic_iterator(const basic_iterator<OtherConst> &other) noexcept
+      : tree_(other.tree_), leaf_(other.leaf_) {}
+
+  reference operator*() const noexcept { return leaf_->value; }
+  pointer operator->() const noexcept { return &leaf_->value; }
+
+  // the next leaf is found by a search from the root, O(key length)
+  basic_iterator &operator++() {
+    leaf_ = tree_->successor(leaf_);
+    return *this;
+  }
+
+  basic_iterator operator++(int) {
+    basic_iterator tmp(*this);
+    ++(*this);
+    return tmp;
+  }
+
+  friend bool operator==(const basic_iterator &lhs,
+                         const basic_iterator &rhs) noexcept {
+    return lhs.leaf_ == rhs.leaf_;
+  }
+
+  friend bool operator!=(const basic_iterator &lhs,
+                         const basic_iterator &rhs) noexcept {
+    return lhs.leaf_ != rhs.leaf_;
+  }
+
+ private:
+  friend class art_tree;
+  template <bool>
+  friend class basic_iterator;
+
+  basic_iterator(const art_tree *tree, leaf *l) noexcept
+      : tree_(tree), leaf_(l) {}
+
+  const art_tree *tree_;
+  leaf *leaf_;
+};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef EYTZINGER_LAYOUT_H
+#define EYTZINGER_LAYOUT_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace s21 {
+
+// Sorted keys stored in BFS (Eytzinger) order in one cache-line aligned
+// array. Slot 0 is unused, the children of slot k are 2k and 2k + 1, so the
+// search is a branchless descent and the next levels can be prefetched.
+template <typename Key>
+class eytzinger_layout {
+ public:
+  using size_type = std::size_t;
+
+  static constexpr size_type alignment = 64;
+  static constexpr size_type npos = 0;
+
+  eytzinger_layout() noexcept : keys_(nullptr), size_(0) {}
+
+  // [first, first + count) must be sorted and free of duplicates
+  template <typename InputIt>
+  eytzinger_layout(InputIt first, size_type count) : eytzinger_layout() {
+    if (!count) return;
+    keys_ = allocate(count);
+    size_ = count;
+    size_type built = 0;
+    try {
+      build(first, built, 1);
+    } catch (...) {
+      destroy(built);
+      throw;
+    }
+  }
+
+  // The keys are copied into a block of its own first, so a throwing copy
+  // leaves nothing for the destructor to end
+  eytzinger_layout(const eytzinger_layout &other) : eytzinger_layout() {
+    if (!other.size_) return;
+    Key *keys = allocate(other.size_);
+    try {
+      std::uninitialized_copy(other.keys_ + 1, other.keys_ + other.size_ + 1,
+                              keys + 1);
+    } catch (...) {
+      deallocate(keys);
+      throw;
+    }
+    keys_ = keys;
+    size_ = other.size_;
+  }
+
+  eytzinger_layout(eytzinger_layout &&other) noexcept
+      : keys_(other.keys_), size_(other.size_) {
+    other.keys_ = nullptr;
+    other.size_ = 0;
+  }
+
+  ~eytzinger_layout() { destroy(size_); }
+
+  eytzinger_layout &operator=(eytzinger_layout other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  void swap(eytzinger_layout &other) noexcept {
+    std::swap(keys_, other.keys_);
+    std::swap(size_, other.size_);
+  }
+
+  size_type size() const noexcept { return size_; }
+  const Key &operator[](size_type slot) const noexcept { return keys_[slot]; }
+
+  // Slot of the first key not less than key, npos if there is none
+  size_type lower_bound(const Key &key) const noexcept {
+    size_type k = 1;
+    while (k <= size_) {
+      __builtin_prefetch(keys_ + k * prefetch_stride);
+      k = 2 * k + (keys_[k] < key);
+    }
+    return climb(k);
+  }
+
+  size_type find(const Key &key) const noexcept {
+    size_type k = lower_bound(key);
+    return (k != npos && !(key < keys_[k])) ? k : npos;
+  }
+
+  // Runs up to search_group lookups in lockstep so their cache misses
+  // overlap; visit(slot) gets the find() result of every key in input order
+  template <typename ForwardIt, typename Visitor>
+  void find_many(ForwardIt first, ForwardIt last, Visitor visit) const {
+    constexpr size_type search_group = 16;
+    ForwardIt keys[search_group];
+    size_type slots[search_group];
+
+    while (first != last) {
+      size_type group = 0;
+      for (; group < search_group && first != last; ++group, ++first) {
+        keys[group] = first;
+        slots[group] = 1;
+      }
+
+      bool active = true;
+      while (active) {
+        active = false;
+        for (size_type i = 0; i < group; ++i) {
+          size_type k = slots[i];
+          if (k > size_) continue;
+          __builtin_prefetch(keys_ + k * prefetch_stride);
+          slots[i] = 2 * k + (keys_[k] < *keys[i]);
+          active = true;
+        }
+      }
+
+      for (size_type i = 0; i < group; ++i) {
+        size_type k = climb(slots[i]);
+        visit((k != npos && !(*keys[i] < keys_[k])) ? k : npos);
+      }
+    }
+  }
+
+  // In-order traversal over the slots
+  size_type first() const noexcept {
+    if (!size_) return npos;
+    size_type k = 1;
+    while (2 * k <= size_) k *= 2;
+    return k;
+  }
+
+  size_type next(size_type k) const noexcept {
+    if (2 * k + 1 <= size_) {
+      k = 2 * k + 1;
+      while (2 * k <= size_) k *= 2;
+      return k;
+    }
+    return climb(k);
+  }
+
+ private:
+  // Strips the trailing right turns of a descent and one left turn more,
+  // which lands on the last node the search went left from
+  static size_type climb(size_type k) noexcept {
+    return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+  }
+
+  // Descendants four levels down share one cache line for 4-byte keys
+  static constexpr size_type prefetch_stride =
+      sizeof(Key) < alignment ? alignment / sizeof(Key) : 1;
+
+  static Key *allocate(size_type count) {
+    return static_cast<Key *>(::operator new(
+        (count + 1) * sizeof(Key), std::align_val_t(alignment)));
+  }
+
+  static void deallocate(Key *keys) noexcept {
+    ::operator delete(keys, std::align_val_t(alignment));
+  }
+
+  template <typename InputIt>
+  void build(InputIt &it, size_type &built, size_type k) {
+    if (k > size_) return;
+    build(it, built, 2 * k);
+    ::new (static_cast<void *>(keys_ + k)) Key(*it);
+    ++it;
+    ++built;
+    build(it, built, 2 * k + 1);
+  }
+
+  // Only the first `built` keys in in-order are alive on a failed build
+  void destroy(size_type built) noexcept {
+    if (!keys_) return;
+    for (size_type k = first(); k != npos && built; k = next(k), --built)
+      keys_[k].~Key();
+    deallocate(keys_);
+    keys_ = nullptr;
+    size_ = 0;
+  }
+
+  Key *keys_;
+  size_type size_;
+};
+
+}  // namespace s21
+
+#endif
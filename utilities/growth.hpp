@@ -0,0 +1,53 @@
+#ifndef GROWTH_H
+#define GROWTH_H
+
+#include <cstddef>
+
+namespace s21 {
+
+// Growth policies for s21::vector. grow(capacity, needed, element_size) is
+// the capacity to move to when needed elements don't fit in capacity; it is
+// never below needed. reserve() asks with capacity 0, so a policy that
+// rounds reserved sizes does it there.
+
+// Doubles the capacity, fewest reallocations for the most slack
+struct double_growth {
+  static constexpr std::size_t grow(std::size_t capacity, std::size_t needed,
+                                    std::size_t) noexcept {
+    std::size_t next = capacity * 2 + (capacity == 0);
+    return next < needed ? needed : next;
+  }
+};
+
+// Grows by half: at most a third of the block is slack, and the blocks freed
+// along the way add up to a later request, so the allocator can reuse them
+struct golden_growth {
+  static constexpr std::size_t grow(std::size_t capacity, std::size_t needed,
+                                    std::size_t) noexcept {
+    std::size_t next = capacity + (capacity > 1 ? capacity / 2 : 1);
+    return next < needed ? needed : next;
+  }
+};
+
+// Grows by half and then fills the block up to the size class the allocator
+// would round the request to anyway: four classes per power of two, as in
+// jemalloc and tcmalloc, so the extra elements cost no memory
+struct size_class_growth {
+  static constexpr std::size_t size_class(std::size_t bytes) noexcept {
+    if (bytes <= 16) return 16;
+    int top = 63 - __builtin_clzll(bytes - 1);
+    std::size_t step = top < 6 ? 16 : std::size_t(1) << (top - 2);
+    return (bytes + step - 1) & ~(step - 1);
+  }
+
+  static constexpr std::size_t grow(std::size_t capacity, std::size_t needed,
+                                    std::size_t element_size) noexcept {
+    std::size_t next = golden_growth::grow(capacity, needed, element_size);
+    std::size_t fitted = size_class(next * element_size) / element_size;
+    return fitted < next ? next : fitted;
+  }
+};
+
+}  // namespace s21
+
+#endif
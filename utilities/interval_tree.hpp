@@ -0,0 +1,113 @@
+#ifndef INTERVAL_TREE_H
+#define INTERVAL_TREE_H
+
+#include <stdexcept>
+
+#include "rb_tree.hpp"
+
+namespace s21 {
+
+template <typename Key, typename Value>
+struct interval_entry {
+  Key hi;
+  Value value;
+};
+
+template <typename Key>
+struct interval_entry<Key, void> {
+  Key hi;
+};
+
+template <typename Key>
+struct interval_tree_traits : tree_traits {
+  using augment = max_end_augment<Key>;
+};
+
+// Closed intervals [lo, hi] in a RedBlackTree keyed by lo whose nodes also
+// keep the largest hi of their subtree. The queries hand every match to a
+// callback and allocate nothing: fn(lo, hi, value&) for interval_map,
+// fn(lo, hi) for interval_set.
+//
+// A query only descends into subtrees whose largest hi still reaches it, and
+// every such subtree either holds a match or ends the walk, so it runs in
+// O(min(n, (k + 1) log n)) for k matches. Matches are not consecutive in lo
+// order, so stepping to successors can't do better; O(log n + k) needs a
+// different layout such as a centered interval tree.
+template <typename Key, typename Value, typename Allocator>
+class interval_tree {
+ public:
+  using key_type = Key;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using entry_type = interval_entry<Key, Value>;
+  using tree_type =
+      RedBlackTree<Key, entry_type, Allocator, interval_tree_traits<Key>>;
+
+  interval_tree() : tree_() {}
+  explicit interval_tree(const allocator_type &alloc) : tree_(alloc) {}
+
+  bool empty() const noexcept { return tree_.empty(); }
+  size_type size() const noexcept { return tree_.size(); }
+  void clear() noexcept { tree_.clear(); }
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  }
+
+  // Removes one stored copy of [lo, hi], false if there is none
+  bool erase(const Key &lo, const Key &hi) {
+    return tree_.eraseMatching(lo, [&](const entry_type &entry) {
+      return !(entry.hi < hi) && !(hi < entry.hi);
+    });
+  }
+
+  // Intervals sharing at least one point with [lo, hi], O((k + 1) log n)
+  template <typename Fn>
+  void overlap(const Key &lo, const Key &hi, Fn fn) {
+    tree_.searchAugmented(
+        [&](const Key &max_end) { return max_end < lo; },
+        [&](const Key &start) { return hi < start; },
+        [&](const Key &start, entry_type &entry) {
+          if (!(entry.hi < lo)) report(fn, start, entry);
+        });
+  }
+
+  // Intervals containing point
+  template <typename Fn>
+  void stab(const Key &point, Fn fn) {
+    overlap(point, point, fn);
+  }
+
+  // Intervals containing the whole of [lo, hi], O((k + 1) log n)
+  template <typename Fn>
+  void enclosing(const Key &lo, const Key &hi, Fn fn) {
+    tree_.searchAugmented(
+        [&](const Key &max_end) { return max_end < hi; },
+        [&](const Key &start) { return lo < start; },
+        [&](const Key &start, entry_type &entry) {
+          if (!(entry.hi < hi)) report(fn, start, entry);
+        });
+  }
+
+ protected:
+  void insert_entry(const Key &lo, const entry_type &entry) {
+    if (entry.hi < lo)
+      throw std::invalid_argument("Interval end precedes its start");
+    tree_.insert(lo, entry);
+  }
+
+ private:
+  template <typename Fn>
+  static void report(Fn &fn, const Key &start, entry_type &entry) {
+    if constexpr (std::is_void<Value>::value) {
+      fn(start, entry.hi);
+    } else {
+      fn(start, entry.hi, entry.value);
+    }
+  }
+
+  tree_type tree_;
+};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef KARY_LAYOUT_H
+#define KARY_LAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+
+// Static B-tree over integer keys: every node is one 64-byte cache line of
+// sorted keys and the rank of the query inside a node is computed with a
+// single SIMD compare. Node k has its children at k * (lanes + 1) + i + 1.
+template <typename Key>
+class kary_layout {
+  static_assert(std::is_integral<Key>::value &&
+                    (sizeof(Key) == 4 || sizeof(Key) == 8),
+                "kary_layout supports 32 and 64 bit integer keys only");
+
+ public:
+  using size_type = std::size_t;
+  // Keys are kept as signed lanes, unsigned ones are biased by the sign bit
+  using lane_type = typename std::make_signed<Key>::type;
+
+  static constexpr size_type alignment = 64;
+  static constexpr size_type lanes = alignment / sizeof(Key);
+
+  kary_layout() noexcept
+      : nodes_(nullptr), blocks_(0), size_(0), has_max_(false) {}
+
+  // [first, first + count) must be sorted and free of duplicates
+  template <typename InputIt>
+  kary_layout(InputIt first, size_type count) : kary_layout() {
+    if (!count) return;
+    size_ = count;
+    blocks_ = (count + lanes - 1) / lanes;
+    nodes_ = static_cast<lane_type *>(::operator new(
+        blocks_ * lanes * sizeof(lane_type), std::align_val_t(alignment)));
+    size_type taken = 0;
+    build(first, taken, 0);
+  }
+
+  kary_layout(const kary_layout &) = delete;
+  kary_layout(kary_layout &&other) noexcept : kary_layout() { swap(other); }
+
+  ~kary_layout() {
+    if (nodes_) ::operator delete(nodes_, std::align_val_t(alignment));
+  }
+
+  kary_layout &operator=(const kary_layout &) = delete;
+  kary_layout &operator=(kary_layout &&other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  void swap(kary_layout &other) noexcept {
+    std::swap(nodes_, other.nodes_);
+    std::swap(blocks_, other.blocks_);
+    std::swap(size_, other.size_);
+    std::swap(has_max_, other.has_max_);
+  }
+
+  size_type size() const noexcept { return size_; }
+
+  bool contains(Key key) const noexcept {
+    const lane_type x = to_lane(key);
+    const lane_type *found = nullptr;
+    size_type k = 0;
+    while (k < blocks_) {
+      const lane_type *node = nodes_ + k * lanes;
+      unsigned i = rank(x, node);
+      if (i < lanes) found = node + i;
+      k = k * (lanes + 1) + i + 1;
+    }
+    if (!found || *found != x) return false;
+    // padding slots hold the maximum lane as well
+    return x != std::numeric_limits<lane_type>::max() || has_max_;
+  }
+
+  // Lockstep variant of contains(): up to search_group descents advance one
+  // node per round and visit(bool) is called for every key in input order
+  template <typename ForwardIt, typename Visitor>
+  void contains_many(ForwardIt first, ForwardIt last, Visitor visit) const {
+    constexpr size_type search_group = 16;
+    lane_type xs[search_group];
+    size_type ks[search_group];
+    const lane_type *found[search_group];
+
+    while (first != last) {
+      size_type group = 0;
+      for (; group < search_group && first != last; ++group, ++first) {
+        xs[group] = to_lane(*first);
+        ks[group] = 0;
+        found[group] = nullptr;
+      }
+
+      bool active = true;
+      while (active) {
+        active = false;
+        for (size_type i = 0; i < group; ++i) {
+          if (ks[i] >= blocks_) continue;
+          const lane_type *node = nodes_ + ks[i] * lanes;
+          unsigned r = rank(xs[i], node);
+          if (r < lanes) found[i] = node + r;
+          ks[i] = ks[i] * (lanes + 1) + r + 1;
+          if (ks[i] < blocks_) __builtin_prefetch(nodes_ + ks[i] * lanes);
+          active = true;
+        }
+      }
+
+      for (size_type i = 0; i < group; ++i)
+        visit(found[i] && *found[i] == xs[i] &&
+              (xs[i] != std::numeric_limits<lane_type>::max() || has_max_));
+    }
+  }
+
+ private:
+  static lane_type to_lane(Key key) noexcept {
+    if (std::is_signed<Key>::value) return static_cast<lane_type>(key);
+    constexpr Key bias = Key(1) << (sizeof(Key) * 8 - 1);
+    return static_cast<lane_type>(static_cast<Key>(key ^ bias));
+  }
+
+  template <typename InputIt>
+  void build(InputIt &it, size_type &taken, size_type k) {
+    if (k >= blocks_) return;
+    for (size_type i = 0; i < lanes; ++i) {
+      build(it, taken, k * (lanes + 1) + i + 1);
+      lane_type lane = std::numeric_limits<lane_type>::max();
+      if (taken < size_) {
+        lane = to_lane(*it);
+        ++it;
+        ++taken;
+        if (lane == std::numeric_limits<lane_type>::max()) has_max_ = true;
+      }
+      nodes_[k * lanes + i] = lane;
+    }
+    build(it, taken, k * (lanes + 1) + lanes + 1);
+  }
+
+  // Number of keys in the node that are less than x
+  static unsigned rank(lane_type x, const lane_type *node) noexcept {
+#if defined(__AVX2__)
+    if (sizeof(lane_type) == 4) {
+      __m256i xv = _mm256_set1_epi32(static_cast<int>(x));
+      const __m256i *p = reinterpret_cast<const __m256i *>(node);
+      __m256i lo = _mm256_cmpgt_epi32(xv, _mm256_load_si256(p));
+      __m256i hi = _mm256_cmpgt_epi32(xv, _mm256_load_si256(p + 1));
+      return __builtin_popcount(
+          _mm256_movemask_ps(_mm256_castsi256_ps(lo)) |
+          (_mm256_movemask_ps(_mm256_castsi256_ps(hi)) << 8));
+    } else {
+      __m256i xv = _mm256_set1_epi64x(static_cast<long long>(x));
+      const __m256i *p = reinterpret_cast<const __m256i *>(node);
+      __m256i lo = _mm256_cmpgt_epi64(xv, _mm256_load_si256(p));
+      __m256i hi = _mm256_cmpgt_epi64(xv, _mm256_load_si256(p + 1));
+      return __builtin_popcount(
+          _mm256_movemask_pd(_mm256_castsi256_pd(lo)) |
+          (_mm256_movemask_pd(_mm256_castsi256_pd(hi)) << 4));
+    }
+#elif defined(__SSE2__)
+    if (sizeof(lane_type) == 4) {
+      __m128i xv = _mm_set1_epi32(static_cast<int>(x));
+      const __m128i *p = reinterpret_cast<const __m128i *>(node);
+      int mask = 0;
+      for (int i = 0; i < 4; ++i) {
+        __m128i gt = _mm_cmpgt_epi32(xv, _mm_load_si128(p + i));
+        mask |= _mm_movemask_ps(_mm_castsi128_ps(gt)) << (4 * i);
+      }
+      return __builtin_popcount(mask);
+    }
+#endif
+    unsigned count = 0;
+    for (size_type i = 0; i < lanes; ++i) count += node[i] < x;
+    return count;
+  }
+
+  lane_type *nodes_;
+  size_type blocks_;
+  size_type size_;
+  bool has_max_;
+};
+
+}  // namespace s21
+
+#endif
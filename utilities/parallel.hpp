@@ -0,0 +1,302 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+namespace s21 {
+namespace parallel {
+
+// Where an algorithm runs and how finely it splits the range: a task never
+// takes more than grain elements on its own. A null pool means
+// default_pool(), a zero grain one picked from the range size and the
+// pool's concurrency.
+struct policy {
+  thread_pool *pool = nullptr;
+  std::size_t grain = 0;
+};
+
+namespace detail {
+
+// Smallest automatic grain, below it spawning a task costs more than the
+// elements it takes off the caller
+constexpr std::size_t min_grain = std::size_t(1) << 14;
+
+inline thread_pool &pool_of(const policy &p) {
+  return p.pool ? *p.pool : default_pool();
+}
+
+inline std::size_t grain_of(const policy &p, std::size_t n) {
+  if (p.grain) return p.grain;
+  std::size_t threads = pool_of(p).concurrency();
+  // with nobody to hand pieces to, splitting only adds passes
+  if (threads == 1) return n ? n : 1;
+  std::size_t even = n / (threads * 8);
+  return even < min_grain ? min_grain : even;
+}
+
+// Calls fn(lo, hi) over pieces of [lo, hi) no longer than grain, handing
+// the upper halves to the pool and keeping the lowest piece
+template <typename Fn>
+void split(thread_pool &pool, std::size_t lo, std::size_t hi,
+           std::size_t grain, const Fn &fn) {
+  if (hi - lo <= grain) return fn(lo, hi);
+  task_group group(pool);
+  while (hi - lo > grain) {
+    std::size_t mid = lo + (hi - lo) / 2;
+    group.run(
+        [&pool, &fn, mid, hi, grain] { split(pool, mid, hi, grain, fn); });
+    hi = mid;
+  }
+  fn(lo, hi);
+  group.wait();
+}
+
+// Runs fn(chunk, lo, hi) for every grain-sized chunk of [0, n)
+template <typename Fn>
+void for_chunks(thread_pool &pool, std::size_t n, std::size_t grain,
+                std::size_t chunks, const Fn &fn) {
+  split(pool, 0, chunks, 1, [&](std::size_t lo, std::size_t hi) {
+    for (std::size_t c = lo; c < hi; ++c)
+      fn(c, c * grain, std::min(n, (c + 1) * grain));
+  });
+}
+
+// Moves the merge of the sorted runs [a, a_end) and [b, b_end) to out. The
+// longer run is cut in the middle and the other one at the matching bound,
+// so both halves merge independently and ties still come from a first.
+template <typename Src, typename Dst, typename Compare>
+void merge(thread_pool &pool, Src a, Src a_end, Src b, Src b_end, Dst out,
+           const Compare &comp, std::size_t grain) {
+  task_group group(pool);
+  while (std::size_t(a_end - a) + std::size_t(b_end - b) > grain) {
+    Src a_mid = a, b_mid = b;
+    if (a_end - a >= b_end - b) {
+      a_mid = a + (a_end - a) / 2;
+      b_mid = std::lower_bound(b, b_end, *a_mid, comp);
+    } else {
+      b_mid = b + (b_end - b) / 2;
+      a_mid = std::upper_bound(a, a_end, *b_mid, comp);
+    }
+    // with one element on each side the cut can leave the lower half empty,
+    // and the upper half would be this same merge again
+    if (a_mid == a && b_mid == b) break;
+    Dst out_mid = out + (a_mid - a) + (b_mid - b);
+    group.run([&pool, &comp, a_mid, a_end, b_mid, b_end, out_mid, grain] {
+      merge(pool, a_mid, a_end, b_mid, b_end, out_mid, comp, grain);
+    });
+    a_end = a_mid;
+    b_end = b_mid;
+  }
+  std::merge(std::make_move_iterator(a), std::make_move_iterator(a_end),
+             std::make_move_iterator(b), std::make_move_iterator(b_end), out,
+             comp);
+  group.wait();
+}
+
+// Sorts n elements from first, leaving them there or, with to_buffer, in
+// buf. The halves sort in parallel into the other array and merge back, so
+// the data moves once per level.
+template <bool Stable, typename It, typename T, typename Compare>
+void merge_sort(thread_pool &pool, It first, T *buf, std::size_t n,
+                bool to_buffer, const Compare &comp, std::size_t grain) {
+  if (n <= grain) {
+    if constexpr (Stable)
+      std::stable_sort(first, first + n, comp);
+    else
+      std::sort(first, first + n, comp);
+    if (to_buffer) std::move(first, first + n, buf);
+    return;
+  }
+  std::size_t half = n / 2;
+  {
+    task_group group(pool);
+    group.run([&pool, &comp, first, buf, half, n, to_buffer, grain] {
+      merge_sort<Stable>(pool, first + half, buf + half, n - half,
+                         !to_buffer, comp, grain);
+    });
+    merge_sort<Stable>(pool, first, buf, half, !to_buffer, comp, grain);
+    group.wait();
+  }
+  if (to_buffer)
+    merge(pool, first, first + half, first + half, first + n, buf, comp,
+          grain);
+  else
+    merge(pool, buf, buf + half, buf + half, buf + n, first, comp, grain);
+}
+
+template <bool Stable, typename It, typename Compare>
+void sort(const policy &p, It first, It last, const Compare &comp) {
+  using value_type = typename std::iterator_traits<It>::value_type;
+  std::size_t n = last - first, grain = grain_of(p, n);
+  // merging assigns into the buffer, so it holds live values
+  std::vector<value_type> buf;
+  if (n > grain) {
+    if constexpr (std::is_default_constructible_v<value_type>)
+      buf.resize(n);
+    else
+      buf.assign(first, last);
+  }
+  merge_sort<Stable>(pool_of(p), first, buf.data(), n, false, comp, grain);
+}
+
+}  // namespace detail
+
+// Calls fn on every element of [first, last)
+template <typename It, typename Fn>
+void for_each(const policy &p, It first, It last, Fn fn) {
+  detail::split(detail::pool_of(p), 0, last - first,
+                detail::grain_of(p, last - first),
+                [&](std::size_t lo, std::size_t hi) {
+                  std::for_each(first + lo, first + hi, fn);
+                });
+}
+
+template <typename It, typename Fn>
+void for_each(It first, It last, Fn fn) {
+  for_each(policy{}, first, last, fn);
+}
+
+// Writes op(x) for every x of [first, last) to the range at out, which may
+// be first itself
+template <typename It, typename Out, typename Op>
+Out transform(const policy &p, It first, It last, Out out, Op op) {
+  std::size_t n = last - first;
+  detail::split(detail::pool_of(p), 0, n, detail::grain_of(p, n),
+                [&](std::size_t lo, std::size_t hi) {
+                  std::transform(first + lo, first + hi, out + lo, op);
+                });
+  return out + n;
+}
+
+template <typename It, typename Out, typename Op>
+Out transform(It first, It last, Out out, Op op) {
+  return transform(policy{}, first, last, out, op);
+}
+
+// Folds [first, last) into init with op. Chunks fold in parallel and their
+// results fold left to right, so op must be associative but need not
+// commute.
+template <typename It, typename T, typename Op = std::plus<>>
+T reduce(const policy &p, It first, It last, T init, Op op = Op()) {
+  std::size_t n = last - first, grain = detail::grain_of(p, n);
+  if (n <= grain) return std::accumulate(first, last, init, op);
+  std::size_t chunks = (n + grain - 1) / grain;
+  std::vector<T> partial(chunks, init);
+  detail::for_chunks(detail::pool_of(p), n, grain, chunks,
+                     [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                       partial[c] = std::accumulate(first + lo + 1, first + hi,
+                                                    T(first[lo]), op);
+                     });
+  for (auto &value : partial) init = op(std::move(init), value);
+  return init;
+}
+
+template <typename It, typename T, typename Op = std::plus<>>
+T reduce(It first, It last, T init, Op op = Op()) {
+  return reduce(policy{}, first, last, init, op);
+}
+
+// Writes the running totals of [first, last) to the range at out, which may
+// be first itself. The chunk totals are added up first, then every chunk
+// scans on its own starting from the total of the chunks before it.
+template <typename It, typename Out, typename Op = std::plus<>>
+Out inclusive_scan(const policy &p, It first, It last, Out out,
+                   Op op = Op()) {
+  using value_type = typename std::iterator_traits<It>::value_type;
+  std::size_t n = last - first, grain = detail::grain_of(p, n);
+  if (n <= grain) return std::partial_sum(first, last, out, op);
+  std::size_t chunks = (n + grain - 1) / grain;
+  thread_pool &pool = detail::pool_of(p);
+  std::vector<value_type> carry(chunks, first[0]);
+  detail::for_chunks(pool, n, grain, chunks - 1,
+                     [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                       carry[c + 1] = std::accumulate(
+                           first + lo + 1, first + hi, value_type(first[lo]),
+                           op);
+                     });
+  for (std::size_t c = 2; c < chunks; ++c)
+    carry[c] = op(carry[c - 1], carry[c]);
+  detail::for_chunks(pool, n, grain, chunks,
+                     [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                       value_type acc = c ? op(carry[c], first[lo])
+                                          : value_type(first[lo]);
+                       out[lo] = acc;
+                       for (std::size_t i = lo + 1; i < hi; ++i)
+                         out[i] = acc = op(acc, first[i]);
+                     });
+  return out + n;
+}
+
+template <typename It, typename Out, typename Op = std::plus<>>
+Out inclusive_scan(It first, It last, Out out, Op op = Op()) {
+  return inclusive_scan(policy{}, first, last, out, op);
+}
+
+// Copies the elements of [first, last) that satisfy pred to out, in order,
+// and returns the end of the copies. out is random access and must not
+// overlap the input: every chunk counts its matches, the counts give each
+// chunk its offset, and the chunks copy in parallel, so pred runs twice per
+// element.
+template <typename It, typename Out, typename Pred>
+Out copy_if(const policy &p, It first, It last, Out out, Pred pred) {
+  std::size_t n = last - first, grain = detail::grain_of(p, n);
+  if (n <= grain) return std::copy_if(first, last, out, pred);
+  std::size_t chunks = (n + grain - 1) / grain;
+  thread_pool &pool = detail::pool_of(p);
+  std::vector<std::size_t> offset(chunks + 1, 0);
+  detail::for_chunks(pool, n, grain, chunks,
+                     [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                       offset[c + 1] = std::count_if(first + lo, first + hi,
+                                                     pred);
+                     });
+  std::partial_sum(offset.begin(), offset.end(), offset.begin());
+  detail::for_chunks(pool, n, grain, chunks,
+                     [&](std::size_t c, std::size_t lo, std::size_t hi) {
+                       std::copy_if(first + lo, first + hi, out + offset[c],
+                                    pred);
+                     });
+  return out + offset[chunks];
+}
+
+template <typename It, typename Out, typename Pred>
+Out copy_if(It first, It last, Out out, Pred pred) {
+  return copy_if(policy{}, first, last, out, pred);
+}
+
+// Parallel merge sort: grain-sized pieces sort with std::sort and merge
+// pairwise, every merge split again across the pool
+template <typename It, typename Compare = std::less<>>
+void sort(const policy &p, It first, It last, Compare comp = Compare()) {
+  detail::sort<false>(p, first, last, comp);
+}
+
+template <typename It, typename Compare = std::less<>>
+void sort(It first, It last, Compare comp = Compare()) {
+  detail::sort<false>(policy{}, first, last, comp);
+}
+
+// As sort, with std::stable_sort on the pieces; the merges keep ties in
+// order already
+template <typename It, typename Compare = std::less<>>
+void stable_sort(const policy &p, It first, It last,
+                 Compare comp = Compare()) {
+  detail::sort<true>(p, first, last, comp);
+}
+
+template <typename It, typename Compare = std::less<>>
+void stable_sort(It first, It last, Compare comp = Compare()) {
+  detail::sort<true>(policy{}, first, last, comp);
+}
+
+}  // namespace parallel
+}  // namespace s21
+
+#endif
@@ -2,11 +2,30 @@
 #define RB_TREE_H
 
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "arena.hpp"
+#include "rb_tree_augment.hpp"
+#include "rb_tree_balance.hpp"
+#include "rb_tree_batch.hpp"
+#include "rb_tree_bloom.hpp"
+#include "rb_tree_prefix.hpp"
+#include "rb_tree_stats.hpp"
+#include "rb_tree_traits.hpp"
 
 template <typename key_type, typename mapped_type = key_type,
-          typename Allocator = std::allocator<key_type>>
-class RedBlackTree {
+          typename Allocator = std::allocator<key_type>,
+          typename Traits = s21::tree_traits>
+class RedBlackTree
+    : private s21::tree_stats_collector<Traits::collect_stats>,
+      private s21::tree_bloom_filter<key_type, Traits::bloom_bits_per_key,
+                                     Traits::count_bloom_lookups> {
  private:
   struct Node;
   Node *root;
@@ -15,16 +34,60 @@ class RedBlackTree {
 
   using node_allocator =
       typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+  using augment_type = typename Traits::augment;
+  static constexpr bool augmented = !std::is_void<augment_type>::value;
+  static constexpr bool prefixed = Traits::cache_key_prefix;
+  static constexpr bool bloomed = Traits::bloom_bits_per_key != 0;
+  using balance_type = typename Traits::balance;
+  using rank_type = typename balance_type::rank_type;
+  friend balance_type;
 
   node_allocator node_alloc;
 
-  Node *searchTreeHelper(Node *node, key_type key);
+  Node *searchTreeHelper(Node *node, const key_type &key) const;
   Node *minimum(Node *node) const;
   Node *maximum(Node *node) const;
-  void deleteFix(Node *x);
   void rbTransplant(Node *u, Node *v);
+  std::pair<Node *, rank_type> detach(Node *z);
   void deleteNodeHelper(Node *node, key_type key);
-  void insertFix(Node *k);
+  void pull(Node *node);
+  void pullPath(Node *node);
+  template <typename Skip, typename Past, typename Visit>
+  bool searchSubtree(Node *node, Skip &skip, Past &past, Visit &visit);
+  template <typename Visit>
+  void walkInOrder(const key_type *lo, const key_type *hi,
+                   Visit visit) const;
+  template <typename Fn, typename... Args>
+  static bool proceed(Fn &fn, Args &...args);
+  unsigned height(const Node *node) const;
+  template <typename... Args>
+  Node *createNode(Args &&...args);
+  Node *createSentinel();
+  void destroyNode(Node *node);
+  void destroySubtree(Node *node);
+  void releaseAll();
+  void cloneSubtree(const Node *node, const Node *nil, Node *parent,
+                    Node *&slot);
+  void copyFrom(const RedBlackTree &other);
+  Node *findSlot(const key_type &key, bool unique, Node *&parent,
+                 bool &to_left);
+  bool hintSlot(const Node *hint, const key_type &key, bool unique,
+                Node *&parent, bool &to_left) const;
+  void linkNode(Node *node, Node *parent, bool to_left);
+  void removeNode(Node *z);
+  void rebuildBloom() noexcept;
+  Node *predecessor(Node *node) const;
+  Node *successor(Node *node) const;
+  Node *buildBalanced(Node **nodes, std::size_t count, Node *parent,
+                      unsigned depth, unsigned partial_level);
+  void relinkBalanced(std::vector<Node *> &nodes);
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt fingerBatch(ForwardIt first, ForwardIt last, OutputIt out,
+                       bool unique);
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt mergeBatch(ForwardIt first, ForwardIt last, OutputIt out,
+                      bool unique);
 
  public:
   class RedBlackTreeIterator;
@@ -32,33 +95,139 @@ class RedBlackTree {
 
   using iterator = RedBlackTreeIterator;
   using const_iterator = RedBlackTreeConstIterator;
+  using allocator_type = Allocator;
 
-  RedBlackTree();
+  RedBlackTree() : RedBlackTree(Allocator()) {}
+  explicit RedBlackTree(const Allocator &alloc);
   RedBlackTree(const RedBlackTree &rb);
-  RedBlackTree(RedBlackTree &&rb);
+  RedBlackTree(const RedBlackTree &rb, const Allocator &alloc);
+  RedBlackTree(RedBlackTree &&rb) noexcept;
+  RedBlackTree(RedBlackTree &&rb, const Allocator &alloc);
 
-  ~RedBlackTree<key_type, mapped_type, Allocator>();
-  iterator searchTree(key_type k);
+  ~RedBlackTree<key_type, mapped_type, Allocator, Traits>();
+  iterator searchTree(const key_type &k);
+  const_iterator searchTree(const key_type &k) const;
   iterator getNullNode();
+  const_iterator getNullNode() const;
+  template <typename ForwardIt, typename Visitor>
+  void searchMany(ForwardIt first, ForwardIt last, Visitor visit) const;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt applyBatch(ForwardIt first, ForwardIt last, OutputIt out,
+                      bool unique);
   void leftRotate(Node *x);
   void rightRotate(Node *x);
-  void insert(const key_type key, const mapped_type value = {});
-  void clear() {
-    deleteNode(root->key);
+  void insert(const key_type &key, const mapped_type &value = {}) {
+    emplace(key, value);
+  }
+  // The node's key is built from the first argument and its value from the
+  // rest, or from two tuples after std::piecewise_construct. emplace puts
+  // equal keys after the ones already there, emplaceUnique frees the node
+  // again when its key is taken and tryEmplace builds it only when not.
+  template <typename... Args>
+  iterator emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> emplaceUnique(Args &&...args);
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> tryEmplace(K &&key, Args &&...args);
+  // Links the node right before hint (end() is TNULL) without a walk from
+  // the root when its key belongs there
+  template <typename... Args>
+  std::pair<iterator, bool> emplaceHint(const Node *hint, bool unique,
+                                        Args &&...args);
+  void clear() noexcept {
+    if (root == nullptr) return;
+    // arena nodes are reclaimed in bulk, nothing to visit them for
+    if constexpr (!s21::is_arena_allocator<node_allocator>::value ||
+                  !std::is_trivially_destructible<Node>::value)
+      destroySubtree(root);
+    root = TNULL;
     _size = 0;
-  }  // XD
+    this->bloom_clear();
+  }
   void deleteNode(key_type key) { deleteNodeHelper(this->root, key); }
+  template <typename Pred>
+  bool eraseMatching(const key_type &key, Pred pred);
+  template <typename Skip, typename Past, typename Visit>
+  void searchAugmented(Skip skip, Past past, Visit visit);
+  bool assign(const key_type &key, const mapped_type &value);
+
+  // In-order visits without iterators: fn(key, value) may return false to
+  // stop early, the range forms cover keys in [lo, hi). The key is always
+  // const, a changed key would break the order.
+  template <typename Fn>
+  void forEach(Fn fn) {
+    walkInOrder(nullptr, nullptr, [&](Node *node) {
+      return proceed(fn, std::as_const(node->key), node->value);
+    });
+  }
+  template <typename Fn>
+  void forEach(Fn fn) const {
+    walkInOrder(nullptr, nullptr, [&](const Node *node) {
+      return proceed(fn, node->key, node->value);
+    });
+  }
+  template <typename Fn>
+  void forEachInRange(const key_type &lo, const key_type &hi, Fn fn) {
+    walkInOrder(&lo, &hi, [&](Node *node) {
+      return proceed(fn, std::as_const(node->key), node->value);
+    });
+  }
+  template <typename Fn>
+  void forEachInRange(const key_type &lo, const key_type &hi, Fn fn) const {
+    walkInOrder(&lo, &hi, [&](const Node *node) {
+      return proceed(fn, node->key, node->value);
+    });
+  }
+  auto aggregate(const key_type &lo, const key_type &hi) const;
 
-  iterator begin() { return iterator(minimum(root)); }
-  const_iterator begin() const { return const_iterator(minimum(root)); }
-  iterator end() { return ++iterator(maximum(root)); }
-  const_iterator end() const { return ++const_iterator(maximum(root)); }
+  iterator begin() {
+    return root == TNULL ? iterator(TNULL) : iterator(minimum(root));
+  }
+  const_iterator begin() const {
+    return root == TNULL ? const_iterator(TNULL)
+                         : const_iterator(minimum(root));
+  }
+  iterator end() {
+    return root == TNULL ? iterator(TNULL) : ++iterator(maximum(root));
+  }
+  const_iterator end() const {
+    return root == TNULL ? const_iterator(TNULL)
+                         : ++const_iterator(maximum(root));
+  }
   unsigned size() const noexcept { return _size; }
-  unsigned max_size() const noexcept { return node_alloc.max_size(); }
+  unsigned max_size() const noexcept {
+    return node_traits::max_size(node_alloc);
+  }
   bool empty() const noexcept { return _size == 0; }
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(node_alloc);
+  }
+
+  // Only available when Traits::collect_stats is set. The counters are safe
+  // to read next to concurrent const lookups; the height is measured by a
+  // walk over every node, so each call costs O(n).
+  s21::tree_stats stats() const {
+    static_assert(Traits::collect_stats,
+                  "stats() requires traits with collect_stats = true");
+    s21::tree_stats current = this->counters();
+    current.height = height(root);
+    return current;
+  }
+  void reset_stats() noexcept { this->reset_counters(); }
+
+  // Only available when Traits::bloom_bits_per_key is not 0
+  s21::bloom_filter_stats bloom_stats() const {
+    static_assert(bloomed,
+                  "bloom_stats() requires traits with bloom_bits_per_key");
+    return this->bloom_counters();
+  }
+  void reset_bloom_stats() noexcept { this->reset_bloom_counters(); }
 
   RedBlackTree &operator=(const RedBlackTree &other);
-  RedBlackTree &operator=(RedBlackTree &&other) noexcept;
+  RedBlackTree &operator=(RedBlackTree &&other) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value);
+  void swap(RedBlackTree &other) noexcept;
 
   friend bool operator==(const RedBlackTree &lhs,
                          const RedBlackTree &rhs) noexcept {
@@ -77,12 +246,14 @@ class RedBlackTree {
   }
 };
 
-template <typename key_type, typename mapped_type, typename Allocator>
-struct RedBlackTree<key_type, mapped_type, Allocator>::Node {
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+struct RedBlackTree<key_type, mapped_type, Allocator, Traits>::Node
+    : s21::augment_storage<augment_type>, s21::prefix_storage<prefixed> {
   key_type key;
   mapped_type value;
   Node *parent, *left, *right;
-  int color;
+  rank_type rank;
 
   Node()
       : key(),
@@ -90,129 +261,139 @@ struct RedBlackTree<key_type, mapped_type, Allocator>::Node {
         parent(nullptr),
         left(nullptr),
         right(nullptr),
-        color() {}
+        rank() {}
+
+  template <typename K, typename... Args>
+  explicit Node(K &&k, Args &&...v)
+      : key(std::forward<K>(k)),
+        value(std::forward<Args>(v)...),
+        parent(nullptr),
+        left(nullptr),
+        right(nullptr),
+        rank() {
+    if constexpr (prefixed) this->prefix = s21::key_prefix<key_type>::of(key);
+  }
+
+  template <typename... KeyArgs, typename... ValueArgs>
+  Node(std::piecewise_construct_t, std::tuple<KeyArgs...> k,
+       std::tuple<ValueArgs...> v)
+      : key(std::make_from_tuple<key_type>(std::move(k))),
+        value(std::make_from_tuple<mapped_type>(std::move(v))),
+        parent(nullptr),
+        left(nullptr),
+        right(nullptr),
+        rank() {
+    if constexpr (prefixed) this->prefix = s21::key_prefix<key_type>::of(key);
+  }
 };
 
-template <typename key_type, typename mapped_type, typename Allocator>
-RedBlackTree<key_type, mapped_type, Allocator>::RedBlackTree() {
-  TNULL = node_alloc.allocate(1);
-  node_alloc.construct(TNULL);
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::RedBlackTree(
+    const Allocator &alloc)
+    : node_alloc(alloc) {
+  TNULL = createSentinel();
   root = TNULL;
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-RedBlackTree<key_type, mapped_type, Allocator>::RedBlackTree(
-    const RedBlackTree &rb) {
-  TNULL = node_alloc.allocate(1);
-  node_alloc.construct(TNULL);
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::RedBlackTree(
+    const RedBlackTree &rb)
+    : RedBlackTree(rb, node_traits::select_on_container_copy_construction(
+                           rb.node_alloc)) {}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::RedBlackTree(
+    const RedBlackTree &rb, const Allocator &alloc)
+    : node_alloc(alloc) {
+  TNULL = createSentinel();
   root = TNULL;
-  RedBlackTreeConstIterator b(rb.begin()), e(rb.end());
-  while (b != e) {
-    insert((*b)->key, (*b)->value);
-    ++b;
+  try {
+    copyFrom(rb);
+  } catch (...) {
+    releaseAll();
+    throw;
   }
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-RedBlackTree<key_type, mapped_type, Allocator>::RedBlackTree(
-    RedBlackTree &&rb) {
-  root = rb.root;
-  TNULL = rb.TNULL;
-  _size = rb._size;
-  node_alloc = rb.node_alloc;
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::RedBlackTree(
+    RedBlackTree &&rb) noexcept
+    : root(rb.root),
+      TNULL(rb.TNULL),
+      _size(rb._size),
+      node_alloc(std::move(rb.node_alloc)) {
   rb.root = nullptr;
   rb.TNULL = nullptr;
   rb._size = 0;
+  this->bloom_swap(rb);
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-RedBlackTree<key_type, mapped_type, Allocator>::~RedBlackTree() {
-  while (root != TNULL) deleteNode(root->key);
-  if (TNULL != nullptr) {
-    node_alloc.destroy(TNULL);
-    node_alloc.deallocate(TNULL, 1);
-  }
-}
-
-template <typename key_type, typename mapped_type, typename Allocator>
-typename RedBlackTree<key_type, mapped_type, Allocator>::Node *
-RedBlackTree<key_type, mapped_type, Allocator>::searchTreeHelper(Node *node,
-                                                                 key_type key) {
-  if (node == TNULL || key == node->key) {
-    return node;
+// Nodes change hands only when the allocators are interchangeable
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::RedBlackTree(
+    RedBlackTree &&rb, const Allocator &alloc)
+    : node_alloc(alloc) {
+  if (node_alloc == rb.node_alloc) {
+    root = rb.root;
+    TNULL = rb.TNULL;
+    _size = rb._size;
+    rb.root = nullptr;
+    rb.TNULL = nullptr;
+    rb._size = 0;
+    this->bloom_swap(rb);
+    return;
   }
-
-  if (key < node->key) {
-    return searchTreeHelper(node->left, key);
+  TNULL = createSentinel();
+  root = TNULL;
+  try {
+    copyFrom(rb);
+  } catch (...) {
+    releaseAll();
+    throw;
   }
-  return searchTreeHelper(node->right, key);
 }
 
-// For balancing the tree after deletion
-template <typename key_type, typename mapped_type, typename Allocator>
-void RedBlackTree<key_type, mapped_type, Allocator>::deleteFix(Node *x) {
-  Node *s;
-  while (x != root && x->color == 0) {
-    if (x == x->parent->left) {
-      s = x->parent->right;
-      if (s->color == 1) {
-        s->color = 0;
-        x->parent->color = 1;
-        leftRotate(x->parent);
-        s = x->parent->right;
-      }
-
-      if (s->left->color == 0 && s->right->color == 0) {
-        s->color = 1;
-        x = x->parent;
-      } else {
-        if (s->right->color == 0) {
-          s->left->color = 0;
-          s->color = 1;
-          rightRotate(s);
-          s = x->parent->right;
-        }
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::~RedBlackTree() {
+  releaseAll();
+}
 
-        s->color = x->parent->color;
-        x->parent->color = 0;
-        s->right->color = 0;
-        leftRotate(x->parent);
-        x = root;
-      }
-    } else {
-      s = x->parent->left;
-      if (s->color == 1) {
-        s->color = 0;
-        x->parent->color = 1;
-        rightRotate(x->parent);
-        s = x->parent->left;
-      }
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::Node *
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::searchTreeHelper(
+    Node *node, const key_type &key) const {
+  [[maybe_unused]] std::uint64_t prefix = 0;
+  if constexpr (prefixed) prefix = s21::key_prefix<key_type>::of(key);
 
-      if (s->right->color == 0 && s->right->color == 0) {
-        s->color = 1;
-        x = x->parent;
-      } else {
-        if (s->left->color == 0) {
-          s->right->color = 0;
-          s->color = 1;
-          leftRotate(s);
-          s = x->parent->left;
-        }
-
-        s->color = x->parent->color;
-        x->parent->color = 0;
-        s->left->color = 0;
-        rightRotate(x->parent);
-        x = root;
+  while (node != TNULL) {
+    if constexpr (prefixed) {
+      // unequal prefixes decide without touching the node's key
+      if (prefix != node->prefix) {
+        this->count_comparison();
+        node = prefix < node->prefix ? node->left : node->right;
+        continue;
       }
     }
+    this->count_comparison();
+    if (key == node->key) return node;
+
+    this->count_comparison();
+    node = key < node->key ? node->left : node->right;
   }
-  x->color = 0;
+  return node;
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-void RedBlackTree<key_type, mapped_type, Allocator>::rbTransplant(Node *u,
-                                                                  Node *v) {
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::rbTransplant(
+    Node *u, Node *v) {
   if (u->parent == nullptr) {
     root = v;
   } else if (u == u->parent->left) {
@@ -223,16 +404,18 @@ void RedBlackTree<key_type, mapped_type, Allocator>::rbTransplant(Node *u,
   v->parent = u->parent;
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-void RedBlackTree<key_type, mapped_type, Allocator>::deleteNodeHelper(
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::deleteNodeHelper(
     Node *node, key_type key) {
   Node *z = TNULL;
-  Node *x, *y;
   while (node != TNULL) {
+    this->count_comparison();
     if (node->key == key) {
       z = node;
     }
 
+    this->count_comparison();
     if (node->key <= key) {
       node = node->right;
     } else {
@@ -244,8 +427,48 @@ void RedBlackTree<key_type, mapped_type, Allocator>::deleteNodeHelper(
     return;
   }
 
+  removeNode(z);
+}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::removeNode(
+    Node *z) {
+  balance_type::erase(*this, z);
+  _size--;
+  destroyNode(z);
+  if (this->bloom_erase()) rebuildBloom();
+}
+
+// Refills the Bloom filter from the nodes, sized for the current size
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::rebuildBloom()
+    noexcept {
+  if constexpr (bloomed) {
+    this->bloom_rebuild(node_alloc, _size, [this](auto add) {
+      walkInOrder(nullptr, nullptr, [&add](Node *node) {
+        add(node->key);
+        return true;
+      });
+    });
+  }
+}
+
+// Unlinks z the textbook way: a node with two children trades places with
+// its successor, which takes over z's rank. Returns the node that moved into
+// the vacated link (possibly nil, with its parent set) and the rank of the
+// node that left that link.
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+std::pair<typename RedBlackTree<key_type, mapped_type, Allocator,
+                                Traits>::Node *,
+          typename RedBlackTree<key_type, mapped_type, Allocator,
+                                Traits>::rank_type>
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::detach(Node *z) {
+  Node *x, *y;
   y = z;
-  int y_original_color = y->color;
+  rank_type y_original_rank = y->rank;
   if (z->left == TNULL) {
     x = z->right;
     rbTransplant(z, z->right);
@@ -254,7 +477,7 @@ void RedBlackTree<key_type, mapped_type, Allocator>::deleteNodeHelper(
     rbTransplant(z, z->left);
   } else {
     y = minimum(z->right);
-    y_original_color = y->color;
+    y_original_rank = y->rank;
     x = y->right;
     if (y->parent == z) {
       x->parent = y;
@@ -267,93 +490,325 @@ void RedBlackTree<key_type, mapped_type, Allocator>::deleteNodeHelper(
     rbTransplant(z, y);
     y->left = z->left;
     y->left->parent = y;
-    y->color = z->color;
+    y->rank = z->rank;
   }
-  _size--;
-  node_alloc.deallocate(z, 1);
-  if (y_original_color == 0) {
-    deleteFix(x);
-  }
-}
-
-// For balancing the tree after insertion
-template <typename key_type, typename mapped_type, typename Allocator>
-void RedBlackTree<key_type, mapped_type, Allocator>::insertFix(Node *k) {
-  Node *u;
-  while (k->parent->color == 1) {
-    if (k->parent == k->parent->parent->right) {
-      u = k->parent->parent->left;
-      if (u->color == 1) {
-        u->color = 0;
-        k->parent->color = 0;
-        k->parent->parent->color = 1;
-        k = k->parent->parent;
-      } else {
-        if (k == k->parent->left) {
-          k = k->parent;
-          rightRotate(k);
-        }
-        k->parent->color = 0;
-        k->parent->parent->color = 1;
-        leftRotate(k->parent->parent);
-      }
+  pullPath(x->parent);
+  return {x, y_original_rank};
+}
+
+// Refolds the augmentation of one node from its children
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::pull(Node *node) {
+  if constexpr (augmented) {
+    node->aug = augment_type::combine(
+        augment_type::combine(node->left->aug,
+                              augment_type::measure(node->key, node->value)),
+        node->right->aug);
+  }
+}
+
+// Refolds every node from node up to the root
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::pullPath(
+    Node *node) {
+  if constexpr (augmented) {
+    for (; node != nullptr; node = node->parent) pull(node);
+  }
+}
+
+// Iterative in-order walk over a stack of pending ancestors. Every balancing
+// policy keeps a tree of 2^32 nodes within 64 levels, so the stack is a fixed
+// array. Left subtrees entirely below lo are never entered.
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename Visit>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::walkInOrder(
+    const key_type *lo, const key_type *hi, Visit visit) const {
+  if (root == nullptr) return;
+  Node *stack[64];
+  int top = 0;
+
+  for (Node *node = root; node != TNULL;) {
+    this->count_comparison();
+    if (lo && node->key < *lo) {
+      node = node->right;
     } else {
-      u = k->parent->parent->right;
+      stack[top++] = node;
+      node = node->left;
+    }
+  }
 
-      if (u->color == 1) {
-        u->color = 0;
-        k->parent->color = 0;
-        k->parent->parent->color = 1;
-        k = k->parent->parent;
-      } else {
-        if (k == k->parent->right) {
-          k = k->parent;
-          leftRotate(k);
-        }
-        k->parent->color = 0;
-        k->parent->parent->color = 1;
-        rightRotate(k->parent->parent);
-      }
+  while (top) {
+    Node *node = stack[--top];
+    if (hi) {
+      this->count_comparison();
+      if (!(node->key < *hi)) return;
     }
-    if (k == root) {
+    if (!visit(node)) return;
+    for (node = node->right; node != TNULL; node = node->left)
+      stack[top++] = node;
+  }
+}
+
+// Calls fn and tells whether the walk goes on, void callbacks never stop it
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename Fn, typename... Args>
+bool RedBlackTree<key_type, mapped_type, Allocator, Traits>::proceed(
+    Fn &fn, Args &...args) {
+  if constexpr (std::is_void<decltype(fn(args...))>::value) {
+    fn(args...);
+    return true;
+  } else {
+    return static_cast<bool>(fn(args...));
+  }
+}
+
+// Overwrites the value stored under key and refolds the path above it
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+bool RedBlackTree<key_type, mapped_type, Allocator, Traits>::assign(
+    const key_type &key, const mapped_type &value) {
+  if (root == nullptr) return false;
+  Node *node = searchTreeHelper(root, key);
+  if (node == TNULL) return false;
+  node->value = value;
+  pullPath(node);
+  return true;
+}
+
+// Fold of the elements with keys in [lo, hi): descends to the node where the
+// bounds part ways, then takes whole subtrees along the two boundary paths
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+auto RedBlackTree<key_type, mapped_type, Allocator, Traits>::aggregate(
+    const key_type &lo, const key_type &hi) const {
+  static_assert(augmented,
+                "aggregate() requires traits with an augment policy");
+  using fold_type = typename augment_type::value_type;
+  auto measure = [](const Node *node) {
+    return augment_type::measure(node->key, node->value);
+  };
+
+  Node *split = root;
+  while (split != nullptr && split != TNULL) {
+    this->count_comparison();
+    if (split->key < lo) {
+      split = split->right;
+    } else if (!(split->key < hi)) {
+      split = split->left;
+    } else {
       break;
     }
   }
-  root->color = 0;
+  if (split == nullptr || split == TNULL) return augment_type::identity();
+
+  fold_type left = augment_type::identity();
+  for (Node *node = split->left; node != TNULL;) {
+    this->count_comparison();
+    if (node->key < lo) {
+      node = node->right;
+    } else {
+      left = augment_type::combine(
+          augment_type::combine(measure(node), node->right->aug), left);
+      node = node->left;
+    }
+  }
+
+  fold_type right = augment_type::identity();
+  for (Node *node = split->right; node != TNULL;) {
+    this->count_comparison();
+    if (node->key < hi) {
+      right = augment_type::combine(
+          right, augment_type::combine(node->left->aug, measure(node)));
+      node = node->right;
+    } else {
+      node = node->left;
+    }
+  }
+
+  return augment_type::combine(augment_type::combine(left, measure(split)),
+                               right);
+}
+
+// Removes the first node in key order with this key whose value satisfies
+// pred, equal keys sit in one in-order run starting at the leftmost match
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename Pred>
+bool RedBlackTree<key_type, mapped_type, Allocator, Traits>::eraseMatching(
+    const key_type &key, Pred pred) {
+  Node *node = root, *first = nullptr;
+  while (node != nullptr && node != TNULL) {
+    this->count_comparison();
+    if (node->key < key) {
+      node = node->right;
+    } else {
+      if (!(key < node->key)) first = node;
+      node = node->left;
+    }
+  }
+  for (; first != nullptr && !(key < first->key); first = successor(first)) {
+    if (pred(first->value)) {
+      removeNode(first);
+      return true;
+    }
+  }
+  return false;
+}
+
+// In-order walk over an augmented tree: subtrees whose fold satisfies
+// skip(aug) are left out, and once past(key) holds for a node neither it
+// nor anything after it is visited. visit(key, value) gets the rest.
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename Skip, typename Past, typename Visit>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::searchAugmented(
+    Skip skip, Past past, Visit visit) {
+  static_assert(augmented, "searchAugmented() requires an augmented tree");
+  if (root != nullptr) searchSubtree(root, skip, past, visit);
+}
+
+// Recurses into left children only, so the depth stays within the height;
+// returns true once the walk went past the query
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename Skip, typename Past, typename Visit>
+bool RedBlackTree<key_type, mapped_type, Allocator, Traits>::searchSubtree(
+    Node *node, Skip &skip, Past &past, Visit &visit) {
+  while (node != TNULL && !skip(node->aug)) {
+    if (searchSubtree(node->left, skip, past, visit)) return true;
+    this->count_comparison();
+    if (past(node->key)) return true;
+    visit(node->key, node->value);
+    node = node->right;
+  }
+  return false;
+}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::iterator
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::searchTree(
+    const key_type &k) {
+  if (!this->bloom_may_contain(k)) return iterator(TNULL);
+  Node *node = searchTreeHelper(this->root, k);
+  if (node == TNULL) this->bloom_missed();
+  return iterator(node);
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-typename RedBlackTree<key_type, mapped_type, Allocator>::iterator
-RedBlackTree<key_type, mapped_type, Allocator>::searchTree(key_type k) {
-  return iterator(searchTreeHelper(this->root, k));
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::const_iterator
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::searchTree(
+    const key_type &k) const {
+  if (!this->bloom_may_contain(k)) return const_iterator(TNULL);
+  Node *node = searchTreeHelper(this->root, k);
+  if (node == TNULL) this->bloom_missed();
+  return const_iterator(node);
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-typename RedBlackTree<key_type, mapped_type, Allocator>::Node *
-RedBlackTree<key_type, mapped_type, Allocator>::minimum(Node *node) const {
+// Runs up to search_group lookups in lockstep, one tree level per round, so
+// the cache misses of independent searches overlap. visit(node, found) is
+// called for every key in input order.
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename ForwardIt, typename Visitor>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::searchMany(
+    ForwardIt first, ForwardIt last, Visitor visit) const {
+  constexpr unsigned search_group = 16;
+  ForwardIt keys[search_group];
+  Node *nodes[search_group];
+  bool found[search_group], passed[search_group];
+
+  while (first != last) {
+    unsigned group = 0;
+    for (; group < search_group && first != last; ++group, ++first) {
+      keys[group] = first;
+      // keys the filter rules out start at nil and are never walked
+      passed[group] = this->bloom_may_contain(*first);
+      nodes[group] = passed[group] ? root : TNULL;
+      found[group] = false;
+    }
+
+    bool active = true;
+    while (active) {
+      active = false;
+      for (unsigned i = 0; i < group; ++i) {
+        Node *node = nodes[i];
+        if (found[i] || node == TNULL) continue;
+        this->count_comparison();
+        if (*keys[i] == node->key) {
+          found[i] = true;
+          continue;
+        }
+        this->count_comparison();
+        node = *keys[i] < node->key ? node->left : node->right;
+        __builtin_prefetch(node);
+        nodes[i] = node;
+        active = true;
+      }
+    }
+
+    for (unsigned i = 0; i < group; ++i) {
+      if (passed[i] && !found[i]) this->bloom_missed();
+      visit(nodes[i], found[i]);
+    }
+  }
+}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::Node *
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::minimum(
+    Node *node) const {
   while (node->left != TNULL) {
     node = node->left;
   }
   return node;
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-typename RedBlackTree<key_type, mapped_type, Allocator>::Node *
-RedBlackTree<key_type, mapped_type, Allocator>::maximum(Node *node) const {
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::Node *
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::maximum(
+    Node *node) const {
   while (node->right != TNULL) {
     node = node->right;
   }
   return node;
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-typename RedBlackTree<key_type, mapped_type, Allocator>::iterator
-RedBlackTree<key_type, mapped_type, Allocator>::getNullNode() {
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+unsigned RedBlackTree<key_type, mapped_type, Allocator, Traits>::height(
+    const Node *node) const {
+  if (node == TNULL || node == nullptr) return 0;
+  unsigned lhs = height(node->left), rhs = height(node->right);
+  return 1 + (lhs > rhs ? lhs : rhs);
+}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::iterator
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::getNullNode() {
   return iterator(TNULL);
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-void RedBlackTree<key_type, mapped_type, Allocator>::leftRotate(Node *x) {
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::const_iterator
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::getNullNode() const {
+  return const_iterator(TNULL);
+}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::leftRotate(
+    Node *x) {
+  this->count_rotation();
   Node *y = x->right;
   x->right = y->left;
   if (y->left != TNULL) {
@@ -369,10 +824,15 @@ void RedBlackTree<key_type, mapped_type, Allocator>::leftRotate(Node *x) {
   }
   y->left = x;
   x->parent = y;
+  pull(x);
+  pull(y);
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-void RedBlackTree<key_type, mapped_type, Allocator>::rightRotate(Node *x) {
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::rightRotate(
+    Node *x) {
+  this->count_rotation();
   Node *y = x->left;
   x->left = y->right;
   if (y->right != TNULL) {
@@ -388,101 +848,574 @@ void RedBlackTree<key_type, mapped_type, Allocator>::rightRotate(Node *x) {
   }
   y->right = x;
   x->parent = y;
+  pull(x);
+  pull(y);
 }
 
-// Inserting a node
-template <typename key_type, typename mapped_type, typename Allocator>
-void RedBlackTree<key_type, mapped_type, Allocator>::insert(
-    const key_type key, const mapped_type value) {
-  Node *node = node_alloc.allocate(1);
-  node_alloc.construct(node);
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename... Args>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::iterator
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::emplace(
+    Args &&...args) {
+  Node *node = createNode(std::forward<Args>(args)...);
+  Node *parent;
+  bool to_left;
+  findSlot(node->key, false, parent, to_left);
+  linkNode(node, parent, to_left);
+  return iterator(node);
+}
 
-  _size++;
-  node->parent = nullptr;
-  node->key = key;
-  node->value = value;
-  node->left = TNULL;
-  node->right = TNULL;
-  node->color = 1;
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename... Args>
+std::pair<
+    typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::iterator,
+    bool>
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::emplaceUnique(
+    Args &&...args) {
+  Node *node = createNode(std::forward<Args>(args)...);
+  Node *parent;
+  bool to_left;
+  if (Node *taken = findSlot(node->key, true, parent, to_left)) {
+    destroyNode(node);
+    return {iterator(taken), false};
+  }
+  linkNode(node, parent, to_left);
+  return {iterator(node), true};
+}
 
-  Node *y = nullptr;
-  Node *x = this->root;
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename K, typename... Args>
+std::pair<
+    typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::iterator,
+    bool>
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::tryEmplace(
+    K &&key, Args &&...args) {
+  Node *parent;
+  bool to_left;
+  if (Node *taken = findSlot(key, true, parent, to_left))
+    return {iterator(taken), false};
+  Node *node = createNode(std::forward<K>(key), std::forward<Args>(args)...);
+  linkNode(node, parent, to_left);
+  return {iterator(node), true};
+}
 
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename... Args>
+std::pair<
+    typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::iterator,
+    bool>
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::emplaceHint(
+    const Node *hint, bool unique, Args &&...args) {
+  Node *node = createNode(std::forward<Args>(args)...);
+  Node *parent;
+  bool to_left;
+  if (!hintSlot(hint, node->key, unique, parent, to_left)) {
+    if (Node *taken = findSlot(node->key, unique, parent, to_left)) {
+      destroyNode(node);
+      return {iterator(taken), false};
+    }
+  }
+  linkNode(node, parent, to_left);
+  return {iterator(node), true};
+}
+
+// Walks down to the free slot for key, equal keys go right. With unique set
+// returns the node that already holds key, if any, instead of nullptr.
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::Node *
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::findSlot(
+    const key_type &key, bool unique, Node *&parent, bool &to_left) {
+  [[maybe_unused]] std::uint64_t prefix = 0;
+  if constexpr (prefixed) prefix = s21::key_prefix<key_type>::of(key);
+
+  // the last node key didn't go left of is the largest one not above key
+  Node *x = root, *floor = nullptr;
+  unsigned depth = 1;
+  parent = nullptr;
+  to_left = false;
   while (x != TNULL) {
-    y = x;
-    if (node->key < x->key) {
+    parent = x;
+    ++depth;
+    this->count_comparison();
+    if constexpr (prefixed) {
+      to_left = prefix != x->prefix ? prefix < x->prefix : key < x->key;
+    } else {
+      to_left = key < x->key;
+    }
+    if (to_left) {
       x = x->left;
     } else {
+      floor = x;
       x = x->right;
     }
   }
+  this->record_depth(depth);
 
-  node->parent = y;
-  if (y == nullptr) {
-    root = node;
-  } else if (node->key < y->key) {
-    y->left = node;
+  if (!unique || floor == nullptr) return nullptr;
+  this->count_comparison();
+  return floor->key < key ? nullptr : floor;
+}
+
+// Finds the free slot right before hint when key sorts there: the left link
+// of hint or the right one of its predecessor, whichever is nil
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+bool RedBlackTree<key_type, mapped_type, Allocator, Traits>::hintSlot(
+    const Node *hint, const key_type &key, bool unique, Node *&parent,
+    bool &to_left) const {
+  Node *next = const_cast<Node *>(hint);
+  if (root == TNULL || root == nullptr) {
+    parent = nullptr;
+    to_left = false;
+    return next == TNULL;
+  }
+  Node *prev = next == TNULL ? maximum(root) : predecessor(next);
+  if (next != TNULL) {
+    this->count_comparison();
+    if (unique ? !(key < next->key) : next->key < key) return false;
+  }
+  if (prev != nullptr) {
+    this->count_comparison();
+    if (unique ? !(prev->key < key) : key < prev->key) return false;
+  }
+  if (next != TNULL && next->left == TNULL) {
+    parent = next;
+    to_left = true;
   } else {
-    y->right = node;
+    parent = prev;
+    to_left = false;
   }
+  return true;
+}
 
-  if (node->parent == nullptr) {
-    node->color = 0;
-    return;
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename... Args>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::Node *
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::createNode(
+    Args &&...args) {
+  Node *node = node_traits::allocate(node_alloc, 1);
+  this->count_allocation();
+  try {
+    node_traits::construct(node_alloc, node, std::forward<Args>(args)...);
+  } catch (...) {
+    node_traits::deallocate(node_alloc, node, 1);
+    this->count_deallocation();
+    throw;
   }
+  node->left = TNULL;
+  node->right = TNULL;
+  balance_type::init(node);
+  return node;
+}
 
-  if (node->parent->parent == nullptr) return;
+// The nil leaf shared by every node, its key and value are never read
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::Node *
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::createSentinel() {
+  Node *node = node_traits::allocate(node_alloc, 1);
+  this->count_allocation();
+  try {
+    node_traits::construct(node_alloc, node);
+  } catch (...) {
+    node_traits::deallocate(node_alloc, node, 1);
+    this->count_deallocation();
+    throw;
+  }
+  if constexpr (augmented) node->aug = augment_type::identity();
+  return node;
+}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::destroyNode(
+    Node *node) {
+  node_traits::destroy(node_alloc, node);
+  node_traits::deallocate(node_alloc, node, 1);
+  this->count_deallocation();
+}
+
+// Frees a whole subtree without rebalancing, recursing only into the right
+// children so the depth stays within the tree height
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::destroySubtree(
+    Node *node) {
+  while (node != TNULL) {
+    destroySubtree(node->right);
+    Node *left = node->left;
+    destroyNode(node);
+    node = left;
+  }
+}
 
-  insertFix(node);
+// Returns every node and the sentinel to the allocator
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::releaseAll() {
+  if (TNULL == nullptr) return;
+  clear();
+  this->bloom_release(node_alloc);
+  destroyNode(TNULL);
+  TNULL = nullptr;
+  root = nullptr;
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-RedBlackTree<key_type, mapped_type, Allocator> &
-RedBlackTree<key_type, mapped_type, Allocator>::operator=(
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::cloneSubtree(
+    const Node *node, const Node *nil, Node *parent, Node *&slot) {
+  if (node == nil) return;
+  slot = createNode(node->key, node->value);
+  slot->parent = parent;
+  slot->rank = node->rank;
+  cloneSubtree(node->left, nil, slot, slot->left);
+  cloneSubtree(node->right, nil, slot, slot->right);
+  pull(slot);
+}
+
+// Copies the shape and ranks of other into this empty tree
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::copyFrom(
     const RedBlackTree &other) {
-  if (this == &other) return *this;
+  if (other.root == nullptr) return;
+  try {
+    cloneSubtree(other.root, other.TNULL, nullptr, root);
+    this->bloom_copy(node_alloc, other);
+  } catch (...) {
+    clear();
+    throw;
+  }
+  _size = other._size;
+}
 
-  while (root != TNULL) deleteNode(root->key);
-  if (TNULL != nullptr) {
-    node_alloc.destroy(TNULL);
-    node_alloc.deallocate(TNULL, 1);
+// Hangs a fresh node below parent and lets the policy rebalance
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::linkNode(
+    Node *node, Node *y, bool to_left) {
+  _size++;
+  node->parent = y;
+  if (y == nullptr) {
+    root = node;
+  } else if (to_left) {
+    y->left = node;
+  } else {
+    y->right = node;
   }
+  pull(node);
+  pullPath(y);
+  balance_type::inserted(*this, node);
+  if (this->bloom_add(node->key)) rebuildBloom();
+}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+RedBlackTree<key_type, mapped_type, Allocator, Traits> &
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::operator=(
+    const RedBlackTree &other) {
+  if (this == &other) return *this;
 
-  TNULL = node_alloc.allocate(1);
-  node_alloc.construct(TNULL);
+  releaseAll();
+  if constexpr (node_traits::propagate_on_container_copy_assignment::value)
+    node_alloc = other.node_alloc;
+  TNULL = createSentinel();
   root = TNULL;
-  RedBlackTreeConstIterator b(other.begin()), e(other.end());
-  while (b != e) {
-    insert((*b)->key, (*b)->value);
-    ++b;
-  }
+  copyFrom(other);
   return *this;
 }
 
-template <typename key_type, typename mapped_type, typename Allocator>
-RedBlackTree<key_type, mapped_type, Allocator> &
-RedBlackTree<key_type, mapped_type, Allocator>::operator=(
-    RedBlackTree &&other) noexcept {
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+RedBlackTree<key_type, mapped_type, Allocator, Traits> &
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::operator=(
+    RedBlackTree &&other) noexcept(
+    node_traits::propagate_on_container_move_assignment::value ||
+    node_traits::is_always_equal::value) {
   if (this == &other) return *this;
 
-  while (root != TNULL) deleteNode(root->key);
-  if (TNULL != nullptr) {
-    node_alloc.destroy(TNULL);
-    node_alloc.deallocate(TNULL, 1);
+  if constexpr (!node_traits::propagate_on_container_move_assignment::value &&
+                !node_traits::is_always_equal::value) {
+    // memory of a foreign allocator can't be adopted, copy the elements
+    if (node_alloc != other.node_alloc) {
+      if (TNULL == nullptr) {
+        TNULL = createSentinel();
+        root = TNULL;
+      }
+      clear();
+      copyFrom(other);
+      return *this;
+    }
   }
 
-  TNULL = std::move(other.TNULL);
-  root = std::move(other.root);
-  _size = std::move(other._size);
-  node_alloc = std::move(other.node_alloc);
+  releaseAll();
+  if constexpr (node_traits::propagate_on_container_move_assignment::value)
+    node_alloc = std::move(other.node_alloc);
+  TNULL = other.TNULL;
+  root = other.root;
+  _size = other._size;
 
   other.TNULL = nullptr;
   other.root = nullptr;
   other._size = 0;
+  this->bloom_swap(other);
 
   return *this;
 }
 
+// Allocators are exchanged only when they propagate on swap, swapping trees
+// with unequal allocators that don't is undefined as for std containers
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::swap(
+    RedBlackTree &other) noexcept {
+  std::swap(root, other.root);
+  std::swap(TNULL, other.TNULL);
+  std::swap(_size, other._size);
+  this->bloom_swap(other);
+  if constexpr (node_traits::propagate_on_container_swap::value) {
+    using std::swap;
+    swap(node_alloc, other.node_alloc);
+  }
+}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::Node *
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::predecessor(
+    Node *node) const {
+  if (node->left != TNULL) return maximum(node->left);
+  Node *parent = node->parent;
+  while (parent != nullptr && node == parent->left) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::Node *
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::successor(
+    Node *node) const {
+  if (node->right != TNULL) return minimum(node->right);
+  Node *parent = node->parent;
+  while (parent != nullptr && node == parent->right) {
+    node = parent;
+    parent = parent->parent;
+  }
+  return parent;
+}
+
+// Links sorted nodes into a tree split by size at every level, so all nil
+// links sit on two adjacent levels, and ranks the nodes bottom-up
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+typename RedBlackTree<key_type, mapped_type, Allocator, Traits>::Node *
+RedBlackTree<key_type, mapped_type, Allocator, Traits>::buildBalanced(
+    Node **nodes, std::size_t count, Node *parent, unsigned depth,
+    unsigned partial_level) {
+  if (count == 0) return TNULL;
+  std::size_t mid = count / 2;
+  Node *node = nodes[mid];
+  node->parent = parent;
+  node->left = buildBalanced(nodes, mid, node, depth + 1, partial_level);
+  node->right = buildBalanced(nodes + mid + 1, count - mid - 1, node,
+                              depth + 1, partial_level);
+  balance_type::built(node, depth, partial_level);
+  pull(node);
+  return node;
+}
+
+// Applies upsert/erase ops sorted by key and writes one batch_outcome per op.
+// Small batches walk from the previous op's node (finger search), large ones
+// merge with the in-order node list and relink it as a balanced tree.
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename ForwardIt, typename OutputIt>
+OutputIt RedBlackTree<key_type, mapped_type, Allocator, Traits>::applyBatch(
+    ForwardIt first, ForwardIt last, OutputIt out, bool unique) {
+  if (first == last) return out;
+  std::size_t ops = 1;
+  for (ForwardIt prev = first, it = std::next(first); it != last;
+       prev = it, ++it, ++ops) {
+    this->count_comparison();
+    if (it->key < prev->key)
+      throw std::invalid_argument("apply_batch expects ops sorted by key");
+  }
+
+  // a finger step costs about log2(gap between ops), the merge is linear
+  std::size_t gap = _size / ops + 1, finger_cost = 2;
+  while (gap >>= 1) ++finger_cost;
+  if (ops * finger_cost <= _size + ops)
+    return fingerBatch(first, last, out, unique);
+  return mergeBatch(first, last, out, unique);
+}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename ForwardIt, typename OutputIt>
+OutputIt RedBlackTree<key_type, mapped_type, Allocator, Traits>::fingerBatch(
+    ForwardIt first, ForwardIt last, OutputIt out, bool unique) {
+  // every op key is >= the finger's key, so only upper bounds are checked
+  Node *finger = nullptr;
+  for (; first != last; ++first) {
+    const key_type &key = first->key;
+    bool erase = first->kind == s21::batch_kind::erase;
+
+    Node *x = root;
+    if (finger != nullptr) {
+      x = finger;
+      while (x->parent != nullptr) {
+        if (x == x->parent->left) {
+          this->count_comparison();
+          if (key < x->parent->key) break;
+        }
+        x = x->parent;
+      }
+    }
+
+    Node *y = nullptr, *match = TNULL, *last_le = nullptr;
+    bool to_left = false;
+    while (x != TNULL) {
+      if (unique || erase) {
+        this->count_comparison();
+        if (key == x->key) {
+          match = x;
+          break;
+        }
+      }
+      y = x;
+      this->count_comparison();
+      to_left = key < x->key;
+      if (to_left) {
+        x = x->left;
+      } else {
+        last_le = x;
+        x = x->right;
+      }
+    }
+
+    if (erase) {
+      if (match == TNULL) {
+        *out++ = s21::batch_outcome::missing;
+        finger = last_le;
+      } else {
+        finger = predecessor(match);
+        removeNode(match);
+        *out++ = s21::batch_outcome::erased;
+      }
+    } else if (match != TNULL) {
+      match->value = s21::batch_value(*first);
+      pullPath(match);
+      *out++ = s21::batch_outcome::assigned;
+      finger = match;
+    } else {
+      Node *node = createNode(key, s21::batch_value(*first));
+      linkNode(node, y, to_left);
+      *out++ = s21::batch_outcome::inserted;
+      finger = node;
+    }
+  }
+  return out;
+}
+
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+template <typename ForwardIt, typename OutputIt>
+OutputIt RedBlackTree<key_type, mapped_type, Allocator, Traits>::mergeBatch(
+    ForwardIt first, ForwardIt last, OutputIt out, bool unique) {
+  std::vector<Node *> nodes;
+  nodes.reserve(_size);
+  if (root != TNULL)
+    for (Node *node = minimum(root); node; node = successor(node))
+      nodes.push_back(node);
+
+  // the tree keeps its links until the merge is done: erased nodes are
+  // freed after the relink, and new ones are freed again if an op throws
+  std::size_t ops = std::distance(first, last);
+  std::vector<Node *> merged, erased, created;
+  merged.reserve(nodes.size() + ops);
+  erased.reserve(ops);
+  created.reserve(ops);
+  try {
+    std::size_t i = 0;
+    for (; first != last; ++first) {
+      const key_type &key = first->key;
+      while (i < nodes.size() &&
+             (this->count_comparison(), nodes[i]->key < key))
+        merged.push_back(nodes[i++]);
+
+      // an equal key may still be in the tree or was just merged by the
+      // previous op on the same key
+      Node *tree_match = nullptr;
+      if (i < nodes.size()) {
+        this->count_comparison();
+        if (nodes[i]->key == key) tree_match = nodes[i];
+      }
+      bool back_match = !tree_match && !merged.empty() &&
+                        (this->count_comparison(), merged.back()->key == key);
+
+      if (first->kind == s21::batch_kind::erase) {
+        if (tree_match) {
+          erased.push_back(nodes[i++]);
+          *out++ = s21::batch_outcome::erased;
+        } else if (back_match) {
+          erased.push_back(merged.back());
+          merged.pop_back();
+          *out++ = s21::batch_outcome::erased;
+        } else {
+          *out++ = s21::batch_outcome::missing;
+        }
+      } else if (unique && (tree_match || back_match)) {
+        if (tree_match) merged.push_back(nodes[i++]);
+        merged.back()->value = s21::batch_value(*first);
+        *out++ = s21::batch_outcome::assigned;
+      } else {
+        // duplicates go after the equal keys already stored
+        while (i < nodes.size() &&
+               (this->count_comparison(), nodes[i]->key == key))
+          merged.push_back(nodes[i++]);
+        created.push_back(createNode(key, s21::batch_value(*first)));
+        merged.push_back(created.back());
+        *out++ = s21::batch_outcome::inserted;
+      }
+    }
+    while (i < nodes.size()) merged.push_back(nodes[i++]);
+  } catch (...) {
+    // the old nodes are all still linked; relinking them refolds any
+    // values already assigned
+    for (Node *node : created) destroyNode(node);
+    relinkBalanced(nodes);
+    throw;
+  }
+
+  relinkBalanced(merged);
+  for (Node *node : erased) destroyNode(node);
+  return out;
+}
+
+// Makes the sorted nodes the whole tree
+template <typename key_type, typename mapped_type, typename Allocator,
+          typename Traits>
+void RedBlackTree<key_type, mapped_type, Allocator, Traits>::relinkBalanced(
+    std::vector<Node *> &nodes) {
+  _size = nodes.size();
+  unsigned levels = 0;
+  while ((std::size_t(1) << levels) <= _size) ++levels;
+  bool full = ((_size + 1) & _size) == 0;
+  root = buildBalanced(nodes.data(), nodes.size(), nullptr, 0,
+                       full ? levels : levels - 1);
+  rebuildBloom();
+}
+
 #include "rb_tree_const_iterator.hpp"
 #include "rb_tree_iterator.hpp"
 
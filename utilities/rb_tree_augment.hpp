@@ -0,0 +1,129 @@
+#ifndef RB_TREE_AUGMENT_H
+#define RB_TREE_AUGMENT_H
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "rb_tree_traits.hpp"
+
+namespace s21 {
+
+// An augmentation keeps in every node the fold of its subtree in key order:
+//   aug = combine(combine(left.aug, measure(key, value)), right.aug)
+// A policy provides value_type, identity(), measure(key, value) and
+// combine(lhs, rhs). RedBlackTree refreshes the fold on insert, erase,
+// rotations and both fix-ups; the nil sentinel holds identity().
+
+// Per-node storage, empty when the traits name no augmentation
+template <typename Augment>
+struct augment_storage {
+  typename Augment::value_type aug;
+};
+
+template <>
+struct augment_storage<void> {};
+
+// Largest interval end in the subtree, for trees keyed by interval start
+// whose values carry the end in a member named hi
+template <typename Key>
+struct max_end_augment {
+  using value_type = Key;
+
+  static value_type identity() noexcept {
+    return std::numeric_limits<Key>::lowest();
+  }
+
+  template <typename Entry>
+  static const value_type &measure(const Key &, const Entry &entry) noexcept {
+    return entry.hi;
+  }
+
+  static value_type combine(const value_type &lhs,
+                            const value_type &rhs) noexcept {
+    return lhs < rhs ? rhs : lhs;
+  }
+};
+
+// A monoid names value_type and provides identity() and an associative
+// combine(lhs, rhs). It may also provide measure(key, value) to turn an
+// element into a value_type; by default the mapped value itself is used.
+template <typename Monoid, typename Key, typename Value, typename = void>
+struct has_measure : std::false_type {};
+
+template <typename Monoid, typename Key, typename Value>
+struct has_measure<Monoid, Key, Value,
+                   std::void_t<decltype(Monoid::measure(
+                       std::declval<const Key &>(),
+                       std::declval<const Value &>()))>> : std::true_type {};
+
+template <typename Monoid>
+struct monoid_augment {
+  using value_type = typename Monoid::value_type;
+
+  static value_type identity() { return Monoid::identity(); }
+
+  template <typename Key, typename Value>
+  static value_type measure(const Key &key, const Value &value) {
+    if constexpr (has_measure<Monoid, Key, Value>::value) {
+      return Monoid::measure(key, value);
+    } else {
+      (void)key;
+      return value_type(value);
+    }
+  }
+
+  static value_type combine(const value_type &lhs, const value_type &rhs) {
+    return Monoid::combine(lhs, rhs);
+  }
+};
+
+template <typename T>
+struct sum_monoid {
+  using value_type = T;
+  static T identity() { return T(); }
+  static T combine(const T &lhs, const T &rhs) { return lhs + rhs; }
+};
+
+template <typename T>
+struct min_monoid {
+  using value_type = T;
+  static T identity() { return std::numeric_limits<T>::max(); }
+  static T combine(const T &lhs, const T &rhs) {
+    return rhs < lhs ? rhs : lhs;
+  }
+};
+
+template <typename T>
+struct max_monoid {
+  using value_type = T;
+  static T identity() { return std::numeric_limits<T>::lowest(); }
+  static T combine(const T &lhs, const T &rhs) {
+    return lhs < rhs ? rhs : lhs;
+  }
+};
+
+// Number of elements, whatever their values
+struct count_monoid {
+  using value_type = std::size_t;
+  static std::size_t identity() { return 0; }
+  template <typename Key, typename Value>
+  static std::size_t measure(const Key &, const Value &) {
+    return 1;
+  }
+  static std::size_t combine(std::size_t lhs, std::size_t rhs) {
+    return lhs + rhs;
+  }
+};
+
+// Traits for a tree that keeps the Monoid fold of every subtree and answers
+// aggregate(lo, hi) in O(log n)
+template <typename Monoid>
+struct aggregate_tree_traits : tree_traits {
+  using augment = monoid_augment<Monoid>;
+};
+
+}  // namespace s21
+
+#endif
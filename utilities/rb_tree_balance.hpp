@@ -0,0 +1,340 @@
+#ifndef RB_TREE_BALANCE_H
+#define RB_TREE_BALANCE_H
+
+namespace s21 {
+
+// A balancing policy keeps a rank_type field in every node and restores its
+// invariant whenever RedBlackTree links or unlinks a node. The tree lets it
+// reach root, TNULL, the rotations and detach(); the nil sentinel always has
+// rank_type(). A policy provides
+//   init(node)           rank of a fresh node before it is linked as a leaf
+//   inserted(tree, node) node has just been linked below its parent
+//   erase(tree, node)    unlinks node and rebalances, the tree frees it
+//   built(node, depth, partial_level)
+//                        rank of a node in a tree relinked from sorted nodes
+//                        by halving, its children are already ranked and
+//                        partial_level is the depth of the incomplete bottom
+//                        level (past the last level when none is)
+
+// Red-black colouring, the default. At most 2 log2(n + 1) levels, an insert
+// rotates at most twice and an erase at most three times.
+struct red_black_balance {
+  using rank_type = unsigned char;
+  static constexpr rank_type black = 0;
+  static constexpr rank_type red = 1;
+
+  template <typename Node>
+  static void init(Node *node) noexcept {
+    node->rank = red;
+  }
+
+  template <typename Tree, typename Node>
+  static void inserted(Tree &tree, Node *k) {
+    if (k->parent == nullptr) {
+      k->rank = black;
+      return;
+    }
+    if (k->parent->parent == nullptr) return;
+
+    while (k->parent->rank == red) {
+      tree.count_fix_iteration();
+      if (k->parent == k->parent->parent->right) {
+        Node *u = k->parent->parent->left;
+        if (u->rank == red) {
+          u->rank = black;
+          k->parent->rank = black;
+          k->parent->parent->rank = red;
+          k = k->parent->parent;
+        } else {
+          if (k == k->parent->left) {
+            k = k->parent;
+            tree.rightRotate(k);
+          }
+          k->parent->rank = black;
+          k->parent->parent->rank = red;
+          tree.leftRotate(k->parent->parent);
+        }
+      } else {
+        Node *u = k->parent->parent->right;
+        if (u->rank == red) {
+          u->rank = black;
+          k->parent->rank = black;
+          k->parent->parent->rank = red;
+          k = k->parent->parent;
+        } else {
+          if (k == k->parent->right) {
+            k = k->parent;
+            tree.leftRotate(k);
+          }
+          k->parent->rank = black;
+          k->parent->parent->rank = red;
+          tree.rightRotate(k->parent->parent);
+        }
+      }
+      if (k == tree.root) break;
+    }
+    tree.root->rank = black;
+  }
+
+  template <typename Tree, typename Node>
+  static void erase(Tree &tree, Node *z) {
+    auto [x, removed] = tree.detach(z);
+    if (removed == black) eraseFix(tree, x);
+  }
+
+  // A size-halved tree has its nil links on two adjacent levels, painting
+  // the deepest level red when it is not full evens out the black height
+  template <typename Node>
+  static void built(Node *node, unsigned depth,
+                    unsigned partial_level) noexcept {
+    node->rank = depth == partial_level ? red : black;
+  }
+
+ private:
+  template <typename Tree, typename Node>
+  static void eraseFix(Tree &tree, Node *x) {
+    while (x != tree.root && x->rank == black) {
+      tree.count_fix_iteration();
+      if (x == x->parent->left) {
+        Node *s = x->parent->right;
+        if (s->rank == red) {
+          s->rank = black;
+          x->parent->rank = red;
+          tree.leftRotate(x->parent);
+          s = x->parent->right;
+        }
+
+        if (s->left->rank == black && s->right->rank == black) {
+          s->rank = red;
+          x = x->parent;
+        } else {
+          if (s->right->rank == black) {
+            s->left->rank = black;
+            s->rank = red;
+            tree.rightRotate(s);
+            s = x->parent->right;
+          }
+
+          s->rank = x->parent->rank;
+          x->parent->rank = black;
+          s->right->rank = black;
+          tree.leftRotate(x->parent);
+          x = tree.root;
+        }
+      } else {
+        Node *s = x->parent->left;
+        if (s->rank == red) {
+          s->rank = black;
+          x->parent->rank = red;
+          tree.rightRotate(x->parent);
+          s = x->parent->left;
+        }
+
+        if (s->right->rank == black && s->left->rank == black) {
+          s->rank = red;
+          x = x->parent;
+        } else {
+          if (s->left->rank == black) {
+            s->right->rank = black;
+            s->rank = red;
+            tree.leftRotate(s);
+            s = x->parent->left;
+          }
+
+          s->rank = x->parent->rank;
+          x->parent->rank = black;
+          s->left->rank = black;
+          tree.rightRotate(x->parent);
+          x = tree.root;
+        }
+      }
+    }
+    x->rank = black;
+  }
+};
+
+// Sibling subtrees differ in height by at most one: at most 1.44 log2(n + 2)
+// levels, so lookups walk shorter paths than in a red-black tree. An insert
+// rotates at most twice, an erase may rotate at every level on its path.
+struct avl_balance {
+  using rank_type = unsigned char;  // height of the subtree, 0 for nil
+
+  template <typename Node>
+  static void init(Node *node) noexcept {
+    node->rank = 1;
+  }
+
+  template <typename Tree, typename Node>
+  static void inserted(Tree &tree, Node *node) {
+    retrace(tree, node->parent);
+  }
+
+  template <typename Tree, typename Node>
+  static void erase(Tree &tree, Node *z) {
+    Node *x = tree.detach(z).first;
+    retrace(tree, x->parent);
+  }
+
+  template <typename Node>
+  static void built(Node *node, unsigned, unsigned) noexcept {
+    update(node);
+  }
+
+ private:
+  template <typename Node>
+  static void update(Node *node) noexcept {
+    rank_type lhs = node->left->rank, rhs = node->right->rank;
+    node->rank = static_cast<rank_type>(1 + (lhs > rhs ? lhs : rhs));
+  }
+
+  // Walks up from node, rebalancing each subtree, until one comes out as
+  // high as it was before the update
+  template <typename Tree, typename Node>
+  static void retrace(Tree &tree, Node *node) {
+    while (node != nullptr) {
+      tree.count_fix_iteration();
+      rank_type before = node->rank;
+      Node *top = restore(tree, node);
+      if (top->rank == before) return;
+      node = top->parent;
+    }
+  }
+
+  // Returns the root of the rebalanced subtree that was rooted at n
+  template <typename Tree, typename Node>
+  static Node *restore(Tree &tree, Node *n) {
+    int skew = n->left->rank - n->right->rank;
+    if (skew > 1) {
+      Node *l = n->left;
+      if (l->left->rank < l->right->rank) {
+        tree.leftRotate(l);
+        update(l);
+        update(l->parent);
+      }
+      tree.rightRotate(n);
+    } else if (skew < -1) {
+      Node *r = n->right;
+      if (r->right->rank < r->left->rank) {
+        tree.rightRotate(r);
+        update(r);
+        update(r->parent);
+      }
+      tree.leftRotate(n);
+    } else {
+      update(n);
+      return n;
+    }
+    update(n);
+    update(n->parent);
+    return n->parent;
+  }
+};
+
+// Weak AVL (Haeupler, Sen, Tarjan): every rank difference is 1 or 2 and no
+// leaf has two 2-children. Without erases the shape is exactly AVL, with
+// them the height stays within 2 log2(n) levels. Every insert and erase
+// rotates at most twice, the rest of the fix-up only bumps ranks.
+struct wavl_balance {
+  using rank_type = unsigned char;  // rank + 1, so nil is 0 and a leaf 1
+
+  template <typename Node>
+  static void init(Node *node) noexcept {
+    node->rank = 1;
+  }
+
+  template <typename Tree, typename Node>
+  static void inserted(Tree &tree, Node *x) {
+    // x is a 0-child of p while they share a rank
+    for (Node *p = x->parent; p != nullptr && p->rank == x->rank;
+         x = p, p = p->parent) {
+      tree.count_fix_iteration();
+      bool left = x == p->left;
+      Node *s = left ? p->right : p->left;
+      if (p->rank - s->rank == 1) {
+        ++p->rank;
+        continue;
+      }
+
+      Node *y = left ? x->right : x->left;
+      if (x->rank - y->rank == 2) {
+        rotateUp(tree, x);
+        --p->rank;
+      } else {
+        rotateUp(tree, y);
+        rotateUp(tree, y);
+        ++y->rank;
+        --x->rank;
+        --p->rank;
+      }
+      return;
+    }
+  }
+
+  template <typename Tree, typename Node>
+  static void erase(Tree &tree, Node *z) {
+    Node *x = tree.detach(z).first;
+    Node *p = x->parent;
+    if (p == nullptr) return;
+
+    // losing its only child leaves p a leaf of rank 1, which is a 2,2 leaf
+    if (p->left == tree.TNULL && p->right == tree.TNULL && p->rank == 2) {
+      p->rank = 1;
+      x = p;
+      p = p->parent;
+    }
+
+    // x is a 3-child of p while their ranks are 3 apart
+    for (; p != nullptr && p->rank - x->rank == 3; x = p, p = p->parent) {
+      tree.count_fix_iteration();
+      bool left = x == p->left;
+      Node *y = left ? p->right : p->left;
+      if (p->rank - y->rank == 2) {
+        --p->rank;
+        continue;
+      }
+      if (y->rank - y->left->rank == 2 && y->rank - y->right->rank == 2) {
+        --p->rank;
+        --y->rank;
+        continue;
+      }
+
+      Node *outer = left ? y->right : y->left;
+      Node *inner = left ? y->left : y->right;
+      if (y->rank - outer->rank == 1) {
+        rotateUp(tree, y);
+        ++y->rank;
+        --p->rank;
+        if (p->left == tree.TNULL && p->right == tree.TNULL) --p->rank;
+      } else {
+        rotateUp(tree, inner);
+        rotateUp(tree, inner);
+        inner->rank += 2;
+        --y->rank;
+        p->rank -= 2;
+      }
+      return;
+    }
+  }
+
+  // Ranks equal to heights satisfy the rank rule in a size-halved tree
+  template <typename Node>
+  static void built(Node *node, unsigned, unsigned) noexcept {
+    rank_type lhs = node->left->rank, rhs = node->right->rank;
+    node->rank = static_cast<rank_type>(1 + (lhs > rhs ? lhs : rhs));
+  }
+
+ private:
+  // Rotates node above its parent
+  template <typename Tree, typename Node>
+  static void rotateUp(Tree &tree, Node *node) {
+    if (node == node->parent->left) {
+      tree.rightRotate(node->parent);
+    } else {
+      tree.leftRotate(node->parent);
+    }
+  }
+};
+
+}  // namespace s21
+
+#endif
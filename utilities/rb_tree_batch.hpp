@@ -0,0 +1,37 @@
+#ifndef RB_TREE_BATCH_H
+#define RB_TREE_BATCH_H
+
+namespace s21 {
+
+enum class batch_kind { upsert, erase };
+
+enum class batch_outcome { inserted, assigned, erased, missing };
+
+// One entry of a change-set for apply_batch(), ops must be sorted by key
+template <typename Key, typename T = void>
+struct batch_op {
+  batch_kind kind;
+  Key key;
+  T value;
+};
+
+// Set-like containers carry no mapped value
+template <typename Key>
+struct batch_op<Key, void> {
+  batch_kind kind;
+  Key key;
+};
+
+template <typename Key, typename T>
+const T &batch_value(const batch_op<Key, T> &op) noexcept {
+  return op.value;
+}
+
+template <typename Key>
+const Key &batch_value(const batch_op<Key, void> &op) noexcept {
+  return op.key;
+}
+
+}  // namespace s21
+
+#endif
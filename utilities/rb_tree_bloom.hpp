@@ -0,0 +1,271 @@
+#ifndef RB_TREE_BLOOM_H
+#define RB_TREE_BLOOM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace s21 {
+
+// What the Bloom filter in front of a tree did for its lookups. The lookup
+// counts stay 0 unless the traits set count_bloom_lookups.
+struct bloom_filter_stats {
+  std::size_t rejected = 0;         // answered by the filter alone
+  std::size_t passed = 0;           // sent on to the tree walk
+  std::size_t false_positives = 0;  // passed, but the tree had no such key
+  std::size_t rebuilds = 0;
+  std::size_t bytes = 0;  // size of the filter right now
+};
+
+// Lookup counters of the filter. Disabled: no fields, every hook is an
+// empty inline call, so a rejected lookup touches nothing but its block.
+template <bool Enabled>
+class bloom_lookup_counters {
+ protected:
+  void count_passed() const noexcept {}
+  void count_rejected() const noexcept {}
+  void count_false_positive() const noexcept {}
+  void read_lookup_counts(bloom_filter_stats &) const noexcept {}
+  void reset_lookup_counts() const noexcept {}
+};
+
+// Enabled: relaxed atomics, since const lookups may run on several threads
+// at once. Every lookup writes one of them, so concurrent readers share
+// that cache line.
+template <>
+class bloom_lookup_counters<true> {
+ protected:
+  void count_passed() const noexcept { bump(passed_); }
+  void count_rejected() const noexcept { bump(rejected_); }
+  void count_false_positive() const noexcept { bump(false_positives_); }
+
+  void read_lookup_counts(bloom_filter_stats &stats) const noexcept {
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    stats.passed = passed_.load(std::memory_order_relaxed);
+    stats.false_positives = false_positives_.load(std::memory_order_relaxed);
+  }
+
+  void reset_lookup_counts() noexcept {
+    rejected_.store(0, std::memory_order_relaxed);
+    passed_.store(0, std::memory_order_relaxed);
+    false_positives_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  static void bump(std::atomic<std::size_t> &counter) noexcept {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  mutable std::atomic<std::size_t> rejected_{0};
+  mutable std::atomic<std::size_t> passed_{0};
+  mutable std::atomic<std::size_t> false_positives_{0};
+};
+
+// Blocked Bloom filter kept by RedBlackTree when the traits ask for one.
+// Every key sets all of its bits inside one 64-byte block, so a lookup for
+// a missing key touches a single cache line before giving up. Erased keys
+// stay in the filter until enough of them pile up, then the tree rebuilds
+// it from its nodes; it also rebuilds when the keys outgrow the size the
+// filter was planned for. The tree passes its allocator to every call that
+// allocates or frees.
+template <typename Key, unsigned BitsPerKey, bool CountLookups = false>
+class tree_bloom_filter : private bloom_lookup_counters<CountLookups> {
+ protected:
+  tree_bloom_filter() noexcept = default;
+  tree_bloom_filter(const tree_bloom_filter &) = delete;
+  tree_bloom_filter &operator=(const tree_bloom_filter &) = delete;
+
+  bool bloom_may_contain(const Key &key) const noexcept {
+    if (blocks_ == nullptr) {
+      this->count_passed();
+      return true;
+    }
+    std::uint64_t h = hash(key);
+    const std::uint64_t *words = block_of(h)->words;
+    bool present = true;
+    for_each_bit(h, [&](unsigned bit) {
+      present = present && (words[bit >> 6] >> (bit & 63) & 1);
+    });
+    if (present)
+      this->count_passed();
+    else
+      this->count_rejected();
+    return present;
+  }
+
+  void bloom_missed() const noexcept { this->count_false_positive(); }
+
+  // Returns true once the filter holds more keys than it was sized for
+  bool bloom_add(const Key &key) noexcept {
+    if (blocks_ != nullptr) set_bits(hash(key));
+    return ++keys_ > planned_;
+  }
+
+  // Returns true once stale keys make up a quarter of the filter
+  bool bloom_erase() noexcept { return ++stale_ * 4 > keys_; }
+
+  // Replaces the filter with one sized for twice count keys and fills it
+  // with the keys walk passes to its callback. On allocation failure the
+  // old filter stays, it never misses a key that is present.
+  template <typename Alloc, typename Walk>
+  void bloom_rebuild(Alloc &alloc, std::size_t count, Walk walk) noexcept {
+    std::size_t planned = count < 32 ? 64 : 2 * count;
+    std::size_t size = (planned * BitsPerKey + block_bits - 1) / block_bits;
+    auto rebound = block_alloc<Alloc>(alloc);
+    block *blocks;
+    try {
+      blocks = block_traits<Alloc>::allocate(rebound, size);
+    } catch (...) {
+      return;
+    }
+    bloom_release(alloc);
+    std::memset(static_cast<void *>(blocks), 0, size * sizeof(block));
+    blocks_ = blocks;
+    size_ = size;
+    planned_ = planned;
+    walk([this](const Key &key) { set_bits(hash(key)); });
+    keys_ = count;
+    stale_ = 0;
+    ++rebuilds_;
+  }
+
+  template <typename Alloc>
+  void bloom_copy(Alloc &alloc, const tree_bloom_filter &other) {
+    if (other.blocks_ == nullptr) return;
+    auto rebound = block_alloc<Alloc>(alloc);
+    block *blocks = block_traits<Alloc>::allocate(rebound, other.size_);
+    std::memcpy(static_cast<void *>(blocks), other.blocks_,
+                other.size_ * sizeof(block));
+    bloom_release(alloc);
+    blocks_ = blocks;
+    size_ = other.size_;
+    planned_ = other.planned_;
+    keys_ = other.keys_;
+    stale_ = other.stale_;
+  }
+
+  template <typename Alloc>
+  void bloom_release(Alloc &alloc) noexcept {
+    if (blocks_ != nullptr) {
+      auto rebound = block_alloc<Alloc>(alloc);
+      block_traits<Alloc>::deallocate(rebound, blocks_, size_);
+    }
+    blocks_ = nullptr;
+    size_ = planned_ = keys_ = stale_ = 0;
+  }
+
+  // Forgets every key but keeps the memory for the next fill
+  void bloom_clear() noexcept {
+    if (blocks_ != nullptr)
+      std::memset(static_cast<void *>(blocks_), 0, size_ * sizeof(block));
+    keys_ = stale_ = 0;
+  }
+
+  void bloom_swap(tree_bloom_filter &other) noexcept {
+    std::swap(blocks_, other.blocks_);
+    std::swap(size_, other.size_);
+    std::swap(planned_, other.planned_);
+    std::swap(keys_, other.keys_);
+    std::swap(stale_, other.stale_);
+  }
+
+  bloom_filter_stats bloom_counters() const noexcept {
+    bloom_filter_stats current;
+    this->read_lookup_counts(current);
+    current.rebuilds = rebuilds_;
+    current.bytes = size_ * sizeof(block);
+    return current;
+  }
+
+  void reset_bloom_counters() noexcept {
+    this->reset_lookup_counts();
+    rebuilds_ = 0;
+  }
+
+ private:
+  static constexpr unsigned block_bits = 512;
+  // about ln 2 bits per key probed, at most the 16 a block can take well
+  static constexpr unsigned probes =
+      BitsPerKey * 69 / 100 < 1    ? 1
+      : BitsPerKey * 69 / 100 > 16 ? 16
+                                   : BitsPerKey * 69 / 100;
+
+  struct alignas(64) block {
+    std::uint64_t words[8];
+  };
+
+  template <typename Alloc>
+  using block_alloc =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<block>;
+  template <typename Alloc>
+  using block_traits = std::allocator_traits<block_alloc<Alloc>>;
+
+  static std::uint64_t mix(std::uint64_t h) noexcept {
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+  }
+
+  // std::hash of integers is the identity, so it is mixed once more
+  static std::uint64_t hash(const Key &key) noexcept {
+    return mix(static_cast<std::uint64_t>(std::hash<Key>()(key)));
+  }
+
+  // The high half picks the block, the bit positions come from a remix
+  block *block_of(std::uint64_t h) const noexcept {
+    return blocks_ + ((h >> 32) * size_ >> 32);
+  }
+
+  template <typename Fn>
+  static void for_each_bit(std::uint64_t h, Fn fn) noexcept {
+    std::uint64_t bits = 0;
+    for (unsigned i = 0; i < probes; ++i) {
+      if (i % 7 == 0) bits = mix(h + i);
+      fn(static_cast<unsigned>(bits & (block_bits - 1)));
+      bits >>= 9;
+    }
+  }
+
+  void set_bits(std::uint64_t h) noexcept {
+    std::uint64_t *words = block_of(h)->words;
+    for_each_bit(h, [words](unsigned bit) {
+      words[bit >> 6] |= std::uint64_t(1) << (bit & 63);
+    });
+  }
+
+  block *blocks_ = nullptr;
+  std::size_t size_ = 0;     // blocks
+  std::size_t planned_ = 0;  // keys the filter was sized for
+  std::size_t keys_ = 0;     // keys added since the last rebuild, stale too
+  std::size_t stale_ = 0;    // erased keys still in the filter
+  std::size_t rebuilds_ = 0;
+};
+
+// Disabled filter: no fields, every key may be present
+template <typename Key, bool CountLookups>
+class tree_bloom_filter<Key, 0, CountLookups> {
+ protected:
+  constexpr bool bloom_may_contain(const Key &) const noexcept { return true; }
+  void bloom_missed() const noexcept {}
+  bool bloom_add(const Key &) const noexcept { return false; }
+  bool bloom_erase() const noexcept { return false; }
+  template <typename Alloc, typename Walk>
+  void bloom_rebuild(Alloc &, std::size_t, Walk) const noexcept {}
+  template <typename Alloc>
+  void bloom_copy(Alloc &, const tree_bloom_filter &) const noexcept {}
+  template <typename Alloc>
+  void bloom_release(Alloc &) const noexcept {}
+  void bloom_clear() const noexcept {}
+  void bloom_swap(tree_bloom_filter &) const noexcept {}
+};
+
+}  // namespace s21
+
+#endif
@@ -1,11 +1,11 @@
 #ifndef RB_TREE_CONSTITERATOR
 #define RB_TREE_CONSTITERATOR
 
-template <typename T, typename ValueType, typename Allocator>
+template <typename T, typename ValueType, typename Allocator, typename Traits>
 class RedBlackTree;
 
-template <typename T, typename ValueType, typename Allocator>
-class RedBlackTree<T, ValueType, Allocator>::RedBlackTreeConstIterator {
+template <typename T, typename ValueType, typename Allocator, typename Traits>
+class RedBlackTree<T, ValueType, Allocator, Traits>::RedBlackTreeConstIterator {
  public:
   RedBlackTreeConstIterator() noexcept {}
   RedBlackTreeConstIterator(const RedBlackTreeConstIterator &it) noexcept
@@ -42,7 +42,7 @@ class RedBlackTree<T, ValueType, Allocator>::RedBlackTreeConstIterator {
     return ptr != other.ptr;
   }
 
-  const Node *operator*() { return ptr; }
+  const Node *operator*() const { return ptr; }
 
   RedBlackTreeConstIterator operator++(int) noexcept {
     RedBlackTreeConstIterator it(*this);
@@ -85,38 +85,36 @@ class RedBlackTree<T, ValueType, Allocator>::RedBlackTreeConstIterator {
   }
 
  private:
+  // Walks the links rather than comparing keys, so runs of equal keys in a
+  // multiset are stepped through one node at a time
   const Node *next(const Node *root) noexcept {
     if (!root->right) return nullptr;
-    if (!root->right->right && !root->right->left) {
-      Node *parent = root->parent;
-      while (parent) {
-        if (parent->key >= root->key) {
-          return parent;
-        }
-        parent = parent->parent;
-      }
-      return root->right;
+    if (root->right->left) {
+      const Node *right = root->right;
+      while (right->left->left) right = right->left;
+      return right;
     }
-    Node *right = root->right;
-    while (right->left->left && right->left->right) right = right->left;
-    return right;
+    const Node *nil = root->right, *parent = root->parent;
+    while (parent && root == parent->right) {
+      root = parent;
+      parent = parent->parent;
+    }
+    return parent ? parent : nil;
   }
 
   const Node *prev(const Node *root) noexcept {
     if (!root->left) return nullptr;
-    if (!root->left->right && !root->left->left) {
-      Node *parent = root->parent;
-      while (parent) {
-        if (parent->key <= root->key) {
-          return parent;
-        }
-        parent = parent->parent;
-      }
-      return root->left;
+    if (root->left->right) {
+      const Node *left = root->left;
+      while (left->right->right) left = left->right;
+      return left;
+    }
+    const Node *nil = root->left, *parent = root->parent;
+    while (parent && root == parent->left) {
+      root = parent;
+      parent = parent->parent;
     }
-    Node *left = root->left;
-    while (left->right->left && left->right->right) left = left->right;
-    return left;
+    return parent ? parent : nil;
   }
 
   const Node *ptr, *prev_ptr, *next_ptr;
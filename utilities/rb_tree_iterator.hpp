@@ -1,11 +1,11 @@
 #ifndef RB_TREE_ITERATOR
 #define RB_TREE_ITERATOR
 
-template <typename T, typename ValueType, typename Allocator>
+template <typename T, typename ValueType, typename Allocator, typename Traits>
 class RedBlackTree;
 
-template <typename T, typename ValueType, typename Allocator>
-class RedBlackTree<T, ValueType, Allocator>::RedBlackTreeIterator {
+template <typename T, typename ValueType, typename Allocator, typename Traits>
+class RedBlackTree<T, ValueType, Allocator, Traits>::RedBlackTreeIterator {
  public:
   RedBlackTreeIterator() noexcept {}
   RedBlackTreeIterator(const RedBlackTreeIterator &it) noexcept
@@ -41,7 +41,7 @@ class RedBlackTree<T, ValueType, Allocator>::RedBlackTreeIterator {
     return ptr != other.ptr;
   }
 
-  Node *operator*() { return ptr; }
+  Node *operator*() const { return ptr; }
 
   RedBlackTreeIterator operator++(int) noexcept {
     RedBlackTreeIterator it(*this);
@@ -84,38 +84,36 @@ class RedBlackTree<T, ValueType, Allocator>::RedBlackTreeIterator {
   }
 
  private:
+  // Walks the links rather than comparing keys, so runs of equal keys in a
+  // multiset are stepped through one node at a time
   Node *next(Node *root) noexcept {
     if (!root->right) return nullptr;
-    if (!root->right->right && !root->right->left) {
-      Node *parent = root->parent;
-      while (parent) {
-        if (parent->key >= root->key) {
-          return parent;
-        }
-        parent = parent->parent;
-      }
-      return root->right;
+    if (root->right->left) {
+      Node *right = root->right;
+      while (right->left->left) right = right->left;
+      return right;
     }
-    Node *right = root->right;
-    while (right->left->left && right->left->right) right = right->left;
-    return right;
+    Node *nil = root->right, *parent = root->parent;
+    while (parent && root == parent->right) {
+      root = parent;
+      parent = parent->parent;
+    }
+    return parent ? parent : nil;
   }
 
   Node *prev(Node *root) noexcept {
     if (!root->left) return nullptr;
-    if (!root->left->right && !root->left->left) {
-      Node *parent = root->parent;
-      while (parent) {
-        if (parent->key <= root->key) {
-          return parent;
-        }
-        parent = parent->parent;
-      }
-      return root->left;
+    if (root->left->right) {
+      Node *left = root->left;
+      while (left->right->right) left = left->right;
+      return left;
+    }
+    Node *nil = root->left, *parent = root->parent;
+    while (parent && root == parent->left) {
+      root = parent;
+      parent = parent->parent;
     }
-    Node *left = root->left;
-    while (left->right->left && left->right->right) left = left->right;
-    return left;
+    return parent ? parent : nil;
   }
 
   Node *ptr, *prev_ptr, *next_ptr;
@@ -0,0 +1,51 @@
+#ifndef RB_TREE_PREFIX_H
+#define RB_TREE_PREFIX_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace s21 {
+
+// Order-preserving image of the first bytes of a key. When two images differ
+// they order the keys the same way operator< does; equal images say nothing
+// and the full keys have to be compared.
+template <typename Key>
+struct key_prefix;
+
+// First 8 bytes read big-endian and zero-padded, so the integer order is the
+// unsigned byte order of std::char_traits<char>::compare
+template <>
+struct key_prefix<std::string_view> {
+  static std::uint64_t of(std::string_view key) noexcept {
+    unsigned char bytes[8] = {};
+    std::memcpy(bytes, key.data(), key.size() < 8 ? key.size() : 8);
+    std::uint64_t prefix;
+    std::memcpy(&prefix, bytes, 8);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    prefix = __builtin_bswap64(prefix);
+#endif
+    return prefix;
+  }
+};
+
+template <>
+struct key_prefix<std::string> {
+  static std::uint64_t of(const std::string &key) noexcept {
+    return key_prefix<std::string_view>::of(key);
+  }
+};
+
+// Per-node copy of the prefix, empty unless the traits enable it
+template <bool Enabled>
+struct prefix_storage {
+  std::uint64_t prefix = 0;
+};
+
+template <>
+struct prefix_storage<false> {};
+
+}  // namespace s21
+
+#endif
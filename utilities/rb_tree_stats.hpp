@@ -0,0 +1,85 @@
+#ifndef RB_TREE_STATS_H
+#define RB_TREE_STATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+
+namespace s21 {
+
+// Hot-path counters collected by RedBlackTree when the traits enable them
+struct tree_stats {
+  std::size_t comparisons = 0;
+  std::size_t rotations = 0;
+  std::size_t fix_iterations = 0;
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  unsigned height = 0;      // height right now, stats() walks the tree
+  unsigned max_height = 0;  // deepest insertion path ever walked
+};
+
+// Disabled collector: no fields, every hook is an empty inline call
+template <bool Enabled>
+class tree_stats_collector {
+ protected:
+  void count_comparison() const noexcept {}
+  void count_rotation() const noexcept {}
+  void count_fix_iteration() const noexcept {}
+  void count_allocation() const noexcept {}
+  void count_deallocation() const noexcept {}
+  void record_depth(unsigned) const noexcept {}
+  void reset_counters() const noexcept {}
+  tree_stats counters() const noexcept { return tree_stats(); }
+};
+
+// Enabled collector: relaxed atomics, since const lookups bump the
+// comparison count and may run on several threads at once
+template <>
+class tree_stats_collector<true> {
+ protected:
+  void count_comparison() const noexcept { bump(comparisons_); }
+  void count_rotation() const noexcept { bump(rotations_); }
+  void count_fix_iteration() const noexcept { bump(fix_iterations_); }
+  void count_allocation() const noexcept { bump(allocations_); }
+  void count_deallocation() const noexcept { bump(deallocations_); }
+  void record_depth(unsigned depth) const noexcept {
+    unsigned seen = max_height_.load(std::memory_order_relaxed);
+    while (depth > seen && !max_height_.compare_exchange_weak(
+                               seen, depth, std::memory_order_relaxed)) {
+    }
+  }
+
+  void reset_counters() const noexcept {
+    for (auto *counter : {&comparisons_, &rotations_, &fix_iterations_,
+                          &allocations_, &deallocations_})
+      counter->store(0, std::memory_order_relaxed);
+    max_height_.store(0, std::memory_order_relaxed);
+  }
+
+  tree_stats counters() const noexcept {
+    tree_stats current;
+    current.comparisons = comparisons_.load(std::memory_order_relaxed);
+    current.rotations = rotations_.load(std::memory_order_relaxed);
+    current.fix_iterations = fix_iterations_.load(std::memory_order_relaxed);
+    current.allocations = allocations_.load(std::memory_order_relaxed);
+    current.deallocations = deallocations_.load(std::memory_order_relaxed);
+    current.max_height = max_height_.load(std::memory_order_relaxed);
+    return current;
+  }
+
+ private:
+  static void bump(std::atomic<std::size_t> &counter) noexcept {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  mutable std::atomic<std::size_t> comparisons_{0};
+  mutable std::atomic<std::size_t> rotations_{0};
+  mutable std::atomic<std::size_t> fix_iterations_{0};
+  mutable std::atomic<std::size_t> allocations_{0};
+  mutable std::atomic<std::size_t> deallocations_{0};
+  mutable std::atomic<unsigned> max_height_{0};
+};
+
+}  // namespace s21
+
+#endif
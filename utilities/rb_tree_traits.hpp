@@ -0,0 +1,65 @@
+#ifndef RB_TREE_TRAITS_H
+#define RB_TREE_TRAITS_H
+
+#include "rb_tree_balance.hpp"
+
+namespace s21 {
+
+// Compile-time options of RedBlackTree. Derive from it and override the
+// members to switch features on for a particular container type.
+struct tree_traits {
+  static constexpr bool collect_stats = false;
+  static constexpr bool count_duplicates = false;
+  // nodes keep s21::key_prefix of their key to settle most comparisons
+  static constexpr bool cache_key_prefix = false;
+  // bits of a blocked Bloom filter per key checked before every lookup,
+  // 0 keeps the tree without one
+  static constexpr unsigned bloom_bits_per_key = 0;
+  // bloom_stats() also counts rejected, passed and falsely passed lookups;
+  // off by default, as each lookup then writes a counter shared by all
+  // readers of the tree
+  static constexpr bool count_bloom_lookups = false;
+  // policy from rb_tree_augment.hpp folded into every node, none by default
+  using augment = void;
+  // policy from rb_tree_balance.hpp that keeps the tree shallow
+  using balance = red_black_balance;
+};
+
+struct stats_tree_traits : tree_traits {
+  static constexpr bool collect_stats = true;
+};
+
+// multiset keeps one node per distinct key together with its multiplicity
+// instead of one node per copy
+struct counted_tree_traits : tree_traits {
+  static constexpr bool count_duplicates = true;
+};
+
+// For long string keys: a lookup compares the cached 8-byte prefixes first
+// and reads the key buffers only on a tie
+struct prefix_tree_traits : tree_traits {
+  static constexpr bool cache_key_prefix = true;
+};
+
+// For lookups that mostly miss: a key the filter rules out costs one cache
+// line instead of a walk down the tree
+template <unsigned BitsPerKey = 10, bool CountLookups = false>
+struct bloom_tree_traits : tree_traits {
+  static constexpr unsigned bloom_bits_per_key = BitsPerKey;
+  static constexpr bool count_bloom_lookups = CountLookups;
+};
+
+// Shortest lookup paths, for maps that are read far more than written
+struct avl_tree_traits : tree_traits {
+  using balance = avl_balance;
+};
+
+// Fewer rotations than AVL on erase at nearly AVL height, for write-heavy
+// maps
+struct wavl_tree_traits : tree_traits {
+  using balance = wavl_balance;
+};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef RELOCATE_H
+#define RELOCATE_H
+
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+
+namespace s21 {
+
+// Moving a trivially relocatable object to new storage and ending the old
+// one is the same as copying its bytes. Trivially copyable types are, and a
+// type that keeps no pointers into itself can opt in by specializing this.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// Their copy constructors are user-provided but copy no more than the bytes
+template <typename T>
+struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+template <typename T>
+struct is_trivially_relocatable<std::pmr::polymorphic_allocator<T>>
+    : std::true_type {};
+
+// A container may relocate its elements with memcpy unless its allocator
+// would construct them with itself as an argument; std::allocator never does
+template <typename T, typename Allocator>
+inline constexpr bool relocate_by_memcpy =
+    is_trivially_relocatable<T>::value &&
+    (std::is_same<Allocator, std::allocator<T>>::value ||
+     !std::uses_allocator<T, Allocator>::value);
+
+}  // namespace s21
+
+#endif
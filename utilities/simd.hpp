@@ -0,0 +1,488 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+// Generic vector types: GCC and Clang lower them to SSE2 on x86-64, NEON on
+// ARM, or plain scalar code elsewhere. On x86 an AVX2 copy of every kernel
+// is picked at run time when the CPU has it.
+#if defined(__GNUC__)
+#define S21_SIMD_VECTORS 1
+#if defined(__x86_64__) || defined(__i386__)
+#define S21_SIMD_AVX2 1
+#endif
+#endif
+
+namespace s21 {
+
+// Types whose == compares the object bytes and nothing else, so a range of
+// them can be compared with memcmp. A type with such an operator== and no
+// padding can opt in by specializing this.
+template <typename T>
+struct is_trivially_comparable
+    : std::integral_constant<bool, std::is_integral<T>::value ||
+                                       std::is_enum<T>::value ||
+                                       std::is_pointer<T>::value> {};
+
+namespace simd {
+
+// What sum() adds up in: the type itself for floating point, 64 bits for
+// integers
+template <typename T>
+using sum_type = typename std::conditional<
+    std::is_floating_point<T>::value, T,
+    typename std::conditional<std::is_signed<T>::value, long long,
+                              unsigned long long>::type>::type;
+
+namespace detail {
+
+// Element types the vector kernels take
+template <typename T>
+inline constexpr bool lane_type =
+    std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+    !std::is_same<T, long double>::value;
+
+#if S21_SIMD_VECTORS
+#define S21_SIMD_INLINE inline __attribute__((always_inline))
+
+// The kernels over Bytes-wide vectors of T. They are inlined into a plain
+// function for the 16-byte baseline and into an AVX2-only one for 32 bytes,
+// so the same source builds both; vectors are never passed by value, which
+// would tie the code to one ABI.
+template <typename T, int Bytes>
+struct kernels {
+  typedef T vec __attribute__((vector_size(Bytes)));
+  using mask = decltype(vec() == vec());
+  typedef typename std::conditional<true, long long, T>::type word;
+  typedef word words __attribute__((vector_size(Bytes)));
+  static constexpr std::size_t lanes = Bytes / sizeof(T);
+
+  static S21_SIMD_INLINE void load(vec &v, const T *p) noexcept {
+    std::memcpy(&v, p, Bytes);
+  }
+
+  static S21_SIMD_INLINE bool any(const mask &m) noexcept {
+    words w = reinterpret_cast<const words &>(m);
+    word bits = 0;
+    for (std::size_t i = 0; i < Bytes / sizeof(word); ++i) bits |= w[i];
+    return bits != 0;
+  }
+
+  static S21_SIMD_INLINE std::size_t find(const T *p, std::size_t n,
+                                          T x) noexcept {
+    vec splat = vec() + x, a, b;
+    std::size_t i = 0;
+    for (; i + 2 * lanes <= n; i += 2 * lanes) {
+      load(a, p + i);
+      load(b, p + i + lanes);
+      if (any((a == splat) | (b == splat))) break;
+    }
+    for (; i < n; ++i)
+      if (p[i] == x) return i;
+    return n;
+  }
+
+  static S21_SIMD_INLINE std::size_t count(const T *p, std::size_t n,
+                                           T x) noexcept {
+    // lanes count down by one per match and are emptied before they wrap
+    constexpr std::size_t flush = sizeof(T) == 1 ? 127 : 32767;
+    vec splat = vec() + x, v;
+    std::size_t total = 0, i = 0;
+    while (i + lanes <= n) {
+      mask matches = mask();
+      for (std::size_t k = 0; k < flush && i + lanes <= n; ++k, i += lanes) {
+        load(v, p + i);
+        matches += v == splat;
+      }
+      for (std::size_t l = 0; l < lanes; ++l) total -= matches[l];
+    }
+    for (; i < n; ++i) total += p[i] == x;
+    return total;
+  }
+
+  // First index where a and b differ; Ordered compares with < both ways as
+  // lexicographical_compare does, otherwise with ==
+  template <bool Ordered>
+  static S21_SIMD_INLINE std::size_t mismatch(const T *a, const T *b,
+                                              std::size_t n) noexcept {
+    vec va, vb;
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+      load(va, a + i);
+      load(vb, b + i);
+      if (Ordered ? any((va < vb) | (vb < va)) : any(va != vb)) break;
+    }
+    for (; i < n; ++i)
+      if (Ordered ? a[i] < b[i] || b[i] < a[i] : !(a[i] == b[i])) break;
+    return i;
+  }
+
+  static S21_SIMD_INLINE void fill(T *p, std::size_t n, T x) noexcept {
+    vec splat = vec() + x;
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) std::memcpy(p + i, &splat, Bytes);
+    for (; i < n; ++i) p[i] = x;
+  }
+
+  // Smallest or, with Max, largest of n > 0 elements
+  template <bool Max>
+  static S21_SIMD_INLINE T extreme(const T *p, std::size_t n) noexcept {
+    T best = p[0];
+    std::size_t i = 0;
+    if (n >= lanes) {
+      vec acc, v;
+      load(acc, p);
+      for (i = lanes; i + lanes <= n; i += lanes) {
+        load(v, p + i);
+        acc = Max ? (acc < v ? v : acc) : (v < acc ? v : acc);
+      }
+      for (std::size_t l = 0; l < lanes; ++l)
+        if (Max ? best < acc[l] : acc[l] < best) best = acc[l];
+    }
+    for (; i < n; ++i)
+      if (Max ? best < p[i] : p[i] < best) best = p[i];
+    return best;
+  }
+
+  // Floating point adds in four interleaved vectors, so the order of the
+  // additions differs from a left-to-right loop. Integers widen to 64-bit
+  // lanes, or to 32-bit ones emptied before they can overflow.
+  static S21_SIMD_INLINE sum_type<T> sum(const T *p, std::size_t n) noexcept {
+    sum_type<T> total = 0;
+    std::size_t i = 0;
+    if constexpr (std::is_floating_point<T>::value) {
+      vec acc[4] = {}, v;
+      for (; i + 4 * lanes <= n; i += 4 * lanes) {
+        for (int k = 0; k < 4; ++k) {
+          load(v, p + i + k * lanes);
+          acc[k] += v;
+        }
+      }
+      vec all = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+      for (std::size_t l = 0; l < lanes; ++l) total += all[l];
+    } else {
+      using lane = typename std::conditional<
+          sizeof(T) <= 2,
+          typename std::conditional<std::is_signed<T>::value, int,
+                                    unsigned>::type,
+          sum_type<T>>::type;
+      typedef lane wide __attribute__((vector_size(lanes * sizeof(lane))));
+      constexpr std::size_t flush = sizeof(T) <= 2 ? 65535 : ~std::size_t(0);
+      vec v;
+      while (i + lanes <= n) {
+        wide acc = wide();
+        for (std::size_t k = 0; k < flush && i + lanes <= n; ++k, i += lanes) {
+          load(v, p + i);
+          acc += __builtin_convertvector(v, wide);
+        }
+        for (std::size_t l = 0; l < lanes; ++l) total += acc[l];
+      }
+    }
+    for (; i < n; ++i) total += p[i];
+    return total;
+  }
+};
+
+#if S21_SIMD_AVX2
+inline bool has_avx2() noexcept {
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  return avx2;
+}
+
+#define S21_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+
+template <typename T>
+S21_SIMD_TARGET_AVX2 std::size_t find_avx2(const T *p, std::size_t n, T x) {
+  return kernels<T, 32>::find(p, n, x);
+}
+template <typename T>
+S21_SIMD_TARGET_AVX2 std::size_t count_avx2(const T *p, std::size_t n, T x) {
+  return kernels<T, 32>::count(p, n, x);
+}
+template <bool Ordered, typename T>
+S21_SIMD_TARGET_AVX2 std::size_t mismatch_avx2(const T *a, const T *b,
+                                                std::size_t n) {
+  return kernels<T, 32>::template mismatch<Ordered>(a, b, n);
+}
+template <typename T>
+S21_SIMD_TARGET_AVX2 void fill_avx2(T *p, std::size_t n, T x) {
+  kernels<T, 32>::fill(p, n, x);
+}
+template <bool Max, typename T>
+S21_SIMD_TARGET_AVX2 T extreme_avx2(const T *p, std::size_t n) {
+  return kernels<T, 32>::template extreme<Max>(p, n);
+}
+template <typename T>
+S21_SIMD_TARGET_AVX2 sum_type<T> sum_avx2(const T *p, std::size_t n) {
+  return kernels<T, 32>::sum(p, n);
+}
+#endif
+
+template <typename T>
+std::size_t find(const T *p, std::size_t n, T x) {
+#if S21_SIMD_AVX2
+  if (has_avx2()) return find_avx2(p, n, x);
+#endif
+  return kernels<T, 16>::find(p, n, x);
+}
+template <typename T>
+std::size_t count(const T *p, std::size_t n, T x) {
+#if S21_SIMD_AVX2
+  if (has_avx2()) return count_avx2(p, n, x);
+#endif
+  return kernels<T, 16>::count(p, n, x);
+}
+template <bool Ordered, typename T>
+std::size_t mismatch(const T *a, const T *b, std::size_t n) {
+#if S21_SIMD_AVX2
+  if (has_avx2()) return mismatch_avx2<Ordered>(a, b, n);
+#endif
+  return kernels<T, 16>::template mismatch<Ordered>(a, b, n);
+}
+template <typename T>
+void fill(T *p, std::size_t n, T x) {
+#if S21_SIMD_AVX2
+  if (has_avx2()) return fill_avx2(p, n, x);
+#endif
+  kernels<T, 16>::fill(p, n, x);
+}
+template <bool Max, typename T>
+T extreme(const T *p, std::size_t n) {
+#if S21_SIMD_AVX2
+  if (has_avx2()) return extreme_avx2<Max>(p, n);
+#endif
+  return kernels<T, 16>::template extreme<Max>(p, n);
+}
+template <typename T>
+sum_type<T> sum(const T *p, std::size_t n) {
+#if S21_SIMD_AVX2
+  if (has_avx2()) return sum_avx2(p, n);
+#endif
+  return kernels<T, 16>::sum(p, n);
+}
+#else
+// Without vector types the kernels are the plain loops
+template <typename T>
+std::size_t find(const T *p, std::size_t n, T x) {
+  return std::find(p, p + n, x) - p;
+}
+template <typename T>
+std::size_t count(const T *p, std::size_t n, T x) {
+  return std::count(p, p + n, x);
+}
+template <bool Ordered, typename T>
+std::size_t mismatch(const T *a, const T *b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i < n; ++i)
+    if (Ordered ? a[i] < b[i] || b[i] < a[i] : !(a[i] == b[i])) break;
+  return i;
+}
+template <typename T>
+void fill(T *p, std::size_t n, T x) {
+  std::fill(p, p + n, x);
+}
+template <bool Max, typename T>
+T extreme(const T *p, std::size_t n) {
+  return Max ? *std::max_element(p, p + n) : *std::min_element(p, p + n);
+}
+template <typename T>
+sum_type<T> sum(const T *p, std::size_t n) {
+  sum_type<T> total = 0;
+  for (std::size_t i = 0; i < n; ++i) total += p[i];
+  return total;
+}
+#endif
+
+// Byte types whose order is the order of memcmp
+template <typename T>
+inline constexpr bool memcmp_ordered =
+    std::is_same<T, unsigned char>::value ||
+    std::is_same<T, std::byte>::value ||
+    (std::is_same<T, char>::value && !std::is_signed<char>::value);
+
+template <typename T>
+bool same_bytes(const T &value) noexcept {
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  for (std::size_t i = 1; i < sizeof(T); ++i)
+    if (bytes[i] != bytes[0]) return false;
+  return true;
+}
+
+}  // namespace detail
+
+// Kernels over n elements from p. Arithmetic types go through the vector
+// kernels, any other type through the standard algorithms.
+
+// Index of the first element equal to x, n when there is none
+template <typename T>
+std::size_t find(const T *p, std::size_t n, const T &x) {
+  if constexpr (detail::lane_type<T>) {
+    return detail::find(p, n, x);
+  } else {
+    return std::find(p, p + n, x) - p;
+  }
+}
+
+template <typename T>
+std::size_t count(const T *p, std::size_t n, const T &x) {
+  if constexpr (detail::lane_type<T>) {
+    return detail::count(p, n, x);
+  } else {
+    return std::count(p, p + n, x);
+  }
+}
+
+// Trivially comparable ranges are one memcmp
+template <typename T>
+bool equal(const T *a, const T *b, std::size_t n) {
+  if constexpr (is_trivially_comparable<T>::value) {
+    return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+  } else if constexpr (detail::lane_type<T>) {
+    return detail::mismatch<false>(a, b, n) == n;
+  } else {
+    return std::equal(a, a + n, b);
+  }
+}
+
+// Lexicographic three-way compare of [a, a + na) and [b, b + nb) by <:
+// negative, zero or positive
+template <typename T>
+int compare(const T *a, std::size_t na, const T *b, std::size_t nb) {
+  std::size_t n = na < nb ? na : nb;
+  if constexpr (detail::memcmp_ordered<T>) {
+    int order = n ? std::memcmp(a, b, n) : 0;
+    if (order) return order;
+  } else if constexpr (detail::lane_type<T>) {
+    std::size_t at = detail::mismatch<true>(a, b, n);
+    if (at < n) return a[at] < b[at] ? -1 : 1;
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (a[i] < b[i]) return -1;
+      if (b[i] < a[i]) return 1;
+    }
+  }
+  return na < nb ? -1 : na > nb;
+}
+
+// A value made of one repeated byte is a memset
+template <typename T>
+void fill(T *p, std::size_t n, const T &x) {
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    if (detail::same_bytes(x)) {
+      unsigned char byte;
+      std::memcpy(&byte, &x, 1);
+      if (n) std::memset(static_cast<void *>(p), byte, n * sizeof(T));
+      return;
+    }
+  }
+  if constexpr (detail::lane_type<T>) {
+    detail::fill(p, n, x);
+  } else {
+    std::fill(p, p + n, x);
+  }
+}
+
+// Swaps two ranges that don't overlap; trivially copyable elements go
+// through a small buffer a block at a time
+template <typename T>
+void swap_ranges(T *a, T *b, std::size_t n) {
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    unsigned char buffer[256];
+    std::size_t bytes = n * sizeof(T);
+    auto *x = reinterpret_cast<unsigned char *>(a);
+    auto *y = reinterpret_cast<unsigned char *>(b);
+    for (std::size_t done = 0; done < bytes; done += sizeof(buffer)) {
+      std::size_t step = std::min(sizeof(buffer), bytes - done);
+      std::memcpy(buffer, x + done, step);
+      std::memcpy(x + done, y + done, step);
+      std::memcpy(y + done, buffer, step);
+    }
+  } else {
+    std::swap_ranges(a, a + n, b);
+  }
+}
+
+// Smallest and largest of n > 0 elements
+template <typename T>
+T min(const T *p, std::size_t n) {
+  if constexpr (detail::lane_type<T>) {
+    return detail::extreme<false>(p, n);
+  } else {
+    return *std::min_element(p, p + n);
+  }
+}
+
+template <typename T>
+T max(const T *p, std::size_t n) {
+  if constexpr (detail::lane_type<T>) {
+    return detail::extreme<true>(p, n);
+  } else {
+    return *std::max_element(p, p + n);
+  }
+}
+
+template <typename T>
+sum_type<T> sum(const T *p, std::size_t n) {
+  static_assert(detail::lane_type<T>, "sum() needs an arithmetic type");
+  return detail::sum(p, n);
+}
+
+// The same over a contiguous container: s21::vector, s21::array,
+// s21::small_vector, std::vector, ...
+template <typename Container>
+auto find(Container &c, const typename Container::value_type &x)
+    -> decltype(std::begin(c)) {
+  return std::begin(c) + find(std::data(c), std::size(c), x);
+}
+
+template <typename Container>
+std::size_t count(const Container &c,
+                  const typename Container::value_type &x) {
+  return count(std::data(c), std::size(c), x);
+}
+
+template <typename Container>
+bool contains(const Container &c, const typename Container::value_type &x) {
+  return find(std::data(c), std::size(c), x) != std::size(c);
+}
+
+template <typename Container>
+bool equal(const Container &a, const Container &b) {
+  return std::size(a) == std::size(b) &&
+         equal(std::data(a), std::data(b), std::size(a));
+}
+
+template <typename Container>
+int compare(const Container &a, const Container &b) {
+  return compare(std::data(a), std::size(a), std::data(b), std::size(b));
+}
+
+template <typename Container>
+void fill(Container &c, const typename Container::value_type &x) {
+  fill(std::data(c), std::size(c), x);
+}
+
+template <typename Container>
+typename Container::value_type min(const Container &c) {
+  return min(std::data(c), std::size(c));
+}
+
+template <typename Container>
+typename Container::value_type max(const Container &c) {
+  return max(std::data(c), std::size(c));
+}
+
+template <typename Container>
+auto sum(const Container &c) {
+  return sum(std::data(c), std::size(c));
+}
+
+}  // namespace simd
+}  // namespace s21
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+namespace parallel {
+
+// Work-stealing pool. Every worker has its own deque: it pushes and pops
+// tasks at the back, so it keeps working on what it spawned last while the
+// data is in its cache, and idle workers steal from the front, where the
+// biggest pieces of a split range sit. A thread waiting on a task_group
+// runs queued tasks instead of blocking, so nested groups never deadlock
+// and a pool with no workers runs everything on the caller.
+class thread_pool {
+ public:
+  using task = std::function<void()>;
+
+  explicit thread_pool(
+      std::size_t workers = std::thread::hardware_concurrency())
+      : queues_(workers ? workers : 1) {
+    for (auto &queue : queues_) queue = std::make_unique<task_queue>();
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i)
+      threads_.emplace_back([this, i] { work(i); });
+  }
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &thread : threads_) thread.join();
+  }
+
+  // Threads that run tasks, counting the one that waits on a group
+  std::size_t concurrency() const noexcept { return threads_.size() + 1; }
+
+  // Queues fn on the calling worker's deque, or on the next deque round
+  // robin from outside the pool
+  void submit(task fn) {
+    std::size_t idx = own_queue();
+    if (idx == npos) idx = next_.fetch_add(1) % queues_.size();
+    {
+      std::lock_guard<std::mutex> lock(queues_[idx]->mutex);
+      queues_[idx]->tasks.push_back(std::move(fn));
+    }
+    queued_.fetch_add(1);
+    // taking the lock orders the count before a worker going to sleep
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    wake_.notify_one();
+  }
+
+  // Runs one queued task, the caller's own newest first, then the oldest of
+  // another deque. False when there was nothing to run.
+  bool run_pending() {
+    std::size_t own = own_queue();
+    task fn;
+    if (own != npos && pop_back(*queues_[own], fn)) return run(fn);
+    std::size_t start = own == npos ? next_.load() : own + 1;
+    for (std::size_t k = 0; k < queues_.size(); ++k)
+      if (pop_front(*queues_[(start + k) % queues_.size()], fn))
+        return run(fn);
+    return false;
+  }
+
+ private:
+  static constexpr std::size_t npos = ~std::size_t(0);
+
+  struct task_queue {
+    std::mutex mutex;
+    std::deque<task> tasks;
+  };
+
+  struct worker_slot {
+    const thread_pool *pool = nullptr;
+    std::size_t idx = 0;
+  };
+
+  static worker_slot &current() noexcept {
+    static thread_local worker_slot slot;
+    return slot;
+  }
+
+  std::size_t own_queue() const noexcept {
+    return current().pool == this ? current().idx : npos;
+  }
+
+  bool pop_back(task_queue &queue, task &fn) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    fn = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+  }
+
+  bool pop_front(task_queue &queue, task &fn) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    fn = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+  }
+
+  bool run(task &fn) {
+    queued_.fetch_sub(1);
+    fn();
+    return true;
+  }
+
+  void work(std::size_t idx) {
+    current() = {this, idx};
+    while (true) {
+      if (run_pending()) continue;
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      wake_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+      if (stop_ && queued_.load() == 0) return;
+    }
+  }
+
+  std::vector<std::unique_ptr<task_queue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<std::size_t> next_{0};
+  std::atomic<std::size_t> queued_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+};
+
+// Pool shared by the parallel algorithms unless they are given another one,
+// one worker per hardware thread besides the caller
+inline thread_pool &default_pool() {
+  static thread_pool pool(std::thread::hardware_concurrency() > 1
+                              ? std::thread::hardware_concurrency() - 1
+                              : 0);
+  return pool;
+}
+
+// Tasks spawned on a pool and waited for together. wait() helps run queued
+// work until the group is done and rethrows the first exception a task
+// threw; the destructor waits as well.
+class task_group {
+ public:
+  explicit task_group(thread_pool &pool) noexcept : pool_(pool) {}
+  task_group(const task_group &) = delete;
+  task_group &operator=(const task_group &) = delete;
+
+  ~task_group() {
+    try {
+      wait();
+    } catch (...) {
+    }
+  }
+
+  template <typename Fn>
+  void run(Fn fn) {
+    pending_.fetch_add(1);
+    pool_.submit([this, fn = std::move(fn)]() mutable {
+      try {
+        fn();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (!error_) error_ = std::current_exception();
+      }
+      pending_.fetch_sub(1);
+    });
+  }
+
+  void wait() {
+    while (pending_.load() != 0)
+      if (!pool_.run_pending()) std::this_thread::yield();
+    if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+
+ private:
+  thread_pool &pool_;
+  std::atomic<std::size_t> pending_{0};
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+};
+
+}  // namespace parallel
+}  // namespace s21
+
+#endif